@@ -0,0 +1,163 @@
+#include "benchmark/benchmark_api.h"
+#include "emu.h"
+#include "drawgfxt.ipp"
+
+#include <vector>
+
+// Draws 4bpp tiles with a transparent pen the way gfx_element::transpen
+// does, into raw 16bpp indexed and 32bpp RGB bitmaps.  Compares the basic
+// core's pixel op applied a pixel at a time to unaligned rows with the row
+// kernels used for elements with a pre-decoded store, which read aligned
+// rows and skip or fill rows using per-row pen usage.  Tiles are typical
+// sprite shapes, with transparent rows above and below a solid body and
+// ragged edges on the rows in between.
+
+namespace {
+
+constexpr int TILES = 64;
+constexpr int DEST_WIDTH = 512;
+constexpr u32 TRANS_PEN = 0;
+
+struct bench_tiles
+{
+	bench_tiles(int size, int modulo)
+		: size(size)
+		, modulo(modulo)
+		, allocated(TILES * size * modulo + 15)
+		, rowusage(TILES * size)
+	{
+		// like gfx_element, start the rows on aligned boundaries if the modulo allows
+		pixels = &allocated[0];
+		pixels += -uintptr_t(pixels) & 15;
+
+		u32 seed = 12345;
+		for (int tile = 0; tile < TILES; tile++)
+		{
+			for (int y = 0; y < size; y++)
+			{
+				// a quarter of the rows are empty, and the middle half are solid
+				bool const empty = (y < size / 8) || (y >= size - size / 8);
+				bool const solid = (y >= size / 4) && (y < size - size / 4);
+				u32 usage = 0;
+				for (int x = 0; x < size; x++)
+				{
+					seed = seed * 1103515245 + 12345;
+					u8 pen = 1 + ((seed >> 16) % 15);
+					if (empty || (!solid && ((seed >> 8) & 3) == 0))
+						pen = TRANS_PEN;
+					pixels[(tile * size + y) * modulo + x] = pen;
+					usage |= 1 << pen;
+				}
+				rowusage[tile * size + y] = usage;
+			}
+		}
+	}
+
+	const u8 *tile(int index) const { return &pixels[index * size * modulo]; }
+
+	int size;
+	int modulo;
+	std::vector<u8> allocated;
+	u8 *pixels;
+	std::vector<u32> rowusage;
+};
+
+template <typename PixelType>
+struct bench_target
+{
+	bench_target(int size) : bitmap(DEST_WIDTH * size, 0), across(DEST_WIDTH / size), size(size) { }
+
+	PixelType *tile(int index) { return &bitmap[(index % across) * size]; }
+
+	std::vector<PixelType> bitmap;
+	int across;
+	int size;
+};
+
+// the basic core: the pixel op for every pixel
+template <typename PixelType, typename FunctionClass>
+void draw_pixels(benchmark::State &state, FunctionClass pixel_op)
+{
+	bench_tiles const tiles(state.range(0), state.range(0));
+	bench_target<PixelType> target(tiles.size);
+
+	int tile = 0;
+	while (state.KeepRunning())
+	{
+		PixelType *destptr = target.tile(tile);
+		const u8 *srcptr = tiles.tile(tile);
+		for (int y = 0; y < tiles.size; y++, destptr += DEST_WIDTH, srcptr += tiles.modulo)
+			drawgfx_scanline<>::pixels(destptr, srcptr, tiles.size, false, pixel_op);
+		tile = (tile + 1) % TILES;
+	}
+	benchmark::DoNotOptimize(target.bitmap.data());
+	state.SetItemsProcessed(state.iterations() * tiles.size * tiles.size);
+}
+
+// the pre-decoded path: aligned rows, row pen usage and the row kernels
+template <typename PixelType, typename OpaqueRowClass, typename RowClass>
+void draw_rows(benchmark::State &state, OpaqueRowClass opaque_row, RowClass row_op)
+{
+	bench_tiles const tiles(state.range(0), (state.range(0) + 15) & ~15);
+	bench_target<PixelType> target(tiles.size);
+
+	int tile = 0;
+	while (state.KeepRunning())
+	{
+		drawgfx_scanline<>::rows(target.tile(tile), DEST_WIDTH, tiles.tile(tile), tiles.modulo, &tiles.rowusage[tile * tiles.size], 1,
+				tiles.size, tiles.size, false, 1 << TRANS_PEN, opaque_row, row_op);
+		tile = (tile + 1) % TILES;
+	}
+	benchmark::DoNotOptimize(target.bitmap.data());
+	state.SetItemsProcessed(state.iterations() * tiles.size * tiles.size);
+}
+
+std::vector<pen_t> const &bench_palette()
+{
+	static std::vector<pen_t> const pens(
+			[] ()
+			{
+				std::vector<pen_t> result(0x100);
+				for (int i = 0; i < result.size(); i++)
+					result[i] = i * 0x010203;
+				return result;
+			}());
+	return pens;
+}
+
+} // anonymous namespace
+
+static void BM_drawgfx_transpen_ind16_pixels(benchmark::State& state)
+{
+	u32 const color = 0x100, trans_pen = TRANS_PEN;
+	draw_pixels<u16>(state, [color, trans_pen] (u16 &destp, const u8 &srcp) { PIXEL_OP_REBASE_TRANSPEN(destp, srcp); });
+}
+
+static void BM_drawgfx_transpen_ind16_rows(benchmark::State& state)
+{
+	u32 const color = 0x100;
+	draw_rows<u16>(state,
+			[color] (u16 *destp, const u8 *srcp, s32 count, bool flip) { drawgfx_scanline<>::opaque_ind16(destp, srcp, count, flip, color); },
+			[color] (u16 *destp, const u8 *srcp, s32 count, bool flip) { drawgfx_scanline<>::transpen_ind16(destp, srcp, count, flip, color, TRANS_PEN); });
+}
+
+static void BM_drawgfx_transpen_rgb32_pixels(benchmark::State& state)
+{
+	const pen_t *paldata = &bench_palette()[0];
+	u32 const trans_pen = TRANS_PEN;
+	draw_pixels<u32>(state, [paldata, trans_pen] (u32 &destp, const u8 &srcp) { PIXEL_OP_REMAP_TRANSPEN(destp, srcp); });
+}
+
+static void BM_drawgfx_transpen_rgb32_rows(benchmark::State& state)
+{
+	const pen_t *paldata = &bench_palette()[0];
+	draw_rows<u32>(state,
+			[paldata] (u32 *destp, const u8 *srcp, s32 count, bool flip) { drawgfx_scanline<>::opaque_rgb32(destp, srcp, count, flip, paldata); },
+			[paldata] (u32 *destp, const u8 *srcp, s32 count, bool flip) { drawgfx_scanline<>::transpen_rgb32(destp, srcp, count, flip, paldata, TRANS_PEN); });
+}
+
+// Register the functions as benchmarks
+BENCHMARK(BM_drawgfx_transpen_ind16_pixels)->Arg(8)->Arg(16)->Arg(32);
+BENCHMARK(BM_drawgfx_transpen_ind16_rows)->Arg(8)->Arg(16)->Arg(32);
+BENCHMARK(BM_drawgfx_transpen_rgb32_pixels)->Arg(8)->Arg(16)->Arg(32);
+BENCHMARK(BM_drawgfx_transpen_rgb32_rows)->Arg(8)->Arg(16)->Arg(32);
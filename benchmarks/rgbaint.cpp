@@ -0,0 +1,147 @@
+#include "benchmark/benchmark_api.h"
+#include "emucore.h"
+#include "video/rgbutil.h"
+#include "video/rgbspan.h"
+
+#include <vector>
+
+// Draws a bilinear-filtered, alpha-blended texture span the way the 3D
+// rasterizers do: each pixel filters four texels and blends the result over
+// the destination.  Compares the portable rgbaint_t from rgbgen.h and the
+// build's own rgbaint_t (SSE on x86) a pixel at a time with the span
+// functions built from rgbaint_batch_t and from the AVX2 batch.  The AVX2
+// functions are chosen at run time, so they're measured in any build on a
+// CPU that supports them and skipped otherwise.
+
+// Where the build uses SSE or VMX, rgbgen.h hasn't been included yet, so it
+// can be pulled in again under its own namespace.  Its blend() lives in
+// rgbgen.cpp, which is only built when rgbgen.h is the build's rgbaint_t,
+// so the scalar path blends with the inline multiply, add and shift that
+// blend() is made of.
+#if !defined(MAME_EMU_VIDEO_RGBGEN_H)
+namespace scalar {
+#include "video/rgbgen.h"
+} // namespace scalar
+#else
+namespace scalar { using ::rgbaint_t; }
+#endif
+
+namespace {
+
+constexpr int SPAN = 256;
+constexpr u8 BLEND = 0xa0;
+
+struct texture_span
+{
+	texture_span(int texsize)
+		: texels(texsize * texsize)
+		, rgb00(SPAN), rgb01(SPAN), rgb10(SPAN), rgb11(SPAN)
+		, u(SPAN)
+		, v(SPAN)
+		, dest(SPAN)
+	{
+		u32 seed = 12345;
+		for (u32 &texel : texels)
+		{
+			seed = seed * 1103515245 + 12345;
+			texel = seed ^ (seed << 13);
+		}
+
+		// step across the texture at a slight angle
+		int const mask = texsize - 1;
+		for (int x = 0; x < SPAN; x++)
+		{
+			u32 const s = x * 0x1c0 + 0x40;
+			u32 const t = x * 0x28 + 0x1000;
+			u[x] = s & 0xff;
+			v[x] = t & 0xff;
+			int const tx = (s >> 8) & mask, ty = (t >> 8) & mask;
+			int const tx1 = (tx + 1) & mask, ty1 = (ty + 1) & mask;
+			offs.push_back({ ty * texsize + tx, ty * texsize + tx1, ty1 * texsize + tx, ty1 * texsize + tx1 });
+		}
+	}
+
+	// fetch the texels for each pixel, as a rasterizer would
+	void fetch(int start, int count)
+	{
+		for (int x = start; x < start + count; x++)
+		{
+			rgb00[x] = texels[offs[x].o00];
+			rgb01[x] = texels[offs[x].o01];
+			rgb10[x] = texels[offs[x].o10];
+			rgb11[x] = texels[offs[x].o11];
+		}
+	}
+
+	struct texel_offsets { int o00, o01, o10, o11; };
+
+	std::vector<u32> texels;
+	std::vector<texel_offsets> offs;
+	std::vector<u32> rgb00, rgb01, rgb10, rgb11;
+	std::vector<u8> u, v;
+	std::vector<u32> dest;
+};
+
+void draw_pixels(texture_span &span)
+{
+	for (int x = 0; x < SPAN; x++)
+	{
+		span.fetch(x, 1);
+		rgbaint_t src;
+		src.bilinear_filter_rgbaint(span.rgb00[x], span.rgb01[x], span.rgb10[x], span.rgb11[x], span.u[x], span.v[x]);
+		src.blend(rgbaint_t(span.dest[x]), BLEND);
+		span.dest[x] = src.to_rgba_clamp();
+	}
+}
+
+void draw_scalar(texture_span &span)
+{
+	for (int x = 0; x < SPAN; x++)
+	{
+		span.fetch(x, 1);
+		scalar::rgbaint_t src, dst(span.dest[x]);
+		src.bilinear_filter_rgbaint(span.rgb00[x], span.rgb01[x], span.rgb10[x], span.rgb11[x], span.u[x], span.v[x]);
+		src.mul_imm(BLEND);
+		dst.mul_imm(256 - BLEND);
+		src.add(dst);
+		src.shr_imm(8);
+		span.dest[x] = src.to_rgba_clamp();
+	}
+}
+
+void draw_span(texture_span &span, rgb_span_functions const &functions)
+{
+	span.fetch(0, SPAN);
+	functions.bilinear_blend(&span.dest[0], &span.rgb00[0], &span.rgb01[0], &span.rgb10[0], &span.rgb11[0], &span.u[0], &span.v[0], BLEND, SPAN);
+}
+
+void draw_generic(texture_span &span) { draw_span(span, rgb_span_generic); }
+void draw_avx2(texture_span &span) { draw_span(span, *rgb_span_avx2()); }
+
+template <void (*Draw)(texture_span &)>
+void draw_spans(benchmark::State& state)
+{
+	if (Draw == &draw_avx2 && !rgb_span_avx2())
+	{
+		state.SkipWithError("AVX2 not supported");
+		return;
+	}
+	texture_span span(state.range(0));
+	while (state.KeepRunning())
+		Draw(span);
+	benchmark::DoNotOptimize(span.dest.data());
+	state.SetItemsProcessed(state.iterations() * SPAN);
+}
+
+} // anonymous namespace
+
+static void BM_rgbaint_span_scalar(benchmark::State& state) { draw_spans<draw_scalar>(state); }
+static void BM_rgbaint_span_pixels(benchmark::State& state) { draw_spans<draw_pixels>(state); }
+static void BM_rgbaint_span_generic(benchmark::State& state) { draw_spans<draw_generic>(state); }
+static void BM_rgbaint_span_avx2(benchmark::State& state) { draw_spans<draw_avx2>(state); }
+
+// Register the functions as benchmarks
+BENCHMARK(BM_rgbaint_span_scalar)->Arg(64)->Arg(256);
+BENCHMARK(BM_rgbaint_span_pixels)->Arg(64)->Arg(256);
+BENCHMARK(BM_rgbaint_span_generic)->Arg(64)->Arg(256);
+BENCHMARK(BM_rgbaint_span_avx2)->Arg(64)->Arg(256);
@@ -0,0 +1,123 @@
+#include "benchmark/benchmark_api.h"
+#include "coretmpl.h"
+
+#include <vector>
+
+// Fires and reschedules periodic timers the way device_scheduler does: the
+// earliest timer comes off the queue and goes back in one period later, and
+// ties between equal expiry times go to the timer queued first.  Compares
+// the sorted linked list the scheduler used to keep with the
+// util::intrusive_heap it keeps now.
+
+namespace {
+
+struct bench_timer
+{
+	bench_timer *next = nullptr;
+	bench_timer *prev = nullptr;
+	uint32_t heap_index = ~uint32_t(0);
+	uint64_t sequence = 0;
+	uint64_t expire = 0;
+	uint64_t period = 0;
+
+	struct queue_order
+	{
+		bool operator()(bench_timer const &a, bench_timer const &b) const noexcept
+		{
+			return (a.expire != b.expire) ? (a.expire < b.expire) : (a.sequence < b.sequence);
+		}
+	};
+};
+
+std::vector<bench_timer> make_timers(int count)
+{
+	std::vector<bench_timer> timers(count);
+	for (int i = 0; i < count; i++)
+		timers[i].period = 1000 + (i * 7919) % 5003;
+	return timers;
+}
+
+// the old scheduler queue: a sorted doubly-linked list, where a timer goes
+// after every timer due at or before the same time
+class list_queue
+{
+public:
+	bench_timer *first() const { return m_head; }
+
+	void insert(bench_timer &timer)
+	{
+		bench_timer *prev = nullptr;
+		for (bench_timer *cur = m_head; cur; prev = cur, cur = cur->next)
+		{
+			if (cur->expire > timer.expire)
+			{
+				timer.prev = prev;
+				timer.next = cur;
+				(prev ? prev->next : m_head) = &timer;
+				cur->prev = &timer;
+				return;
+			}
+		}
+		(prev ? prev->next : m_head) = &timer;
+		timer.prev = prev;
+		timer.next = nullptr;
+	}
+
+	void remove(bench_timer &timer)
+	{
+		(timer.prev ? timer.prev->next : m_head) = timer.next;
+		if (timer.next)
+			timer.next->prev = timer.prev;
+	}
+
+private:
+	bench_timer *m_head = nullptr;
+};
+
+// the current scheduler queue, with a sequence number to break ties
+class heap_queue
+{
+public:
+	bench_timer *first() const { return m_heap.front(); }
+
+	void insert(bench_timer &timer)
+	{
+		timer.sequence = m_sequence++;
+		m_heap.insert(timer);
+	}
+
+	void remove(bench_timer &timer) { m_heap.remove(timer); }
+
+private:
+	util::intrusive_heap<bench_timer, &bench_timer::heap_index, bench_timer::queue_order> m_heap;
+	uint64_t m_sequence = 0;
+};
+
+template <typename Queue>
+void fire_periodic_timers(benchmark::State& state)
+{
+	std::vector<bench_timer> timers = make_timers(state.range(0));
+	Queue queue;
+	for (bench_timer &timer : timers)
+	{
+		timer.expire = timer.period;
+		queue.insert(timer);
+	}
+
+	while (state.KeepRunning())
+	{
+		bench_timer &timer = *queue.first();
+		queue.remove(timer);
+		timer.expire += timer.period;
+		queue.insert(timer);
+	}
+}
+
+} // anonymous namespace
+
+static void BM_timer_queue_list(benchmark::State& state) { fire_periodic_timers<list_queue>(state); }
+static void BM_timer_queue_heap(benchmark::State& state) { fire_periodic_timers<heap_queue>(state); }
+
+// Register the functions as benchmarks
+BENCHMARK(BM_timer_queue_list)->Arg(8)->Arg(32)->Arg(128);
+BENCHMARK(BM_timer_queue_heap)->Arg(8)->Arg(32)->Arg(128);
@@ -20,11 +20,14 @@
 #define REGFLAG_R(n)                    (((n) == 0) ? 0 : (1 << (n)))
 
 //-------------------------------------------------
-//  arm7_frontend - constructor
+//  arm7_frontend - constructor; describe() reads
+//  the Thumb and 32-bit mode bits from CPSR, so
+//  descriptions can't be kept in the persistent
+//  cache
 //-------------------------------------------------
 
 arm7_frontend::arm7_frontend(arm7_cpu_device *arm7, uint32_t window_start, uint32_t window_end, uint32_t max_sequence)
-	: drc_frontend(*arm7, window_start, window_end, max_sequence),
+	: drc_frontend(*arm7, window_start, window_end, max_sequence, false),
 		m_arm7(arm7)
 {
 }
@@ -44,6 +44,7 @@ drc_hash_table::drc_hash_table(drc_cache &cache, uint32_t modes, uint8_t addrbit
 		m_emptyl1(nullptr),
 		m_emptyl2(nullptr)
 {
+	m_cache.add_evict_handler(drc_evict_delegate(&drc_hash_table::evict, this));
 	reset();
 }
 
@@ -56,7 +57,7 @@ drc_hash_table::drc_hash_table(drc_cache &cache, uint32_t modes, uint8_t addrbit
 bool drc_hash_table::reset()
 {
 	// allocate an empty l2 hash table
-	m_emptyl2 = (drccodeptr *)m_cache.alloc_temporary(sizeof(drccodeptr) << m_l2bits);
+	m_emptyl2 = (drccodeptr *)m_cache.alloc_table(sizeof(drccodeptr) << m_l2bits);
 	if (m_emptyl2 == nullptr)
 		return false;
 
@@ -65,7 +66,7 @@ bool drc_hash_table::reset()
 		m_emptyl2[entry] = m_nocodeptr;
 
 	// allocate an empty l1 hash table
-	m_emptyl1 = (drccodeptr **)m_cache.alloc_temporary(sizeof(drccodeptr *) << m_l1bits);
+	m_emptyl1 = (drccodeptr **)m_cache.alloc_table(sizeof(drccodeptr *) << m_l1bits);
 	if (m_emptyl1 == nullptr)
 		return false;
 
@@ -152,6 +153,26 @@ void drc_hash_table::set_default_codeptr(drccodeptr nocodeptr)
 }
 
 
+//-------------------------------------------------
+//  evict - point entries for code that has been
+//  discarded back at the missing code handler
+//-------------------------------------------------
+
+void drc_hash_table::evict(drccodeptr start, drccodeptr end)
+{
+	for (int modenum = 0; modenum < m_modes; modenum++)
+		if (m_base[modenum] != m_emptyl1)
+			for (int l1entry = 0; l1entry < (1 << m_l1bits); l1entry++)
+				if (m_base[modenum][l1entry] != m_emptyl2)
+					for (int l2entry = 0; l2entry < (1 << m_l2bits); l2entry++)
+					{
+						drccodeptr const code = m_base[modenum][l1entry][l2entry];
+						if (code >= start && code < end)
+							m_base[modenum][l1entry][l2entry] = m_nocodeptr;
+					}
+}
+
+
 //-------------------------------------------------
 //  set_codeptr - set the codeptr for the given
 //  mode/pc
@@ -163,7 +184,7 @@ bool drc_hash_table::set_codeptr(uint32_t mode, uint32_t pc, drccodeptr code)
 	assert(mode < m_modes);
 	if (m_base[mode] == m_emptyl1)
 	{
-		drccodeptr **newtable = (drccodeptr **)m_cache.alloc_temporary(sizeof(drccodeptr *) << m_l1bits);
+		drccodeptr **newtable = (drccodeptr **)m_cache.alloc_table(sizeof(drccodeptr *) << m_l1bits);
 		if (newtable == nullptr)
 			return false;
 		memcpy(newtable, m_emptyl1, sizeof(drccodeptr *) << m_l1bits);
@@ -174,7 +195,7 @@ bool drc_hash_table::set_codeptr(uint32_t mode, uint32_t pc, drccodeptr code)
 	uint32_t l1 = (pc >> m_l1shift) & m_l1mask;
 	if (m_base[mode][l1] == m_emptyl2)
 	{
-		drccodeptr *newtable = (drccodeptr *)m_cache.alloc_temporary(sizeof(drccodeptr) << m_l2bits);
+		drccodeptr *newtable = (drccodeptr *)m_cache.alloc_table(sizeof(drccodeptr) << m_l2bits);
 		if (newtable == nullptr)
 			return false;
 		memcpy(newtable, m_emptyl2, sizeof(drccodeptr) << m_l2bits);
@@ -356,7 +377,7 @@ uint32_t drc_map_variables::get_value(drccodeptr codebase, uint32_t mapvar) cons
 
 	// get an aligned pointer to start scanning
 	uint64_t *curscan = (uint64_t *)(((uintptr_t)codebase | 7) + 1);
-	uint64_t *endscan = (uint64_t *)m_cache.top();
+	uint64_t *endscan = (uint64_t *)m_cache.code_end(codebase);
 
 	// look for the signature
 	while (curscan < endscan && *curscan++ != m_uniquevalue) {};
@@ -53,6 +53,9 @@ public:
 	bool code_exists(uint32_t mode, uint32_t pc) { return get_codeptr(mode, pc) != m_nocodeptr; }
 
 private:
+	// internal helpers
+	void evict(drccodeptr start, drccodeptr end);
+
 	// internal state
 	drc_cache &     m_cache;                // cache where allocations come from
 	uint32_t          m_modes;                // number of modes supported
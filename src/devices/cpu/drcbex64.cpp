@@ -912,6 +912,9 @@ void drcbe_x64::reset()
 		x86log_disasm_code_range(m_log, "nocode_point", m_nocode, dst + bytes);
 	}
 
+	// the stubs are used by all generated code, so they have to stay put
+	m_cache.pin_current();
+
 	// reset our hash tables
 	m_hash.reset();
 	m_hash.set_default_codeptr(m_nocode);
@@ -789,6 +789,9 @@ void drcbe_x86::reset()
 		m_logged_common = true;
 	}
 
+	// the stubs are used by all generated code, so they have to stay put
+	m_cache.pin_current();
+
 	// reset our hash tables
 	m_hash.reset();
 	m_hash.set_default_codeptr(m_nocode);
@@ -49,7 +49,12 @@ drc_cache::drc_cache(size_t bytes) :
 	m_codegen(nullptr),
 	m_size(m_cache.size()),
 	m_executable(false),
-	m_rwx(false)
+	m_rwx(false),
+	m_current(0),
+	m_entries(nullptr),
+	m_tabletop(nullptr),
+	m_tableend(nullptr),
+	m_stats()
 {
 	// alignment and page size must be powers of two, cache must be page-aligned
 	assert(!(CACHE_ALIGNMENT & (CACHE_ALIGNMENT - 1)));
@@ -78,6 +83,10 @@ drc_cache::drc_cache(size_t bytes) :
 		osd_printf_verbose("drc_cache: Using W^X mode\n");
 		m_rwx = false;
 	}
+
+	// generated code counts entries into each region
+	m_entries = reinterpret_cast<u64 *>(alloc_near(MAX_REGIONS * sizeof(u64)));
+	std::fill_n(m_entries, MAX_REGIONS, 0);
 }
 
 
@@ -87,6 +96,26 @@ drc_cache::drc_cache(size_t bytes) :
 
 drc_cache::~drc_cache()
 {
+	osd_printf_verbose("drc_cache: %u regions, %u blocks generated, %u flushes, %u regions evicted (%u blocks, %u bytes)\n",
+			m_stats.regions, m_stats.blocks, m_stats.flushes, m_stats.evictions, m_stats.evicted_blocks, m_stats.evicted_bytes);
+}
+
+
+//-------------------------------------------------
+//  code_end - return the end of the code that
+//  follows a pointer into the code area
+//-------------------------------------------------
+
+drccodeptr drc_cache::code_end(const void *ptr) const
+{
+	drccodeptr const code = reinterpret_cast<drccodeptr>(const_cast<void *>(ptr));
+	for (unsigned index = 0; index < m_regions.size(); index++)
+	{
+		code_region const &region = m_regions[index];
+		if ((code >= region.start) && (code < region.end))
+			return (index == m_current) ? m_top : region.top;
+	}
+	return m_top;
 }
 
 
@@ -103,6 +132,131 @@ void drc_cache::flush()
 	// just reset the top back to the base and re-seed
 	m_top = m_base;
 	codegen_init();
+	layout_regions();
+	m_stats.flushes++;
+}
+
+
+//-------------------------------------------------
+//  begin_block - make sure the current region
+//  has room for another block, moving on to the
+//  coldest unpinned region if not
+//-------------------------------------------------
+
+void drc_cache::begin_block()
+{
+	// can't move in the middle of codegen
+	assert(!m_codegen);
+	m_stats.blocks++;
+	if (m_regions.empty())
+		return;
+
+	// stay put if there's room for a full-size block
+	if ((m_top + 2 * CODEGEN_MAX_BYTES) <= region_end())
+	{
+		m_regions[m_current].blocks++;
+		return;
+	}
+
+	// reuse the unpinned region entered least, the oldest of those on a tie;
+	// if they're all pinned, the block will fail to generate and the owner
+	// will flush everything
+	unsigned next = m_current;
+	for (unsigned step = 1; step < m_regions.size(); step++)
+	{
+		unsigned const index = (m_current + step) % m_regions.size();
+		if (!m_regions[index].pinned && ((next == m_current) || (m_entries[index] < m_entries[next])))
+			next = index;
+	}
+	if (next == m_current)
+		return;
+
+	m_regions[m_current].top = m_top;
+	evict_region(next);
+	m_current = next;
+	m_top = m_regions[next].start;
+	m_regions[next].blocks = 1;
+}
+
+
+//-------------------------------------------------
+//  pin_current - prevent the region being filled
+//  from being evicted before the next flush
+//-------------------------------------------------
+
+void drc_cache::pin_current()
+{
+	if (!m_regions.empty() && !m_regions[m_current].pinned)
+	{
+		m_regions[m_current].pinned = true;
+		m_stats.pinned_regions++;
+	}
+}
+
+
+//-------------------------------------------------
+//  layout_regions - divide the code area into
+//  regions that can be evicted separately
+//-------------------------------------------------
+
+void drc_cache::layout_regions()
+{
+	m_regions.clear();
+	m_current = 0;
+	std::fill_n(m_entries, MAX_REGIONS, 0);
+	m_tabletop = m_tableend = nullptr;
+	m_stats.regions = 0;
+	m_stats.pinned_regions = 0;
+
+	// leave room for permanent allocations to grow, and only bother if there
+	// are enough regions to keep some while discarding others
+	drccodeptr const end = ALIGN_PTR_DOWN(m_limit - std::min<size_t>(PERMANENT_RESERVE, m_limit - m_base), m_cache.page_size());
+	size_t const span = (end > m_base) ? (end - m_base) : 0;
+	size_t const tablesize = (span / TABLE_AREA_DIVISOR) & ~(m_cache.page_size() - 1);
+	unsigned const count = std::min<size_t>((span - tablesize) / MIN_REGION_SIZE, MAX_REGIONS);
+	if (count < 3)
+		return;
+
+	// hash tables can be large, so they get an area of their own after the
+	// regions rather than eating into the space for code
+	size_t const size = ((span - tablesize) / count) & ~(m_cache.page_size() - 1);
+	for (unsigned index = 0; index < count; index++)
+	{
+		drccodeptr const start = m_base + index * size;
+		m_regions.emplace_back(code_region{ start, start + size, start, 0, false });
+	}
+	m_tabletop = m_regions.back().end;
+	m_tableend = end;
+	m_stats.regions = count;
+}
+
+
+//-------------------------------------------------
+//  evict_region - discard all the code in a
+//  region
+//-------------------------------------------------
+
+void drc_cache::evict_region(unsigned index)
+{
+	code_region &region = m_regions[index];
+	if (region.top > region.start)
+	{
+		// the handlers may need to patch tables in the cache
+		codegen_init();
+		for (drc_evict_delegate &handler : m_evict_handlers)
+			handler(region.start, region.top);
+
+		m_stats.evictions++;
+		m_stats.evicted_blocks += region.blocks;
+		m_stats.evicted_bytes += region.top - region.start;
+
+		// age the counts, so code that was hot a long time ago can go eventually
+		for (unsigned other = 0; other < m_regions.size(); other++)
+			m_entries[other] >>= 1;
+	}
+	region.top = region.start;
+	region.blocks = 0;
+	m_entries[index] = 0;
 }
 
 
@@ -130,7 +284,7 @@ void *drc_cache::alloc(size_t bytes)
 	// if no space, we just fail
 	drccodeptr const ptr = ALIGN_PTR_DOWN(m_end - bytes, CACHE_ALIGNMENT);
 	drccodeptr const limit = ALIGN_PTR_DOWN(ptr, m_cache.page_size());
-	if (m_top > limit)
+	if (code_limit() > limit)
 		return nullptr;
 
 	// otherwise update the end of the cache
@@ -184,7 +338,7 @@ void *drc_cache::alloc_temporary(size_t bytes)
 
 	// if no space, we just fail
 	drccodeptr const ptr = m_top;
-	if ((ptr + bytes) > m_limit)
+	if ((ptr + bytes) > region_end())
 		return nullptr;
 
 	// otherwise, update the cache top
@@ -194,6 +348,34 @@ void *drc_cache::alloc_temporary(size_t bytes)
 }
 
 
+//-------------------------------------------------
+//  alloc_table - allocate memory for a table that
+//  generated code refers to, which lasts until
+//  the next flush
+//-------------------------------------------------
+
+void *drc_cache::alloc_table(size_t bytes)
+{
+	// can't allocate in the middle of codegen
+	assert(!m_codegen);
+
+	// use the table area if there's room
+	drccodeptr const ptr = m_tabletop;
+	if (!m_regions.empty() && ((ptr + bytes) <= m_tableend))
+	{
+		codegen_init();
+		m_tabletop = ALIGN_PTR_UP(ptr + bytes, CACHE_ALIGNMENT);
+		return ptr;
+	}
+
+	// otherwise it goes with the code, and the region has to stay put
+	void *const result = alloc_temporary(bytes);
+	if (result)
+		pin_current();
+	return result;
+}
+
+
 //-------------------------------------------------
 //  free - release permanent memory allocated from
 //  the cache
@@ -231,7 +413,7 @@ void drc_cache::codegen_complete()
 	if (!m_executable)
 	{
 		if (!m_rwx)
-			m_cache.set_access(m_base - m_near, ALIGN_PTR_UP(m_top, m_cache.page_size()) - m_base, osd::virtual_memory_allocation::READ_EXECUTE);
+			m_cache.set_access(m_base - m_near, ALIGN_PTR_UP(std::max(m_top, code_limit()), m_cache.page_size()) - m_base, osd::virtual_memory_allocation::READ_EXECUTE);
 		m_executable = true;
 	}
 }
@@ -248,7 +430,7 @@ drccodeptr *drc_cache::begin_codegen(uint32_t reserve_bytes)
 	assert(m_oob_list.empty());
 
 	// if no space, we just fail
-	if ((m_top + reserve_bytes) > m_limit)
+	if ((m_top + reserve_bytes) > region_end())
 		return nullptr;
 
 	// otherwise, return a pointer to the cache top
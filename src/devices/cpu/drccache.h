@@ -36,6 +36,22 @@ typedef uint8_t *drccodeptr;
 // helper template for oob codegen
 typedef delegate<void (drccodeptr *, void *, void *)> drc_oob_delegate;
 
+// callback for code being discarded from a range of the cache
+typedef delegate<void (drccodeptr, drccodeptr)> drc_evict_delegate;
+
+
+// cache usage statistics
+struct drc_cache_stats
+{
+	u64                 blocks;             // blocks generated
+	u64                 flushes;            // complete flushes
+	u64                 evictions;          // regions evicted
+	u64                 evicted_blocks;     // blocks discarded by evicting regions
+	u64                 evicted_bytes;      // bytes discarded by evicting regions
+	u32                 regions;            // number of regions the code area is divided into
+	u32                 pinned_regions;     // regions that can't currently be evicted
+};
+
 
 // drc_cache
 class drc_cache
@@ -49,6 +65,8 @@ public:
 	drccodeptr near() const { return m_near; }
 	drccodeptr base() const { return m_base; }
 	drccodeptr top() const { return m_top; }
+	drccodeptr code_end(const void *ptr) const;
+	drc_cache_stats const &stats() const { return m_stats; }
 
 	// pointer checking
 	bool contains_pointer(const void *ptr) const { return ((const drccodeptr)ptr >= m_near && (const drccodeptr)ptr < m_near + m_size); }
@@ -60,8 +78,15 @@ public:
 	void *alloc(size_t bytes);
 	void *alloc_near(size_t bytes);
 	void *alloc_temporary(size_t bytes);
+	void *alloc_table(size_t bytes);
 	void dealloc(void *memory, size_t bytes);
 
+	// partial eviction
+	void begin_block();
+	u64 *entry_counter() { return m_regions.empty() ? nullptr : &m_entries[m_current]; }
+	void pin_current();
+	void add_evict_handler(drc_evict_delegate &&handler) { m_evict_handlers.emplace_back(std::move(handler)); }
+
 	// codegen helpers
 	void codegen_init();
 	void codegen_complete();
@@ -82,6 +107,22 @@ private:
 	// size of "near" area at the base of the cache
 	static constexpr size_t NEAR_CACHE_SIZE = 131072;
 
+	// smallest region worth evicting separately, and most regions to use
+	static constexpr size_t MIN_REGION_SIZE = 4 * CODEGEN_MAX_BYTES;
+	static constexpr unsigned MAX_REGIONS = 16;
+
+	// space kept free for permanent allocations when the code area is divided into regions
+	static constexpr size_t PERMANENT_RESERVE = 262144;
+
+	// fraction of the divided code area set aside for tables
+	static constexpr unsigned TABLE_AREA_DIVISOR = 8;
+
+	// internal helpers
+	drccodeptr region_end() const { return m_regions.empty() ? m_limit : m_regions[m_current].end; }
+	drccodeptr code_limit() const { return m_regions.empty() ? m_top : m_tableend; }
+	void layout_regions();
+	void evict_region(unsigned index);
+
 	osd::virtual_memory_allocation m_cache;
 
 	// core parameters
@@ -106,6 +147,26 @@ private:
 	std::list<oob_handler> m_oob_list;      // list of active oob handlers
 	std::list<oob_handler> m_oob_free;      // list of recyclable oob handlers
 
+	// when the current region fills up, the unpinned region whose code has
+	// been entered least is discarded and filled next; regions holding handle
+	// targets, back-end stubs, or tables that didn't fit in the table area,
+	// are pinned until the next flush
+	struct code_region
+	{
+		drccodeptr          start;          // first byte of the region
+		drccodeptr          end;            // end of the region
+		drccodeptr          top;            // end of code in the region
+		u32                 blocks;         // blocks generated into the region
+		bool                pinned;         // can't be evicted
+	};
+	std::vector<code_region> m_regions;     // regions of the code area, empty if it's too small to divide
+	unsigned            m_current;          // region being filled
+	u64 *               m_entries;          // times code in each region has been entered, in the near area for generated code to update
+	drccodeptr          m_tabletop;         // unallocated part of the table area following the regions
+	drccodeptr          m_tableend;         // end of the table area
+	std::vector<drc_evict_delegate> m_evict_handlers; // callbacks for evicted code
+	drc_cache_stats     m_stats;            // usage statistics
+
 	// free lists
 	struct free_link
 	{
@@ -18,6 +18,11 @@
 #include "emu.h"
 #include "drcfe.h"
 
+#include "emuopts.h"
+#include "fileio.h"
+
+#include "corestr.h"
+
 
 namespace {
 
@@ -27,6 +32,10 @@ namespace {
 
 constexpr u32 MAX_STACK_DEPTH = 100;
 
+// persistent cache file header
+constexpr char CACHE_MAGIC[8] = { 'M', 'A', 'M', 'E', 'D', 'R', 'C', 'F' };
+constexpr u32 CACHE_VERSION = 3;
+
 
 
 //**************************************************************************
@@ -40,6 +49,46 @@ struct pc_stack_entry
 	offs_t              srcpc;
 };
 
+
+// little-endian serialization for the persistent cache
+class cache_writer
+{
+public:
+	void u8(::u8 value) { m_data.push_back(value); }
+	void u32(::u32 value) { for (int shift = 0; shift < 32; shift += 8) m_data.push_back(::u8(value >> shift)); }
+	void bytes(void const *data, size_t length) { m_data.insert(m_data.end(), reinterpret_cast<::u8 const *>(data), reinterpret_cast<::u8 const *>(data) + length); }
+	std::vector<::u8> const &data() const { return m_data; }
+
+private:
+	std::vector<::u8> m_data;
+};
+
+class cache_reader
+{
+public:
+	cache_reader(std::vector<::u8> const &data) : m_data(data), m_offset(0), m_ok(true) { }
+
+	bool ok() const { return m_ok; }
+	size_t remaining() const { return m_data.size() - m_offset; }
+	::u8 u8() { ::u8 value = 0; bytes(&value, 1); return value; }
+	::u32 u32() { ::u8 raw[4] = { 0, 0, 0, 0 }; bytes(raw, 4); return raw[0] | (raw[1] << 8) | (raw[2] << 16) | (::u32(raw[3]) << 24); }
+	void bytes(void *data, size_t length)
+	{
+		if (!m_ok || remaining() < length)
+		{
+			m_ok = false;
+			return;
+		}
+		memcpy(data, &m_data[m_offset], length);
+		m_offset += length;
+	}
+
+private:
+	std::vector<::u8> const &m_data;
+	size_t m_offset;
+	bool m_ok;
+};
+
 } // anonymous namespace
 
 
@@ -52,7 +101,7 @@ struct pc_stack_entry
 //  drc_frontend - constructor
 //-------------------------------------------------
 
-drc_frontend::drc_frontend(device_t &cpu, u32 window_start, u32 window_end, u32 max_sequence)
+drc_frontend::drc_frontend(device_t &cpu, u32 window_start, u32 window_end, u32 max_sequence, bool cacheable)
 	: m_window_start(window_start)
 	, m_window_end(window_end)
 	, m_max_sequence(max_sequence)
@@ -60,7 +109,22 @@ drc_frontend::drc_frontend(device_t &cpu, u32 window_start, u32 window_end, u32
 	, m_program(m_cpudevice.space(AS_PROGRAM))
 	, m_pageshift(m_cpudevice.space_config(AS_PROGRAM)->page_shift())
 	, m_desc_array(window_end + window_start + 2, nullptr)
+	, m_cache_enabled(cacheable && m_cpudevice.machine().options().drc_cache() && m_program.address_to_byte(1) != 0)
+	, m_cache_dirty(false)
+	, m_cache_hits(0)
+	, m_cache_misses(0)
+	, m_restore_ticks(0)
+	, m_describe_ticks(0)
+	, m_trace_threshold((std::max)(m_cpudevice.machine().options().drc_trace_threshold(), 0))
+	, m_max_traces(4)
+	, m_pending_trace(BRANCH_TARGET_DYNAMIC)
 {
+	// pick up descriptions from the last run, and write them back out when we're done
+	if (m_cache_enabled)
+	{
+		load_cache();
+		m_cpudevice.machine().add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(&drc_frontend::save_cache, this));
+	}
 }
 
 
@@ -86,6 +150,78 @@ const opcode_desc *drc_frontend::describe_code(offs_t startpc)
 	// release any descriptions we've accumulated
 	release_descriptions();
 
+	// use the cached descriptions if the code hasn't changed; otherwise forget them
+	offs_t const minpc = startpc - (std::min)(m_window_start, startpc);
+	offs_t const maxpc = startpc + (std::min)(m_window_end, 0xffffffff - startpc);
+	auto const cached = m_cache_enabled ? m_cache.find(startpc) : m_cache.end();
+	osd_ticks_t const start = m_cache_enabled ? osd_ticks() : 0;
+	bool restored = false;
+	if (cached != m_cache.end())
+	{
+		restored = restore_descriptions(cached->second);
+		if (!restored)
+		{
+			m_cache.erase(cached);
+			m_cache_dirty = true;
+		}
+	}
+
+	if (restored)
+	{
+		m_cache_hits++;
+		m_restore_ticks += osd_ticks() - start;
+	}
+	else
+	{
+		describe_window(startpc, minpc, maxpc);
+
+		// remember the result if everything was described from directly readable memory
+		if (m_cache_enabled)
+		{
+			cached_block block;
+			bool cacheable = true;
+			for (opcode_desc const *desc = m_desc_live_list.first(); cacheable && desc != nullptr; desc = desc->next())
+				cacheable = cache_descriptions(block, *desc);
+			if (cacheable)
+			{
+				m_cache[startpc] = std::move(block);
+				m_cache_dirty = true;
+			}
+			m_cache_misses++;
+			m_describe_ticks += osd_ticks() - start;
+		}
+	}
+
+	// follow hot exits out of the window
+	if (m_trace_threshold != 0)
+		form_trace(minpc, maxpc);
+	return m_desc_live_list.first();
+}
+
+
+//-------------------------------------------------
+//  exit_counter - get the counter for a static
+//  branch leaving a block, or nullptr if traces
+//  are disabled
+//-------------------------------------------------
+
+u32 *drc_frontend::exit_counter(offs_t srcpc, offs_t targetpc)
+{
+	// map elements never move, so generated code can refer to them directly
+	if (m_trace_threshold == 0)
+		return nullptr;
+	return &m_exit_counts[(u64(srcpc) << 32) | targetpc];
+}
+
+
+//-------------------------------------------------
+//  describe_window - walk the code reachable from
+//  startpc without leaving the window and append
+//  it to the live list
+//-------------------------------------------------
+
+void drc_frontend::describe_window(offs_t startpc, offs_t minpc, offs_t maxpc)
+{
 	// add the initial PC to the stack
 	pc_stack_entry pcstack[MAX_STACK_DEPTH];
 	pc_stack_entry *pcstackptr = &pcstack[0];
@@ -94,8 +230,6 @@ const opcode_desc *drc_frontend::describe_code(offs_t startpc)
 	pcstackptr++;
 
 	// loop while we still have a stack
-	offs_t const minpc = startpc - (std::min)(m_window_start, startpc);
-	offs_t const maxpc = startpc + (std::min)(m_window_end, 0xffffffff - startpc);
 	while (pcstackptr != &pcstack[0])
 	{
 		// if we've already hit this PC, just mark it a branch target and continue
@@ -150,7 +284,73 @@ const opcode_desc *drc_frontend::describe_code(offs_t startpc)
 	// first from startpc -> maxpc, then from minpc -> startpc
 	build_sequence(startpc - minpc, maxpc - minpc, OPFLAG_REDISPATCH);
 	build_sequence(minpc - minpc, startpc - minpc, OPFLAG_RETURN_TO_START);
-	return m_desc_live_list.first();
+}
+
+
+//-------------------------------------------------
+//  form_trace - describe the targets of hot exits
+//  from the window as extra sequences, so that
+//  the back-end can jump straight to them rather
+//  than going through the hash table
+//-------------------------------------------------
+
+void drc_frontend::form_trace(offs_t minpc, offs_t maxpc)
+{
+	// keep the total within what a single window could hold, so blocks don't outgrow the back-end's limits
+	u32 used = 0;
+	for (opcode_desc const *desc = m_desc_live_list.first(); desc != nullptr; desc = desc->next())
+		used += desc->length;
+	u32 const budget = m_window_start + m_window_end;
+
+	std::vector<std::pair<offs_t, offs_t> > ranges(1, std::make_pair(minpc, maxpc));
+	auto const described = [&ranges] (offs_t pc)
+	{
+		return std::find_if(ranges.begin(), ranges.end(), [pc] (auto const &range) { return pc >= range.first && pc < range.second; }) != ranges.end();
+	};
+
+	for (u32 tracenum = 0; tracenum < m_max_traces && used < budget; tracenum++)
+	{
+		// find the most frequently taken exit that leaves everything described so far
+		opcode_desc const *hottest = nullptr;
+		u32 hottest_count = m_trace_threshold - 1;
+		for (opcode_desc const *desc = m_desc_live_list.first(); desc != nullptr; desc = desc->next())
+		{
+			if (!(desc->flags & OPFLAG_IS_BRANCH) || (desc->flags & (OPFLAG_INTRABLOCK_BRANCH | OPFLAG_CAN_CHANGE_MODES)) || desc->targetpc == BRANCH_TARGET_DYNAMIC || described(desc->targetpc))
+				continue;
+			auto const found = m_exit_counts.find((u64(desc->pc) << 32) | desc->targetpc);
+			if (found != m_exit_counts.end() && found->second > hottest_count)
+			{
+				hottest = desc;
+				hottest_count = found->second;
+			}
+		}
+		if (hottest == nullptr)
+			break;
+
+		// describe forwards from the target, stopping short of anything we already have
+		offs_t const tracepc = hottest->targetpc;
+		offs_t traceend = tracepc + (std::min)((std::min)(m_window_end, budget - used), 0xffffffff - tracepc);
+		for (auto const &range : ranges)
+			if (range.first > tracepc)
+				traceend = (std::min)(traceend, range.first);
+		opcode_desc const *const last = m_desc_live_list.last();
+		describe_window(tracepc, tracepc, traceend);
+		ranges.emplace_back(tracepc, traceend);
+		for (opcode_desc const *desc = last->next(); desc != nullptr; desc = desc->next())
+			used += desc->length;
+	}
+
+	// static branches to the start of any sequence can now be local jumps
+	if (ranges.size() > 1)
+	{
+		std::unordered_map<offs_t, opcode_desc const *> targets;
+		for (opcode_desc const *desc = m_desc_live_list.first(); desc != nullptr; desc = desc->next())
+			if (desc->flags & OPFLAG_IS_BRANCH_TARGET)
+				targets.emplace(desc->pc, desc);
+		for (opcode_desc *desc = m_desc_live_list.first(); desc != nullptr; desc = desc->next())
+			if ((desc->flags & OPFLAG_IS_BRANCH) && !(desc->flags & OPFLAG_CAN_CHANGE_MODES) && desc->targetpc != BRANCH_TARGET_DYNAMIC && targets.find(desc->targetpc) != targets.end())
+				desc->flags |= OPFLAG_INTRABLOCK_BRANCH;
+	}
 }
 
 
@@ -391,3 +591,301 @@ void drc_frontend::release_descriptions()
 	// reclaim all the descriptors
 	m_desc_allocator.reclaim_all(m_desc_live_list);
 }
+
+
+//-------------------------------------------------
+//  read_code - append the code bytes for an
+//  opcode, returning false if the PC no longer
+//  maps to the same place or the memory can't be
+//  read directly
+//-------------------------------------------------
+
+bool drc_frontend::read_code(offs_t pc, offs_t physpc, u8 length, std::vector<u8> &code) const
+{
+	offs_t translated = pc;
+	if (!m_cpudevice.translate(AS_PROGRAM, TRANSLATE_FETCH_DEBUG, translated) || translated != physpc)
+		return false;
+
+	// go a bus word at a time, since the opcode may straddle two regions and
+	// read pointers only resolve to the word containing an address; each unit
+	// is read from wherever describe() fetches it
+	int const wordbytes = m_program.data_width() / 8;
+	offs_t const wordunits = (std::max<offs_t>)(wordbytes / m_program.address_to_byte(1), 1);
+	offs_t previous = 0;
+	for (offs_t offset = 0; offset < length; offset++)
+	{
+		offs_t const address = fetch_address(physpc, offset) & ~(wordunits - 1);
+		if (offset != 0 && address == previous)
+			continue;
+		previous = address;
+
+		// only look at memory that can be read without side effects
+		if (m_program.get_read_ptr(address) == nullptr)
+			return false;
+
+		u64 word;
+		switch (wordbytes)
+		{
+		case 1: word = m_program.read_byte(address); break;
+		case 2: word = m_program.read_word(address); break;
+		case 4: word = m_program.read_dword(address); break;
+		default: word = m_program.read_qword(address); break;
+		}
+
+		// store the bytes in memory order
+		for (int index = 0; index < wordbytes; index++)
+			code.push_back(u8(word >> (8 * ((m_program.endianness() == ENDIANNESS_BIG) ? (wordbytes - 1 - index) : index))));
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  cache_descriptions - add a description and its
+//  delay slots to a cached block
+//-------------------------------------------------
+
+bool drc_frontend::cache_descriptions(cached_block &block, opcode_desc const &desc) const
+{
+	if ((desc.flags & (OPFLAG_COMPILER_PAGE_FAULT | OPFLAG_COMPILER_UNMAPPED)) || !read_code(desc.pc, desc.physpc, desc.length, block.code))
+		return false;
+
+	cached_desc entry;
+	entry.pc = desc.pc;
+	entry.physpc = desc.physpc;
+	entry.targetpc = desc.targetpc;
+	memcpy(entry.opptr, desc.opptr.b, sizeof(entry.opptr));
+	entry.length = desc.length;
+	entry.delayslots = desc.delayslots;
+	entry.skipslots = desc.skipslots;
+	entry.delaycount = desc.delay.count();
+	entry.flags = desc.flags;
+	entry.userflags = desc.userflags;
+	entry.userdata0 = desc.userdata0;
+	entry.cycles = desc.cycles;
+	memcpy(entry.regin, desc.regin, sizeof(entry.regin));
+	memcpy(entry.regout, desc.regout, sizeof(entry.regout));
+	memcpy(entry.regreq, desc.regreq, sizeof(entry.regreq));
+	block.descs.push_back(entry);
+
+	for (opcode_desc const *delay = desc.delay.first(); delay != nullptr; delay = delay->next())
+		if (!cache_descriptions(block, *delay))
+			return false;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  restore_descriptions - rebuild the live list
+//  from a cached block if the code it was built
+//  from is still there
+//-------------------------------------------------
+
+bool drc_frontend::restore_descriptions(cached_block const &block)
+{
+	// verify the code first
+	std::vector<u8> code;
+	code.reserve(block.code.size());
+	for (cached_desc const &entry : block.descs)
+		if (!read_code(entry.pc, entry.physpc, entry.length, code))
+			return false;
+	if (code != block.code)
+		return false;
+
+	// then rebuild the list
+	cached_desc const *cur = block.descs.data();
+	cached_desc const *const end = cur + block.descs.size();
+	while (cur != end)
+		m_desc_live_list.append(*restore_one(cur));
+	return true;
+}
+
+
+//-------------------------------------------------
+//  restore_one - rebuild a single description
+//  and its delay slots
+//-------------------------------------------------
+
+opcode_desc *drc_frontend::restore_one(cached_desc const *&cur)
+{
+	cached_desc const &entry = *cur++;
+	opcode_desc *const desc = m_desc_allocator.alloc();
+	desc->m_next = nullptr;
+	desc->branch = nullptr;
+	desc->delay.reset();
+	desc->pc = entry.pc;
+	desc->physpc = entry.physpc;
+	desc->targetpc = entry.targetpc;
+	memcpy(desc->opptr.b, entry.opptr, sizeof(entry.opptr));
+	desc->length = entry.length;
+	desc->delayslots = entry.delayslots;
+	desc->skipslots = entry.skipslots;
+	desc->flags = entry.flags;
+	desc->userflags = entry.userflags;
+	desc->userdata0 = entry.userdata0;
+	desc->cycles = entry.cycles;
+	memcpy(desc->regin, entry.regin, sizeof(desc->regin));
+	memcpy(desc->regout, entry.regout, sizeof(desc->regout));
+	memcpy(desc->regreq, entry.regreq, sizeof(desc->regreq));
+
+	for (u8 slotnum = 0; slotnum < entry.delaycount; slotnum++)
+	{
+		opcode_desc *const delaydesc = restore_one(cur);
+		delaydesc->branch = desc;
+		desc->delay.append(*delaydesc);
+	}
+	return desc;
+}
+
+
+//-------------------------------------------------
+//  cache_filename - returns the name of the
+//  persistent cache file for this CPU
+//-------------------------------------------------
+
+std::string drc_frontend::cache_filename() const
+{
+	std::string tag(m_cpudevice.tag());
+	tag.erase(0, 1);
+	strreplacechr(tag, ':', '_');
+	return std::string(m_cpudevice.machine().basename()).append(PATH_SEPARATOR).append(tag).append(".drc");
+}
+
+
+//-------------------------------------------------
+//  load_cache - read the persistent cache, if
+//  it was written by the same kind of CPU with
+//  the same configuration
+//-------------------------------------------------
+
+void drc_frontend::load_cache()
+{
+	emu_file file(m_cpudevice.machine().options().drc_cache_directory(), OPEN_FLAG_READ);
+	if (file.open(cache_filename()))
+		return;
+
+	std::vector<u8> data(file.size());
+	if (file.read(data.data(), data.size()) != data.size())
+		return;
+
+	// check the header matches
+	cache_reader reader(data);
+	char magic[sizeof(CACHE_MAGIC)];
+	reader.bytes(magic, sizeof(magic));
+	u32 const version = reader.u32();
+	std::string shortname(std::min<size_t>(reader.u32(), reader.remaining()), '\0');
+	reader.bytes(&shortname[0], shortname.size());
+	u32 const window_start = reader.u32();
+	u32 const window_end = reader.u32();
+	u32 const max_sequence = reader.u32();
+	if (!reader.ok() || memcmp(magic, CACHE_MAGIC, sizeof(magic)) || version != CACHE_VERSION || shortname != m_cpudevice.shortname() ||
+			window_start != m_window_start || window_end != m_window_end || max_sequence != m_max_sequence)
+	{
+		osd_printf_verbose("%s: discarding DRC cache from a different configuration\n", m_cpudevice.tag());
+		return;
+	}
+
+	// read the blocks; if anything is wrong, throw away the lot
+	std::unordered_map<offs_t, cached_block> cache;
+	bool valid = true;
+	for (u32 blocks = reader.u32(); valid && reader.ok() && blocks > 0; blocks--)
+	{
+		cached_block &block = cache[reader.u32()];
+		block.code.resize(std::min<size_t>(reader.u32(), reader.remaining()));
+		reader.bytes(block.code.data(), block.code.size());
+		block.descs.resize(std::min<size_t>(reader.u32(), reader.remaining()));
+		for (cached_desc &entry : block.descs)
+		{
+			entry.pc = reader.u32();
+			entry.physpc = reader.u32();
+			entry.targetpc = reader.u32();
+			reader.bytes(entry.opptr, sizeof(entry.opptr));
+			entry.length = reader.u8();
+			entry.delayslots = reader.u8();
+			entry.skipslots = reader.u8();
+			entry.delaycount = reader.u8();
+			entry.flags = reader.u32();
+			entry.userflags = reader.u32();
+			entry.userdata0 = reader.u32();
+			entry.cycles = reader.u32();
+			for (u32 &reg : entry.regin) reg = reader.u32();
+			for (u32 &reg : entry.regout) reg = reader.u32();
+			for (u32 &reg : entry.regreq) reg = reader.u32();
+		}
+
+		// delay slot counts must not run off the end of the block
+		u32 owed = 0;
+		for (cached_desc const &entry : block.descs)
+			owed = (owed ? (owed - 1) : 0) + entry.delaycount;
+		valid = !block.descs.empty() && owed == 0;
+	}
+	if (!valid || !reader.ok() || reader.remaining())
+	{
+		osd_printf_verbose("%s: discarding corrupt DRC cache\n", m_cpudevice.tag());
+		return;
+	}
+	m_cache = std::move(cache);
+	osd_printf_verbose("%s: loaded %u blocks from DRC cache\n", m_cpudevice.tag(), u32(m_cache.size()));
+}
+
+
+//-------------------------------------------------
+//  save_cache - write the persistent cache back
+//  out if anything has changed
+//-------------------------------------------------
+
+void drc_frontend::save_cache()
+{
+	// report what the cache saved this run, as the time taken to restore
+	// blocks against the time taken to describe the ones that missed
+	if (m_cache_hits != 0 || m_cache_misses != 0)
+	{
+		osd_ticks_t const tps = osd_ticks_per_second();
+		osd_printf_verbose("%s: DRC description cache: %u hits taking %.3f ms, %u misses taking %.3f ms\n", m_cpudevice.tag(),
+				m_cache_hits, double(m_restore_ticks) * 1000.0 / double(tps),
+				m_cache_misses, double(m_describe_ticks) * 1000.0 / double(tps));
+	}
+
+	if (!m_cache_dirty)
+		return;
+
+	cache_writer writer;
+	writer.bytes(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+	writer.u32(CACHE_VERSION);
+	writer.u32(strlen(m_cpudevice.shortname()));
+	writer.bytes(m_cpudevice.shortname(), strlen(m_cpudevice.shortname()));
+	writer.u32(m_window_start);
+	writer.u32(m_window_end);
+	writer.u32(m_max_sequence);
+	writer.u32(m_cache.size());
+	for (auto const &cached : m_cache)
+	{
+		cached_block const &block = cached.second;
+		writer.u32(cached.first);
+		writer.u32(block.code.size());
+		writer.bytes(block.code.data(), block.code.size());
+		writer.u32(block.descs.size());
+		for (cached_desc const &entry : block.descs)
+		{
+			writer.u32(entry.pc);
+			writer.u32(entry.physpc);
+			writer.u32(entry.targetpc);
+			writer.bytes(entry.opptr, sizeof(entry.opptr));
+			writer.u8(entry.length);
+			writer.u8(entry.delayslots);
+			writer.u8(entry.skipslots);
+			writer.u8(entry.delaycount);
+			writer.u32(entry.flags);
+			writer.u32(entry.userflags);
+			writer.u32(entry.userdata0);
+			writer.u32(entry.cycles);
+			for (u32 reg : entry.regin) writer.u32(reg);
+			for (u32 reg : entry.regout) writer.u32(reg);
+			for (u32 reg : entry.regreq) writer.u32(reg);
+		}
+	}
+
+	emu_file file(m_cpudevice.machine().options().drc_cache_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file.open(cache_filename()) || file.write(writer.data().data(), writer.data().size()) != writer.data().size())
+		osd_printf_warning("%s: unable to write DRC cache\n", m_cpudevice.tag());
+}
@@ -27,12 +27,34 @@
     walkthrough is finished, these descriptions are assembled together into
     a linked list and returned for further processing by the backend.
 
+    If the drc_cache option is enabled, the descriptions produced for each
+    starting PC are also kept in a persistent description cache, saved on
+    exit and loaded on the next run. This only saves walking and describing
+    the code; the UML and host code are still generated every run, since
+    both embed host addresses that change from run to run. A cached block
+    is only used if every opcode still translates to the same physical
+    address and the code bytes describe() reads, as located by
+    fetch_address(), are unchanged; anything else discards the entry and
+    the block is described afresh. Front-ends must only depend on the CPU
+    type and the code itself in describe() for this to be valid; those that
+    also depend on CPU state pass cacheable = false to the constructor.
+
+    Cores can also count how often each static branch out of a block is
+    taken using exit_counter(). Once an exit has been taken often enough
+    the core asks for its block to be compiled again, and this time the
+    frontend follows the exit and appends the code at its target as extra
+    sequences ("forming a trace"), marking the branch as intrablock so the
+    core can jump straight there instead of through the hash table. Exits
+    that aren't hot stay as they are and act as side exits from the trace.
+
 ***************************************************************************/
 #ifndef MAME_CPU_DRCFE_H
 #define MAME_CPU_DRCFE_H
 
 #pragma once
 
+#include <unordered_map>
+
 
 //**************************************************************************
 //  CONSTANTS
@@ -128,7 +150,7 @@ class drc_frontend
 {
 public:
 	// construction/destruction
-	drc_frontend(device_t &cpu, u32 window_start, u32 window_end, u32 max_sequence);
+	drc_frontend(device_t &cpu, u32 window_start, u32 window_end, u32 max_sequence, bool cacheable = true);
 	virtual ~drc_frontend();
 
 	// describe a block
@@ -136,17 +158,65 @@ public:
 	// get last opcode of block
 	opcode_desc const *get_last() { return m_desc_live_list.last(); }
 
+	// trace formation
+	u32 trace_threshold() const { return m_trace_threshold; }
+	u32 *exit_counter(offs_t srcpc, offs_t targetpc);
+	offs_t *pending_trace() { return &m_pending_trace; }
+	offs_t take_pending_trace() { offs_t const result = m_pending_trace; m_pending_trace = BRANCH_TARGET_DYNAMIC; return result; }
+
 protected:
 	// required overrides
 	virtual bool describe(opcode_desc &desc, opcode_desc const *prev) = 0;
 
+	// the program space address describe() reads a unit of an opcode from,
+	// for front-ends that don't fetch straight from physpc onwards
+	virtual offs_t fetch_address(offs_t physpc, offs_t offset) const { return physpc + offset; }
+
 private:
+	// a description as kept in the persistent cache
+	struct cached_desc
+	{
+		offs_t          pc;
+		offs_t          physpc;
+		offs_t          targetpc;
+		u8              opptr[16];
+		u8              length;
+		u8              delayslots;
+		u8              skipslots;
+		u8              delaycount;             // number of following entries that are our delay slots
+		u32             flags;
+		u32             userflags;
+		u32             userdata0;
+		u32             cycles;
+		u32             regin[4];
+		u32             regout[4];
+		u32             regreq[4];
+	};
+
+	// a described block as kept in the persistent cache
+	struct cached_block
+	{
+		std::vector<u8>          code;          // code bytes the descriptions were built from
+		std::vector<cached_desc> descs;         // descriptions in list order, delay slots following their branch
+	};
+
 	// internal helpers
+	void describe_window(offs_t startpc, offs_t minpc, offs_t maxpc);
 	opcode_desc *describe_one(offs_t curpc, opcode_desc const *prevdesc, bool in_delay_slot = false);
+	void form_trace(offs_t minpc, offs_t maxpc);
 	void build_sequence(int start, int end, u32 endflag);
 	void accumulate_required_backwards(opcode_desc &desc, u32 *reqmask);
 	void release_descriptions();
 
+	// persistent cache helpers
+	bool read_code(offs_t pc, offs_t physpc, u8 length, std::vector<u8> &code) const;
+	bool cache_descriptions(cached_block &block, opcode_desc const &desc) const;
+	bool restore_descriptions(cached_block const &block);
+	opcode_desc *restore_one(cached_desc const *&cur);
+	std::string cache_filename() const;
+	void load_cache();
+	void save_cache();
+
 	// configuration parameters
 	u32                 m_window_start;             // code window start offset = startpc - window_start
 	u32                 m_window_end;               // code window end offset = startpc + window_end
@@ -161,6 +231,21 @@ private:
 	simple_list<opcode_desc> m_desc_live_list;      // list of live descriptions
 	fixed_allocator<opcode_desc> m_desc_allocator;  // fixed allocator for descriptions
 	std::vector<opcode_desc *> m_desc_array;        // array of descriptions in PC order
+
+	// persistent cache
+	bool                m_cache_enabled;            // true if the drc_cache option is set
+	bool                m_cache_dirty;              // true if the cache has changed since it was loaded
+	u32                 m_cache_hits;               // blocks restored from the cache this run
+	u32                 m_cache_misses;             // blocks described afresh this run
+	osd_ticks_t         m_restore_ticks;            // time spent restoring blocks
+	osd_ticks_t         m_describe_ticks;           // time spent describing blocks that missed
+	std::unordered_map<offs_t, cached_block> m_cache; // cached blocks indexed by starting PC
+
+	// trace formation
+	u32                 m_trace_threshold;          // exit count at which a block is extended, or 0 if disabled
+	u32                 m_max_traces;               // maximum exits to follow from one block
+	offs_t              m_pending_trace;            // block the core should recompile, or BRANCH_TARGET_DYNAMIC
+	std::unordered_map<u64, u32> m_exit_counts;     // times each static exit was taken, indexed by source and target PC
 };
 
 #endif // MAME_CPU_DRCFE_H
@@ -41,6 +41,7 @@
 #include "drcbex64.h"
 #endif
 
+#include <algorithm>
 #include <fstream>
 
 
@@ -78,6 +79,103 @@ struct bevalidate_test
 
 
 
+//**************************************************************************
+//  OPTIMIZATION HELPERS
+//**************************************************************************
+
+namespace {
+
+//-------------------------------------------------
+//  is_optimization_barrier - returns true if
+//  nothing can be assumed about register or
+//  memory contents after an instruction
+//-------------------------------------------------
+
+bool is_optimization_barrier(uml::instruction const &inst)
+{
+	switch (inst.opcode())
+	{
+	// code can be entered here from elsewhere
+	case uml::OP_HANDLE:
+	case uml::OP_HASH:
+	case uml::OP_LABEL:
+
+	// other code runs and may change anything
+	case uml::OP_DEBUG:
+	case uml::OP_EXH:
+	case uml::OP_CALLH:
+	case uml::OP_CALLC:
+	case uml::OP_HASHJMP:
+	case uml::OP_RESTORE:
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+
+//-------------------------------------------------
+//  writes_unnamed_memory - returns true if an
+//  instruction may write memory other than its
+//  own memory parameters
+//-------------------------------------------------
+
+bool writes_unnamed_memory(uml::instruction const &inst)
+{
+	switch (inst.opcode())
+	{
+	// indexed stores can go anywhere in the array
+	case uml::OP_STORE:
+	case uml::OP_FSTORE:
+
+	// memory handlers may poke the CPU's state
+	case uml::OP_READ:
+	case uml::OP_READM:
+	case uml::OP_WRITE:
+	case uml::OP_WRITEM:
+	case uml::OP_FREAD:
+	case uml::OP_FWRITE:
+
+	// the whole machine state is written
+	case uml::OP_SAVE:
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+
+//-------------------------------------------------
+//  count_instructions - count instructions that
+//  generate code
+//-------------------------------------------------
+
+u32 count_instructions(std::vector<uml::instruction> const &inst, u32 count)
+{
+	u32 result = 0;
+	for (u32 instnum = 0; instnum < count; instnum++)
+	{
+		switch (inst[instnum].opcode())
+		{
+		case uml::OP_NOP:
+		case uml::OP_COMMENT:
+		case uml::OP_MAPVAR:
+			break;
+
+		default:
+			result++;
+			break;
+		}
+	}
+	return result;
+}
+
+} // anonymous namespace
+
+
+
 //**************************************************************************
 //  DRC BACKEND INTERFACE
 //**************************************************************************
@@ -149,6 +247,7 @@ drcuml_state::drcuml_state(device_t &device, drc_cache &cache, u32 flags, int mo
 	, m_handlelist()
 	, m_symlist()
 {
+	m_cache.add_evict_handler(drc_evict_delegate(&drcuml_state::evict, this));
 }
 
 
@@ -201,6 +300,22 @@ void drcuml_state::reset()
 }
 
 
+//-------------------------------------------------
+//  evict - forget handle targets in code that
+//  has been discarded
+//-------------------------------------------------
+
+void drcuml_state::evict(drccodeptr start, drccodeptr end)
+{
+	// regions with handle targets are pinned, so this shouldn't find anything
+	for (uml::code_handle &handle : m_handlelist)
+	{
+		if (handle.codeptr() >= start && handle.codeptr() < end)
+			*handle.codeptr_addr() = nullptr;
+	}
+}
+
+
 //-------------------------------------------------
 //  begin_block - begin a new code block
 //-------------------------------------------------
@@ -340,7 +455,13 @@ void drcuml_block::end()
 {
 	assert(m_inuse);
 
-	// optimize the resulting code first
+	// pick the region the code goes in first, so entries can be counted against it
+	m_drcuml.cache().codegen_init();
+	m_drcuml.cache().begin_block();
+	if (u64 *const counter = m_drcuml.cache().entry_counter())
+		count_entries(counter);
+
+	// optimize the resulting code
 	optimize();
 
 	// if we have a logfile, generate a disassembly of the block
@@ -348,9 +469,18 @@ void drcuml_block::end()
 		disassemble();
 
 	// generate the code via the back-end
-	m_drcuml.cache().codegen_init();
 	m_drcuml.generate(*this, &m_inst[0], m_nextinst);
 
+	// other code may call handle targets directly, so keep them around until the next flush
+	for (u32 inum = 0; inum < m_nextinst; inum++)
+	{
+		if (m_inst[inum].opcode() == uml::OP_HANDLE)
+		{
+			m_drcuml.cache().pin_current();
+			break;
+		}
+	}
+
 	// block is no longer in use
 	m_inuse = false;
 }
@@ -387,6 +517,32 @@ uml::instruction &drcuml_block::append()
 }
 
 
+//-------------------------------------------------
+//  count_entries - add to a counter at each hash
+//  entry point, so the cache knows how often the
+//  code is used
+//-------------------------------------------------
+
+void drcuml_block::count_entries(u64 *counter)
+{
+	u32 const entries = std::count_if(&m_inst[0], &m_inst[0] + m_nextinst, [] (uml::instruction const &inst) { return inst.opcode() == uml::OP_HASH; });
+	if (entries == 0)
+		return;
+	if (m_inst.size() < (m_nextinst + entries))
+		m_inst.resize(m_nextinst + entries);
+
+	// work backwards so each instruction only moves once
+	u32 dest = m_nextinst + entries;
+	for (u32 src = m_nextinst; src-- > 0; )
+	{
+		if (m_inst[src].opcode() == uml::OP_HASH)
+			m_inst[--dest].dadd(uml::mem(counter), uml::mem(counter), 1);
+		m_inst[--dest] = m_inst[src];
+	}
+	m_nextinst += entries;
+}
+
+
 //-------------------------------------------------
 //  optimize - apply various optimizations to a
 //  block of code
@@ -394,6 +550,7 @@ uml::instruction &drcuml_block::append()
 
 void drcuml_block::optimize()
 {
+	u32 const before = count_instructions(m_inst, m_nextinst);
 	u32 mapvar[uml::MAPVAR_COUNT] = { 0 };
 
 	// iterate over instructions
@@ -431,6 +588,220 @@ void drcuml_block::optimize()
 		// now that flags are correct, simplify the instruction
 		inst.simplify();
 	}
+
+	// then run the passes that look across instructions
+	drcbe_info info;
+	m_drcuml.get_backend_info(info);
+	propagate_constants();
+	forward_values(info);
+
+	if (m_drcuml.logging())
+		m_drcuml.log_printf("; optimized %u instructions to %u\n", before, count_instructions(m_inst, m_nextinst));
+}
+
+
+//-------------------------------------------------
+//  propagate_constants - substitute immediates
+//  for registers holding known values, and fold
+//  the results
+//-------------------------------------------------
+
+void drcuml_block::propagate_constants()
+{
+	struct known_value
+	{
+		bool    valid;
+		u8      size;
+		u64     value;
+	};
+	known_value known[uml::REG_I_COUNT] = { };
+
+	for (int instnum = 0; instnum < m_nextinst; instnum++)
+	{
+		uml::instruction &inst(m_inst[instnum]);
+		if (is_optimization_barrier(inst))
+		{
+			std::fill(std::begin(known), std::end(known), known_value{ false, 0, 0 });
+			continue;
+		}
+
+		// substitute known values for registers that are only read
+		uml::instruction const original(inst);
+		bool substituted = false;
+		for (int pnum = 0; pnum < inst.numparams(); pnum++)
+		{
+			uml::parameter const &param(inst.param(pnum));
+			if (!param.is_int_register() || inst.param_is_output(pnum) || !inst.param_accepts_immediate(pnum))
+				continue;
+			known_value const &value(known[param.ireg() - uml::REG_I0]);
+			u8 const bytes(inst.param_bytes(pnum));
+			if (value.valid && bytes && (bytes <= value.size))
+			{
+				inst.set_param(pnum, (bytes == 4) ? u64(u32(value.value)) : value.value);
+				substituted = true;
+			}
+		}
+
+		// keep the substitution if it folded away, or if it still leaves a register
+		// or memory operand; back-ends aren't expected to handle every immediate combination
+		if (substituted)
+		{
+			inst.simplify();
+			bool keep = (inst.opcode() == uml::OP_NOP) || ((inst.opcode() == uml::OP_MOV) && inst.param(1).is_immediate());
+			for (int pnum = 0; !keep && pnum < inst.numparams(); pnum++)
+				keep = inst.param_is_input(pnum) && !inst.param_is_output(pnum) && inst.param_accepts_immediate(pnum) && !inst.param(pnum).is_immediate();
+			if (!keep)
+				inst = original;
+		}
+
+		// forget registers that are written, then remember constant moves
+		for (int pnum = 0; pnum < inst.numparams(); pnum++)
+			if (inst.param_is_output(pnum) && inst.param(pnum).is_int_register())
+				known[inst.param(pnum).ireg() - uml::REG_I0].valid = false;
+		if ((inst.opcode() == uml::OP_MOV) && (inst.condition() == uml::COND_ALWAYS) && inst.param(0).is_int_register() && inst.param(1).is_immediate())
+		{
+			u64 const value = (inst.size() == 4) ? u64(u32(inst.param(1).immediate())) : inst.param(1).immediate();
+			known[inst.param(0).ireg() - uml::REG_I0] = known_value{ true, inst.size(), value };
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  forward_values - drop stores of values that
+//  are already in memory, and read values from
+//  registers the back-end keeps in host registers
+//  rather than memory where possible
+//-------------------------------------------------
+
+void drcuml_block::forward_values(drcbe_info const &info)
+{
+	// memory each register holds a copy of, and registers each register holds a copy of
+	struct memory_copy
+	{
+		void *  base;
+		u8      size;
+	};
+	struct register_copy
+	{
+		int     reg;
+		u8      size;
+	};
+	memory_copy memcopy[uml::REG_I_COUNT];
+	register_copy regcopy[uml::REG_I_COUNT];
+	auto const forget_all = [&memcopy, &regcopy] ()
+	{
+		std::fill(std::begin(memcopy), std::end(memcopy), memory_copy{ nullptr, 0 });
+		std::fill(std::begin(regcopy), std::end(regcopy), register_copy{ -1, 0 });
+	};
+	auto const is_direct = [&info] (int reg) { return (reg - uml::REG_I0) < info.direct_iregs; };
+	forget_all();
+
+	for (int instnum = 0; instnum < m_nextinst; instnum++)
+	{
+		uml::instruction &inst(m_inst[instnum]);
+		if (is_optimization_barrier(inst))
+		{
+			forget_all();
+			continue;
+		}
+
+		bool const plainmov = (inst.opcode() == uml::OP_MOV) && (inst.condition() == uml::COND_ALWAYS);
+		if (plainmov)
+		{
+			uml::parameter const &dst(inst.param(0));
+			uml::parameter const &src(inst.param(1));
+
+			// storing a register back to the memory it was copied from does nothing
+			if (dst.is_memory() && src.is_int_register())
+			{
+				memory_copy const &copy(memcopy[src.ireg() - uml::REG_I0]);
+				if ((copy.base == dst.memory()) && (copy.size == inst.size()))
+				{
+					inst.nop();
+					continue;
+				}
+			}
+
+			// loading memory that a register already holds can be a register move
+			if (dst.is_int_register() && src.is_memory())
+			{
+				for (int reg = 0; reg < uml::REG_I_COUNT; reg++)
+				{
+					if ((memcopy[reg].base == src.memory()) && (memcopy[reg].size == inst.size()))
+					{
+						if ((uml::REG_I0 + reg) == dst.ireg())
+						{
+							inst.nop();
+							break;
+						}
+						else if (is_direct(uml::REG_I0 + reg))
+						{
+							inst.set_param(1, uml::parameter::make_ireg(uml::REG_I0 + reg));
+							break;
+						}
+					}
+				}
+				if (inst.opcode() == uml::OP_NOP)
+					continue;
+			}
+		}
+
+		// read copies from registers the back-end keeps in host registers
+		for (int pnum = 0; pnum < inst.numparams(); pnum++)
+		{
+			uml::parameter const &param(inst.param(pnum));
+			if (!param.is_int_register() || inst.param_is_output(pnum) || is_direct(param.ireg()))
+				continue;
+			register_copy const &copy(regcopy[param.ireg() - uml::REG_I0]);
+			u8 const bytes(inst.param_bytes(pnum));
+			if ((copy.reg >= 0) && is_direct(copy.reg) && bytes && (bytes <= copy.size))
+				inst.set_param(pnum, uml::parameter::make_ireg(copy.reg));
+		}
+
+		// forget anything this instruction overwrites
+		if (writes_unnamed_memory(inst))
+			std::fill(std::begin(memcopy), std::end(memcopy), memory_copy{ nullptr, 0 });
+		for (int pnum = 0; pnum < inst.numparams(); pnum++)
+		{
+			if (!inst.param_is_output(pnum))
+				continue;
+			uml::parameter const &param(inst.param(pnum));
+			if (param.is_int_register())
+			{
+				int const reg(param.ireg());
+				memcopy[reg - uml::REG_I0] = memory_copy{ nullptr, 0 };
+				regcopy[reg - uml::REG_I0] = register_copy{ -1, 0 };
+				for (register_copy &copy : regcopy)
+					if (copy.reg == reg)
+						copy = register_copy{ -1, 0 };
+			}
+			else if (param.is_memory())
+			{
+				// be generous about the size so overlapping fields are caught too
+				uintptr_t const start(reinterpret_cast<uintptr_t>(param.memory()));
+				for (memory_copy &copy : memcopy)
+				{
+					uintptr_t const base(reinterpret_cast<uintptr_t>(copy.base));
+					if (copy.base && (base < (start + 16)) && ((base + copy.size) > start))
+						copy = memory_copy{ nullptr, 0 };
+				}
+			}
+		}
+
+		// remember what plain moves copied
+		if (plainmov)
+		{
+			uml::parameter const &dst(inst.param(0));
+			uml::parameter const &src(inst.param(1));
+			if (dst.is_int_register() && src.is_memory())
+				memcopy[dst.ireg() - uml::REG_I0] = memory_copy{ src.memory(), inst.size() };
+			else if (dst.is_memory() && src.is_int_register())
+				memcopy[src.ireg() - uml::REG_I0] = memory_copy{ dst.memory(), inst.size() };
+			else if (dst.is_int_register() && src.is_int_register() && (dst != src))
+				regcopy[dst.ireg() - uml::REG_I0] = register_copy{ src.ireg(), inst.size() };
+		}
+	}
 }
 
 
@@ -112,7 +112,10 @@ public:
 
 private:
 	// internal helpers
+	void count_entries(u64 *counter);
 	void optimize();
+	void propagate_constants();
+	void forward_values(drcbe_info const &info);
 	void disassemble();
 	char const *get_comment_text(uml::instruction const &inst, std::string &comment);
 
@@ -197,6 +200,9 @@ public:
 	bool logging_native() const { return m_beintf->logging(); }
 
 private:
+	// internal helpers
+	void evict(drccodeptr start, drccodeptr end);
+
 	// symbol class
 	class symbol
 	{
@@ -219,9 +219,15 @@ bool dsp16_device_base::frontend::describe(opcode_desc &desc, opcode_desc const
     program fetch helpers
 ***********************************************************************/
 
+offs_t dsp16_device_base::frontend::fetch_address(offs_t physpc, offs_t offset) const
+{
+	// operands wrap within the page like the program counter does
+	return (physpc & XAAU_I_EXT) | ((physpc + offset) & XAAU_I_MASK);
+}
+
 u16 dsp16_device_base::frontend::read_op(opcode_desc const &desc, u16 offset)
 {
-	return m_host.m_pcache.read_word((desc.physpc & XAAU_I_EXT) | ((desc.physpc + offset) & XAAU_I_MASK));
+	return m_host.m_pcache.read_word(fetch_address(desc.physpc, offset));
 }
 
 /***********************************************************************
@@ -63,6 +63,7 @@ public:
 protected:
 	// drc_frontend implementation
 	virtual bool describe(opcode_desc &desc, opcode_desc const *prev) override;
+	virtual offs_t fetch_address(offs_t physpc, offs_t offset) const override;
 
 private:
 	// program fetch helpers
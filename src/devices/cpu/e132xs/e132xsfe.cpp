@@ -22,8 +22,10 @@
     INSTRUCTION PARSERS
 ***************************************************************************/
 
+// describe() maps local registers through the frame pointer in SR, so
+// descriptions can't be kept in the persistent cache
 e132xs_frontend::e132xs_frontend(hyperstone_device *e132xs, uint32_t window_start, uint32_t window_end, uint32_t max_sequence)
-	: drc_frontend(*e132xs, window_start, window_end, max_sequence)
+	: drc_frontend(*e132xs, window_start, window_end, max_sequence, false)
 	, m_cpu(e132xs)
 {
 }
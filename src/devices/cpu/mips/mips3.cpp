@@ -5064,7 +5064,12 @@ void mips3_device::execute_run()
 			/* if we need to recompile, do it */
 			if (execute_result == EXECUTE_MISSING_CODE)
 			{
-				code_compile_block(m_core->mode, m_core->pc);
+				/* a hot exit asks for its block to be compiled again as a trace first */
+				offs_t const tracepc = m_drcfe->take_pending_trace();
+				if (tracepc != BRANCH_TARGET_DYNAMIC)
+					code_compile_block(m_core->mode, tracepc);
+				if (tracepc == BRANCH_TARGET_DYNAMIC || !m_drcuml->hash_exists(m_core->mode, m_core->pc))
+					code_compile_block(m_core->mode, m_core->pc);
 			}
 			else if (execute_result == EXECUTE_UNMAPPED_CODE)
 			{
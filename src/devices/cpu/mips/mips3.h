@@ -613,6 +613,7 @@ private:
 		uint8_t          checkints;                  /* need to check interrupts before next instruction */
 		uint8_t          checksoftints;              /* need to check software interrupts before next instruction */
 		uml::code_label  labelnum;                   /* index for local labels */
+		offs_t           blockpc;                    /* PC the block was compiled from */
 	};
 
 	void static_generate_entry_point();
@@ -627,6 +628,7 @@ private:
 	void generate_checksum_block(drcuml_block &block, compiler_state &compiler, const opcode_desc *seqhead, const opcode_desc *seqlast, const opcode_desc *codelast);
 	void generate_sequence_instruction(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
 	void generate_delay_slot_and_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint8_t linkreg);
+	void generate_exit_counter(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
 
 	bool generate_opcode(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
 	bool generate_special(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
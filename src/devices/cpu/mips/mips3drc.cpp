@@ -301,6 +301,7 @@ void mips3_device::code_compile_block(uint8_t mode, offs_t pc)
 	bool override = false;
 
 	g_profiler.start(PROFILER_DRC_COMPILE);
+	compiler.blockpc = pc;
 
 	/* get a description of this sequence */
 	desclist = m_drcfe->describe_code(pc);
@@ -1449,6 +1450,8 @@ void mips3_device::generate_delay_slot_and_branch(drcuml_block &block, compiler_
 		}
 		else
 		{
+			if (!(m_drcoptions & MIPS3DRC_DISABLE_INTRABLOCK))
+				generate_exit_counter(block, compiler_temp, desc);                      // <count exit>
 			UML_HASHJMP(block, m_core->mode, desc->targetpc, *m_nocode);            // hashjmp <mode>,desc->targetpc,nocode
 		}
 	}
@@ -1467,6 +1470,30 @@ void mips3_device::generate_delay_slot_and_branch(drcuml_block &block, compiler_
 }
 
 
+/*-------------------------------------------------
+    generate_exit_counter - count a static branch
+    out of the block, and have the block compiled
+    again as a trace once the branch is hot
+-------------------------------------------------*/
+
+void mips3_device::generate_exit_counter(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	uint32_t *const counter = m_drcfe->exit_counter(desc->pc, desc->targetpc);
+	if (counter == nullptr)
+		return;
+
+	uml::code_label const skip = compiler.labelnum++;
+	UML_ADD(block, mem(counter), mem(counter), 1);                                 // add     [counter],[counter],1
+	UML_CMP(block, mem(counter), m_drcfe->trace_threshold());                      // cmp     [counter],threshold
+	UML_JMPc(block, COND_NE, skip);                                                 // jmp     skip,ne
+	UML_MOV(block, mem(m_drcfe->pending_trace()), compiler.blockpc);               // mov     [pending_trace],blockpc
+	UML_MOV(block, mem(&m_core->pc), desc->targetpc);                              // mov     [pc],desc->targetpc
+	save_fast_iregs(block);
+	UML_EXIT(block, EXECUTE_MISSING_CODE);                                          // exit    EXECUTE_MISSING_CODE
+	UML_LABEL(block, skip);                                                         // skip:
+}
+
+
 /*-------------------------------------------------
     generate_opcode - generate code for a specific
     opcode
@@ -619,6 +619,7 @@ protected:
 		uint8_t               checkints;                  /* need to check interrupts before next instruction */
 		uint8_t               checksoftints;              /* need to check software interrupts before next instruction */
 		uml::code_label  labelnum;                   /* index for local labels */
+		offs_t                blockpc;                    /* PC the block was compiled from */
 	};
 
 	uint32_t get_cr();
@@ -667,6 +668,7 @@ protected:
 	void generate_shift_flags(drcuml_block &block, const opcode_desc *desc, uint32_t op);
 	void generate_fp_flags(drcuml_block &block, const opcode_desc *desc, int updatefprf);
 	void generate_branch(drcuml_block &block, compiler_state *compiler, const opcode_desc *desc, int source, uint8_t link);
+	void generate_exit_counter(drcuml_block &block, compiler_state *compiler, const opcode_desc *desc);
 	void generate_branch_bo(drcuml_block &block, compiler_state *compiler, const opcode_desc *desc, uint32_t bo, uint32_t bi, int source, int link);
 	bool generate_opcode(drcuml_block &block, compiler_state *compiler, const opcode_desc *desc);
 	bool generate_instruction_13(drcuml_block &block, compiler_state *compiler, const opcode_desc *desc);
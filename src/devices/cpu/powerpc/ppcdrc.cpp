@@ -239,7 +239,14 @@ void ppc_device::execute_run()
 
 		/* if we need to recompile, do it */
 		if (execute_result == EXECUTE_MISSING_CODE)
-			code_compile_block(m_core->mode, m_core->pc);
+		{
+			/* a hot exit asks for its block to be compiled again as a trace first */
+			offs_t const tracepc = m_drcfe->take_pending_trace();
+			if (tracepc != BRANCH_TARGET_DYNAMIC)
+				code_compile_block(m_core->mode, tracepc);
+			if (tracepc == BRANCH_TARGET_DYNAMIC || !m_drcuml->hash_exists(m_core->mode, m_core->pc))
+				code_compile_block(m_core->mode, m_core->pc);
+		}
 		else if (execute_result == EXECUTE_UNMAPPED_CODE)
 			fatalerror("Attempted to execute unmapped code at PC=%08X\n", m_core->pc);
 		else if (execute_result == EXECUTE_RESET_CACHE)
@@ -382,6 +389,7 @@ void ppc_device::code_compile_block(uint8_t mode, offs_t pc)
 	bool override = false;
 
 	g_profiler.start(PROFILER_DRC_COMPILE);
+	compiler.blockpc = pc;
 
 	/* get a description of this sequence */
 	desclist = m_drcfe->describe_code(pc);
@@ -1944,8 +1952,11 @@ void ppc_device::generate_branch(drcuml_block &block, compiler_state *compiler,
 		if (desc->flags & OPFLAG_INTRABLOCK_BRANCH)
 			UML_JMP(block, desc->targetpc | 0x80000000);                                    // jmp     desc->targetpc | 0x80000000
 		else
+		{
+			generate_exit_counter(block, &compiler_temp, desc);                              // <count exit>
 			UML_HASHJMP(block, m_core->mode, desc->targetpc, *m_nocode);
 																							// hashjmp <mode>,desc->targetpc,nocode
+		}
 	}
 	else
 	{
@@ -1964,6 +1975,31 @@ void ppc_device::generate_branch(drcuml_block &block, compiler_state *compiler,
 }
 
 
+/*-------------------------------------------------
+    generate_exit_counter - count a static branch
+    out of the block, and have the block compiled
+    again as a trace once the branch is hot
+-------------------------------------------------*/
+
+void ppc_device::generate_exit_counter(drcuml_block &block, compiler_state *compiler, const opcode_desc *desc)
+{
+	uint32_t *const counter = m_drcfe->exit_counter(desc->pc, desc->targetpc);
+	if (counter == nullptr)
+		return;
+
+	int const skip = compiler->labelnum++;
+	UML_ADD(block, mem(counter), mem(counter), 1);                                          // add     [counter],[counter],1
+	UML_CMP(block, mem(counter), m_drcfe->trace_threshold());                               // cmp     [counter],threshold
+	UML_JMPc(block, COND_NE, skip);                                                         // jmp     skip,ne
+	UML_MOV(block, mem(m_drcfe->pending_trace()), compiler->blockpc);                       // mov     [pending_trace],blockpc
+	UML_MOV(block, mem(&m_core->pc), desc->targetpc);                                       // mov     [pc],desc->targetpc
+	save_fast_iregs(block);                                                                 // <save fastregs>
+	save_fast_fregs(block);
+	UML_EXIT(block, EXECUTE_MISSING_CODE);                                                  // exit    EXECUTE_MISSING_CODE
+	UML_LABEL(block, skip);                                                                 // skip:
+}
+
+
 /*-------------------------------------------------
     generate_branch_bo - generate a conditional
     branch based on the BO and BI fields
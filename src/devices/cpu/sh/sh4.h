@@ -785,6 +785,7 @@ public:
 
 protected:
 	virtual uint16_t read_word(opcode_desc &desc) override;
+	virtual offs_t fetch_address(offs_t physpc, offs_t offset) const override;
 
 private:
 	virtual bool describe_group_0(opcode_desc &desc, const opcode_desc *prev, uint16_t opcode) override;
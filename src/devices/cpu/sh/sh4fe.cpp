@@ -23,20 +23,22 @@ sh4_frontend::sh4_frontend(sh_common_execution *device, uint32_t window_start, u
 {
 }
 
-uint16_t sh4_frontend::read_word(opcode_desc &desc)
+offs_t sh4_frontend::fetch_address(offs_t physpc, offs_t offset) const
 {
-	if (desc.physpc >= 0xe0000000)
-		return m_sh->m_pr16(desc.physpc);
+	if (physpc >= 0xe0000000)
+		return physpc + offset;
 
-	return m_sh->m_pr16(desc.physpc & SH34_AM);
+	return (physpc + offset) & SH34_AM;
 }
 
-uint16_t sh4be_frontend::read_word(opcode_desc &desc)
+uint16_t sh4_frontend::read_word(opcode_desc &desc)
 {
-	if (desc.physpc >= 0xe0000000)
-		return m_sh->m_pr16(desc.physpc);
+	return m_sh->m_pr16(fetch_address(desc.physpc, 0));
+}
 
-	return m_sh->m_pr16(desc.physpc & SH34_AM);
+uint16_t sh4be_frontend::read_word(opcode_desc &desc)
+{
+	return m_sh->m_pr16(fetch_address(desc.physpc, 0));
 }
 
 
@@ -804,6 +804,55 @@ u8 uml::instruction::modified_flags() const
 }
 
 
+//-------------------------------------------------
+//  param_is_input/param_is_output - return
+//  whether a parameter is read or written
+//-------------------------------------------------
+
+bool uml::instruction::param_is_input(int pnum) const
+{
+	assert(pnum < m_numparams);
+	return (s_opcode_info_table[m_opcode].param[pnum].output & PIO_IN) != 0;
+}
+
+bool uml::instruction::param_is_output(int pnum) const
+{
+	assert(pnum < m_numparams);
+	return (s_opcode_info_table[m_opcode].param[pnum].output & PIO_OUT) != 0;
+}
+
+
+//-------------------------------------------------
+//  param_accepts_immediate - return whether a
+//  parameter may be given as an immediate
+//-------------------------------------------------
+
+bool uml::instruction::param_accepts_immediate(int pnum) const
+{
+	assert(pnum < m_numparams);
+	return (s_opcode_info_table[m_opcode].param[pnum].typemask & PTYPES_IMM) != 0;
+}
+
+
+//-------------------------------------------------
+//  param_bytes - return the size of an integer
+//  parameter in bytes, or 0 if it depends on
+//  another parameter
+//-------------------------------------------------
+
+u8 uml::instruction::param_bytes(int pnum) const
+{
+	assert(pnum < m_numparams);
+	switch (s_opcode_info_table[m_opcode].param[pnum].size)
+	{
+	case PSIZE_4:   return 4;
+	case PSIZE_8:   return 8;
+	case PSIZE_OP:  return m_size;
+	default:        return 0;
+	}
+}
+
+
 //-------------------------------------------------
 //  disasm - disassemble an instruction to the
 //  given buffer
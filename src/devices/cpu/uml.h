@@ -405,12 +405,17 @@ namespace uml
 		// setters
 		void set_flags(u8 flags) { m_flags = flags; }
 		void set_mapvar(int paramnum, u32 value) { assert(paramnum < m_numparams); assert(m_param[paramnum].is_mapvar()); m_param[paramnum] = value; }
+		void set_param(int paramnum, parameter const &param) { assert(paramnum < m_numparams); m_param[paramnum] = param; }
 
 		// misc
 		std::string disasm(drcuml_state *drcuml = nullptr) const;
 		u8 input_flags() const;
 		u8 output_flags() const;
 		u8 modified_flags() const;
+		bool param_is_input(int pnum) const;
+		bool param_is_output(int pnum) const;
+		bool param_accepts_immediate(int pnum) const;
+		u8 param_bytes(int pnum) const;
 		void simplify();
 
 		// compile-time opcodes
@@ -12,6 +12,7 @@
 #include "chd_cd.h"
 
 #include "cdrom.h"
+#include "emuopts.h"
 #include "romload.h"
 
 // device type definition
@@ -94,7 +95,11 @@ image_init_result cdrom_image_device::call_load()
 			util::core_file::ptr proxy;
 			err = util::core_file::open_proxy(image_core_file(), proxy);
 			if (!err)
+			{
+				m_self_chd.set_cache_hunks(std::max(machine().options().chd_cache(), 1));
+				m_self_chd.set_read_ahead_hunks(std::max(machine().options().chd_read_ahead(), 0));
 				err = m_self_chd.open(std::move(proxy)); // CDs are never writeable
+			}
 			if (err)
 				goto error;
 			chd = &m_self_chd;
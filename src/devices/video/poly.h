@@ -43,6 +43,7 @@
 
 #define KEEP_POLY_STATISTICS 0
 #define TRACK_POLY_WAITS 0
+#define TRACK_POLY_TIMELINE 0
 
 
 
@@ -53,6 +54,11 @@
 static constexpr u8 POLY_FLAG_NO_WORK_QUEUE       = 0x01;
 static constexpr u8 POLY_FLAG_NO_CLIPPING         = 0x02;
 
+#if TRACK_POLY_TIMELINE
+// numbers the timeline files written by all poly_manager instantiations
+inline std::atomic<int> g_poly_timeline_index(0);
+#endif
+
 
 //**************************************************************************
 //  TYPE DEFINITIONS
@@ -304,6 +310,15 @@ public:
 	// register a poly_array to be reset after a wait
 	void register_poly_array(poly_array_base &array) { m_arrays.push_back(&array); }
 
+	// write the recorded timeline as Chrome trace event JSON; does nothing
+	// unless TRACK_POLY_TIMELINE is enabled
+	void dump_timeline(char const *filename) const;
+
+	// work distribution; by default work is split into 32-scanline buckets,
+	// but a non-zero tile width also splits it into columns, which can't be
+	// used with render_extents
+	void set_tile_binning(int tilewidth, int tileheight, int maxwidth, int maxheight);
+
 	// tiles
 	template<int ParamCount>
 	uint32_t render_tile(rectangle const &cliprect, render_delegate callback, vertex_t const &v1, vertex_t const &v2);
@@ -332,8 +347,8 @@ private:
 	// number of profiling ticks before we consider a wait "long"
 	static constexpr osd_ticks_t POLY_LOG_WAIT_THRESHOLD = 1000;
 
-	static constexpr int SCANLINES_PER_BUCKET = 32;
-	static constexpr int TOTAL_BUCKETS        = (512 / SCANLINES_PER_BUCKET);
+	static constexpr int SCANLINES_PER_BUCKET = 32;     // most scanlines in a single work unit
+	static constexpr int TOTAL_BUCKETS        = (512 / SCANLINES_PER_BUCKET); // default number of bucket rows
 
 	// primitive_info describes a single primitive
 	struct primitive_info
@@ -400,6 +415,18 @@ private:
 		}
 	}
 
+	// chain a unit after the previous one in the same bucket
+	void chain_unit(work_unit &unit, uint32_t unit_index, uint32_t &bucket)
+	{
+		unit.previtem = bucket;
+		bucket = unit_index;
+	}
+
+	// the bucket row for a scanline
+	uint32_t *bucket_row(int32_t scanline) { return &m_unit_bucket[((uint32_t(scanline) / m_tile_height) % m_bucket_rows) * m_bucket_columns]; }
+
+	template<int ParamCount> void bin_unit(work_unit &unit, uint32_t unit_index);
+	template<int ParamCount> static void clip_extent(extent_t &extent, int32_t left, int32_t right);
 	static void *work_item_callback(void *param, int threadid);
 	void presave() { wait("pre-save"); }
 
@@ -413,7 +440,11 @@ private:
 	std::vector<poly_array_base *> m_arrays; // list of arrays we are managing
 
 	// buckets
-	uint32_t m_unit_bucket[TOTAL_BUCKETS]; // buckets for tracking unit usage
+	int m_tile_width;                      // width of each bucket column, or 0 for full-width buckets
+	int m_tile_height;                     // scanlines in each bucket row
+	int m_bucket_rows;                     // number of bucket rows before wrapping
+	int m_bucket_columns;                  // number of bucket columns before wrapping
+	std::vector<uint32_t> m_unit_bucket;   // buckets for tracking unit usage
 
 	// statistics
 	uint32_t m_tiles;                       // number of tiles queued
@@ -454,6 +485,35 @@ private:
 	using waitmap_t = std::unordered_map<std::string, wait_tracker>;
 	waitmap_t m_waitmap;
 #endif
+#if TRACK_POLY_TIMELINE
+	// a span of work on a worker thread, or a wait on the caller; value is
+	// the units processed or the items still queued when the wait began
+	struct timeline_event
+	{
+		osd_ticks_t start;
+		osd_ticks_t end;
+		char const *name;
+		uint32_t value;
+	};
+
+	// one per thread ID, padded so workers don't share cache lines
+	struct alignas(64) thread_timeline
+	{
+		uint32_t units = 0;                    // units rendered
+		uint32_t deferred = 0;                 // units handed to the thread rendering their predecessor
+		osd_ticks_t busy = 0;                  // ticks spent in work callbacks
+		std::vector<timeline_event> events;    // recorded work spans
+	};
+
+	static constexpr size_t MAX_TIMELINE_EVENTS = 100000;
+
+	void record_work(int threadid, osd_ticks_t start, uint32_t units, uint32_t deferred);
+
+	// the waiting thread also runs work items, under thread ID WORK_MAX_THREADS at most
+	osd_ticks_t m_timeline_base;           // ticks when tracking started
+	thread_timeline m_timeline[WORK_MAX_THREADS + 1]; // per-thread work
+	std::vector<timeline_event> m_wait_timeline; // waits on the caller
+#endif
 };
 
 
@@ -464,17 +524,25 @@ private:
 template<typename BaseType, class ObjectType, int MaxParams, u8 Flags>
 poly_manager<BaseType, ObjectType, MaxParams, Flags>::poly_manager(running_machine &machine) :
 	m_queue(nullptr),
+	m_tile_width(0),
+	m_tile_height(SCANLINES_PER_BUCKET),
+	m_bucket_rows(TOTAL_BUCKETS),
+	m_bucket_columns(1),
 	m_tiles(0),
 	m_triangles(0),
 	m_polygons(0),
 	m_pixels(0)
 {
+#if TRACK_POLY_TIMELINE
+	m_timeline_base = osd_ticks();
+#endif
+
 	// create the work queue
 	if (!(Flags & POLY_FLAG_NO_WORK_QUEUE))
 		m_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
 
 	// initialize the buckets to empty
-	std::fill_n(&m_unit_bucket[0], std::size(m_unit_bucket), 0xffffffff);
+	m_unit_bucket.resize(m_bucket_rows * m_bucket_columns, 0xffffffff);
 
 	// register our arrays for reset
 	register_poly_array(m_primitive);
@@ -570,6 +638,36 @@ poly_manager<BaseType, ObjectType, MaxParams, Flags>::~poly_manager()
 		biggest->second.total_cycles = 0;
 	}
 }
+#endif
+#if TRACK_POLY_TIMELINE
+{
+	// idle time is measured against the whole lifetime of the manager
+	osd_ticks_t const span = osd_ticks() - m_timeline_base;
+	double const ms_per_tick = 1000.0 / double(osd_ticks_per_second());
+	osd_ticks_t waited = 0;
+	for (timeline_event const &event : m_wait_timeline)
+		waited += event.end - event.start;
+
+	osd_printf_info("Thread summary (%.1f ms total, %.1f ms waiting in %d waits):\n", double(span) * ms_per_tick, double(waited) * ms_per_tick, int(m_wait_timeline.size()));
+	osd_printf_info("Thread    Units  Deferred   Busy ms   Idle ms  Busy%%\n");
+	osd_printf_info("------  -------  --------  --------  --------  -----\n");
+	for (unsigned threadid = 0; threadid < std::size(m_timeline); threadid++)
+	{
+		thread_timeline const &timeline = m_timeline[threadid];
+		if (timeline.units == 0 && timeline.deferred == 0)
+			continue;
+		osd_printf_info("%6u  %7u  %8u  %8.1f  %8.1f  %4.1f%%\n",
+			threadid,
+			timeline.units,
+			timeline.deferred,
+			double(timeline.busy) * ms_per_tick,
+			double(span - timeline.busy) * ms_per_tick,
+			span ? 100.0 * double(timeline.busy) / double(span) : 0.0);
+	}
+
+	// each manager gets its own file
+	dump_timeline(string_format("polytimeline%d.json", g_poly_timeline_index++).c_str());
+}
 #endif
 
 	// free the work queue
@@ -585,6 +683,12 @@ poly_manager<BaseType, ObjectType, MaxParams, Flags>::~poly_manager()
 template<typename BaseType, class ObjectType, int MaxParams, u8 Flags>
 void *poly_manager<BaseType, ObjectType, MaxParams, Flags>::work_item_callback(void *param, int threadid)
 {
+#if TRACK_POLY_TIMELINE
+	poly_manager &owner = *((work_unit *)param)->primitive->m_owner;
+	osd_ticks_t const start = osd_ticks();
+	uint32_t units = 0, deferred = 0;
+#endif
+
 	while (1)
 	{
 		work_unit &unit = *(work_unit *)param;
@@ -616,13 +720,21 @@ void *poly_manager<BaseType, ObjectType, MaxParams, Flags>::work_item_callback(v
 #endif
 				// if we succeeded, skip out early so we can do other work
 				if (orig_count_next != 0)
+				{
+#if TRACK_POLY_TIMELINE
+					deferred++;
+#endif
 					break;
+				}
 			}
 		}
 
 		// iterate over extents
 		for (int curscan = 0; curscan < count; curscan++)
 			primitive.m_callback(unit.scanline + curscan, unit.extent[curscan], *primitive.m_object, threadid);
+#if TRACK_POLY_TIMELINE
+		units++;
+#endif
 
 		// set our count to 0 and re-fetch the original count value
 		do
@@ -636,10 +748,35 @@ void *poly_manager<BaseType, ObjectType, MaxParams, Flags>::work_item_callback(v
 			break;
 		param = &primitive.m_owner->m_unit.byindex(orig_count_next);
 	}
+
+#if TRACK_POLY_TIMELINE
+	owner.record_work(threadid, start, units, deferred);
+#endif
 	return nullptr;
 }
 
 
+#if TRACK_POLY_TIMELINE
+//-------------------------------------------------
+//  record_work - add a span of work to the
+//  timeline; only the thread with this ID ever
+//  touches its entry
+//-------------------------------------------------
+
+template<typename BaseType, class ObjectType, int MaxParams, u8 Flags>
+void poly_manager<BaseType, ObjectType, MaxParams, Flags>::record_work(int threadid, osd_ticks_t start, uint32_t units, uint32_t deferred)
+{
+	osd_ticks_t const end = osd_ticks();
+	thread_timeline &timeline = m_timeline[threadid];
+	timeline.units += units;
+	timeline.deferred += deferred;
+	timeline.busy += end - start;
+	if (timeline.events.size() < MAX_TIMELINE_EVENTS)
+		timeline.events.push_back(timeline_event{ start, end, units ? "render" : "deferred", units });
+}
+#endif
+
+
 //-------------------------------------------------
 //  wait - stall until all work is complete
 //-------------------------------------------------
@@ -655,6 +792,10 @@ void poly_manager<BaseType, ObjectType, MaxParams, Flags>::wait(char const *debu
 	int items = osd_work_queue_items(m_queue);
 	osd_ticks_t time = get_profile_ticks();
 #endif
+#if TRACK_POLY_TIMELINE
+	uint32_t const depth = (m_queue != nullptr) ? osd_work_queue_items(m_queue) : m_unit.count();
+	osd_ticks_t const start = osd_ticks();
+#endif
 
 	// wait for all pending work items to complete
 	if (m_queue != nullptr)
@@ -668,9 +809,13 @@ void poly_manager<BaseType, ObjectType, MaxParams, Flags>::wait(char const *debu
 #if TRACK_POLY_WAITS
 	m_waitmap[debug_reason].update(items, get_profile_ticks() - time);
 #endif
+#if TRACK_POLY_TIMELINE
+	if (m_wait_timeline.size() < MAX_TIMELINE_EVENTS)
+		m_wait_timeline.push_back(timeline_event{ start, osd_ticks(), debug_reason, depth });
+#endif
 
 	// clear the buckets
-	std::fill_n(&m_unit_bucket[0], std::size(m_unit_bucket), 0xffffffff);
+	std::fill(m_unit_bucket.begin(), m_unit_bucket.end(), 0xffffffff);
 
 	// reset all the poly arrays
 	for (auto array : m_arrays)
@@ -678,6 +823,180 @@ void poly_manager<BaseType, ObjectType, MaxParams, Flags>::wait(char const *debu
 }
 
 
+//-------------------------------------------------
+//  dump_timeline - write the recorded work and
+//  waits in Chrome trace event format, with one
+//  track per worker thread, one for waits and a
+//  counter for the queue depth at each wait
+//-------------------------------------------------
+
+template<typename BaseType, class ObjectType, int MaxParams, u8 Flags>
+void poly_manager<BaseType, ObjectType, MaxParams, Flags>::dump_timeline(char const *filename) const
+{
+#if TRACK_POLY_TIMELINE
+	FILE *const file = fopen(filename, "w");
+	if (file == nullptr)
+		return;
+
+	// timestamps are in microseconds relative to construction
+	double const us_per_tick = 1000000.0 / double(osd_ticks_per_second());
+	auto const timestamp = [this, us_per_tick] (osd_ticks_t ticks) { return double(ticks - m_timeline_base) * us_per_tick; };
+	unsigned const wait_track = std::size(m_timeline);
+	char const *separator = "";
+
+	fprintf(file, "{\"traceEvents\":[");
+	for (unsigned threadid = 0; threadid < std::size(m_timeline); threadid++)
+	{
+		if (m_timeline[threadid].events.empty())
+			continue;
+		fprintf(file, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"poly worker %u\"}}", separator, threadid, threadid);
+		separator = ",";
+		for (timeline_event const &event : m_timeline[threadid].events)
+			fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"units\":%u}}",
+				event.name, threadid, timestamp(event.start), double(event.end - event.start) * us_per_tick, event.value);
+	}
+
+	fprintf(file, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"poly wait\"}}", separator, wait_track);
+	for (timeline_event const &event : m_wait_timeline)
+	{
+		// the reason is caller-supplied, so escape anything JSON cares about
+		std::string reason;
+		for (char const *c = event.name; *c != 0; c++)
+		{
+			if (*c == '"' || *c == '\\')
+				reason += '\\';
+			if (uint8_t(*c) >= 0x20)
+				reason += *c;
+		}
+		fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"queued\":%u}}",
+			reason.c_str(), wait_track, timestamp(event.start), double(event.end - event.start) * us_per_tick, event.value);
+		fprintf(file, ",\n{\"name\":\"queue depth\",\"ph\":\"C\",\"pid\":0,\"ts\":%.3f,\"args\":{\"items\":%u}}",
+			timestamp(event.start), event.value);
+		fprintf(file, ",\n{\"name\":\"queue depth\",\"ph\":\"C\",\"pid\":0,\"ts\":%.3f,\"args\":{\"items\":0}}",
+			timestamp(event.end));
+	}
+	fprintf(file, "\n]}\n");
+	fclose(file);
+#endif
+}
+
+
+//-------------------------------------------------
+//  set_tile_binning - configure how work is split
+//  between buckets; units in different buckets
+//  never touch the same pixels, so they can run
+//  concurrently, while units in the same bucket
+//  run in the order they were queued; columns
+//  are only for renderers that draw primitives
+//  whose extents poly_manager computes, as the
+//  extents are clipped to each column
+//-------------------------------------------------
+
+template<typename BaseType, class ObjectType, int MaxParams, u8 Flags>
+void poly_manager<BaseType, ObjectType, MaxParams, Flags>::set_tile_binning(int tilewidth, int tileheight, int maxwidth, int maxheight)
+{
+	if (tilewidth < 0 || tileheight < 1 || tileheight > SCANLINES_PER_BUCKET || maxwidth < 1 || maxheight < 1)
+		throw emu_fatalerror("poly_manager: invalid tile binning %dx%d for %dx%d", tilewidth, tileheight, maxwidth, maxheight);
+
+	// buckets can't change while work is outstanding
+	wait("tile binning");
+
+	// size the buckets to cover the largest target; anything larger wraps,
+	// which costs some concurrency but is still correct
+	m_tile_width = tilewidth;
+	m_tile_height = tileheight;
+	m_bucket_rows = (maxheight + tileheight - 1) / tileheight;
+	m_bucket_columns = (tilewidth != 0) ? ((maxwidth + tilewidth - 1) / tilewidth) : 1;
+	m_unit_bucket.assign(m_bucket_rows * m_bucket_columns, 0xffffffff);
+}
+
+
+//-------------------------------------------------
+//  bin_unit - chain a freshly filled work unit
+//  into its bucket; when binning by columns, the
+//  unit is first split into one unit per column
+//  its extents cover
+//-------------------------------------------------
+
+template<typename BaseType, class ObjectType, int MaxParams, u8 Flags>
+template<int ParamCount>
+void poly_manager<BaseType, ObjectType, MaxParams, Flags>::bin_unit(work_unit &unit, uint32_t unit_index)
+{
+	uint32_t *const buckets = bucket_row(unit.scanline);
+	int const count = unit.count_next;
+
+	// find the columns covered by the extents; reversed extents cover the same pixels
+	int32_t firstcol = 0, lastcol = 0;
+	if (m_tile_width != 0)
+	{
+		int32_t minx = INT_MAX, maxx = INT_MIN;
+		for (int extnum = 0; extnum < count; extnum++)
+		{
+			int32_t const left = std::min(unit.extent[extnum].startx, unit.extent[extnum].stopx);
+			int32_t const right = std::max(unit.extent[extnum].startx, unit.extent[extnum].stopx);
+			if (left < right)
+			{
+				minx = std::min(minx, left);
+				maxx = std::max(maxx, right);
+			}
+		}
+		if (minx < maxx)
+		{
+			firstcol = std::max(minx, 0) / m_tile_width;
+			lastcol = std::max(maxx - 1, 0) / m_tile_width;
+		}
+	}
+
+	// add a unit for each column after the first; the outermost columns take
+	// anything beyond them, so nothing is lost to clipping
+	for (int32_t col = lastcol; col > firstcol; col--)
+	{
+		uint32_t const split_index = m_unit.count();
+		work_unit &split = m_unit.next();
+		split.primitive = unit.primitive;
+		split.count_next = count;
+		split.scanline = unit.scanline;
+		for (int extnum = 0; extnum < count; extnum++)
+		{
+			split.extent[extnum] = unit.extent[extnum];
+			clip_extent<ParamCount>(split.extent[extnum], col * m_tile_width, (col == lastcol) ? INT_MAX : (col + 1) * m_tile_width);
+		}
+		chain_unit(split, split_index, buckets[col % m_bucket_columns]);
+	}
+
+	// the original unit keeps the first column
+	if (lastcol > firstcol)
+		for (int extnum = 0; extnum < count; extnum++)
+			clip_extent<ParamCount>(unit.extent[extnum], INT_MIN, (firstcol + 1) * m_tile_width);
+	chain_unit(unit, unit_index, buckets[firstcol % m_bucket_columns]);
+}
+
+
+//-------------------------------------------------
+//  clip_extent - clip an extent to a column,
+//  advancing the parameters to the new start as
+//  for cliprect clipping of polygons
+//-------------------------------------------------
+
+template<typename BaseType, class ObjectType, int MaxParams, u8 Flags>
+template<int ParamCount>
+void poly_manager<BaseType, ObjectType, MaxParams, Flags>::clip_extent(extent_t &extent, int32_t left, int32_t right)
+{
+	int32_t istartx = extent.startx, istopx = extent.stopx;
+	if (istartx < left)
+	{
+		for (int paramnum = 0; paramnum < ParamCount; paramnum++)
+			extent.param[paramnum].start += (left - istartx) * extent.param[paramnum].dpdx;
+		istartx = left;
+	}
+	istopx = std::min(istopx, right);
+	if (istartx >= istopx)
+		istartx = istopx = 0;
+	extent.startx = istartx;
+	extent.stopx = istopx;
+}
+
+
 //-------------------------------------------------
 //  render_tile - render a tile
 //-------------------------------------------------
@@ -754,19 +1073,16 @@ uint32_t poly_manager<BaseType, ObjectType, MaxParams, Flags>::render_tile(recta
 	int32_t scaninc = 1;
 	for (int32_t curscan = v1yclip; curscan < v2yclip; curscan += scaninc)
 	{
-		uint32_t bucketnum = (uint32_t(curscan) / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
 		uint32_t unit_index = m_unit.count();
 		work_unit &unit = m_unit.next();
 
 		// determine how much to advance to hit the next bucket
-		scaninc = SCANLINES_PER_BUCKET - uint32_t(curscan) % SCANLINES_PER_BUCKET;
+		scaninc = m_tile_height - uint32_t(curscan) % m_tile_height;
 
 		// fill in the work unit basics
 		unit.primitive = &primitive;
 		unit.count_next = std::min(v2yclip - curscan, scaninc);
 		unit.scanline = curscan;
-		unit.previtem = m_unit_bucket[bucketnum];
-		m_unit_bucket[bucketnum] = unit_index;
 
 		// iterate over extents
 		for (int extnum = 0; extnum < unit.count_next; extnum++)
@@ -789,6 +1105,9 @@ uint32_t poly_manager<BaseType, ObjectType, MaxParams, Flags>::render_tile(recta
 				}
 			}
 		}
+
+		// chain the unit into the bucket(s) it touches
+		bin_unit<ParamCount>(unit, unit_index);
 	}
 
 	// enqueue the work items
@@ -895,19 +1214,16 @@ uint32_t poly_manager<BaseType, ObjectType, MaxParams, Flags>::render_triangle(c
 	int32_t scaninc = 1;
 	for (int32_t curscan = v1yclip; curscan < v3yclip; curscan += scaninc)
 	{
-		uint32_t bucketnum = (uint32_t(curscan) / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
 		uint32_t unit_index = m_unit.count();
 		work_unit &unit = m_unit.next();
 
 		// determine how much to advance to hit the next bucket
-		scaninc = SCANLINES_PER_BUCKET - uint32_t(curscan) % SCANLINES_PER_BUCKET;
+		scaninc = m_tile_height - uint32_t(curscan) % m_tile_height;
 
 		// fill in the work unit basics
 		unit.primitive = &primitive;
 		unit.count_next = std::min(v3yclip - curscan, scaninc);
 		unit.scanline = curscan;
-		unit.previtem = m_unit_bucket[bucketnum];
-		m_unit_bucket[bucketnum] = unit_index;
 
 		// iterate over extents
 		for (int extnum = 0; extnum < unit.count_next; extnum++)
@@ -952,6 +1268,9 @@ uint32_t poly_manager<BaseType, ObjectType, MaxParams, Flags>::render_triangle(c
 				extent.param[paramnum].dpdx = param_dpdx[paramnum];
 			}
 		}
+
+		// chain the unit into the bucket(s) it touches
+		bin_unit<ParamCount>(unit, unit_index);
 	}
 
 	// enqueue the work items
@@ -1007,6 +1326,13 @@ template<typename BaseType, class ObjectType, int MaxParams, u8 Flags>
 template<int ParamCount>
 uint32_t poly_manager<BaseType, ObjectType, MaxParams, Flags>::render_extents(rectangle const &cliprect, render_delegate callback, int startscanline, int numscanlines, extent_t const *extents)
 {
+	// the callback may rely on the whole extent the caller supplied (n64
+	// keeps the unscissored span in userdata), so these can't be split into
+	// columns, and a unit can only follow one other, so it can't wait for
+	// every column in its row either
+	if (m_tile_width != 0)
+		throw emu_fatalerror("poly_manager: render_extents can't be used with column binning");
+
 	// clip coordinates
 	int32_t v1yclip = startscanline;
 	int32_t v3yclip = startscanline + numscanlines;
@@ -1027,19 +1353,16 @@ uint32_t poly_manager<BaseType, ObjectType, MaxParams, Flags>::render_extents(re
 	int32_t scaninc = 1;
 	for (int32_t curscan = v1yclip; curscan < v3yclip; curscan += scaninc)
 	{
-		uint32_t bucketnum = (uint32_t(curscan) / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
 		uint32_t unit_index = m_unit.count();
 		work_unit &unit = m_unit.next();
 
 		// determine how much to advance to hit the next bucket
-		scaninc = SCANLINES_PER_BUCKET - uint32_t(curscan) % SCANLINES_PER_BUCKET;
+		scaninc = m_tile_height - uint32_t(curscan) % m_tile_height;
 
 		// fill in the work unit basics
 		unit.primitive = &primitive;
 		unit.count_next = std::min(v3yclip - curscan, scaninc);
 		unit.scanline = curscan;
-		unit.previtem = m_unit_bucket[bucketnum];
-		m_unit_bucket[bucketnum] = unit_index;
 
 		// iterate over extents
 		for (int extnum = 0; extnum < unit.count_next; extnum++)
@@ -1074,6 +1397,9 @@ uint32_t poly_manager<BaseType, ObjectType, MaxParams, Flags>::render_extents(re
 			else if (istopx < istartx)
 				pixels += istartx - istopx;
 		}
+
+		// chain the unit into its bucket row; extents are never split
+		chain_unit(unit, unit_index, *bucket_row(curscan));
 	}
 
 	// enqueue the work items
@@ -1201,19 +1527,16 @@ uint32_t poly_manager<BaseType, ObjectType, MaxParams, Flags>::render_polygon(re
 	int32_t scaninc = 1;
 	for (int32_t curscan = minyclip; curscan < maxyclip; curscan += scaninc)
 	{
-		uint32_t bucketnum = (uint32_t(curscan) / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
 		uint32_t unit_index = m_unit.count();
 		work_unit &unit = m_unit.next();
 
 		// determine how much to advance to hit the next bucket
-		scaninc = SCANLINES_PER_BUCKET - uint32_t(curscan) % SCANLINES_PER_BUCKET;
+		scaninc = m_tile_height - uint32_t(curscan) % m_tile_height;
 
 		// fill in the work unit basics
 		unit.primitive = &primitive;
 		unit.count_next = std::min(maxyclip - curscan, scaninc);
 		unit.scanline = curscan;
-		unit.previtem = m_unit_bucket[bucketnum];
-		m_unit_bucket[bucketnum] = unit_index;
 
 		// iterate over extents
 		for (int extnum = 0; extnum < unit.count_next; extnum++)
@@ -1271,6 +1594,9 @@ uint32_t poly_manager<BaseType, ObjectType, MaxParams, Flags>::render_polygon(re
 			extent.stopx = istopx;
 			pixels += istopx - istartx;
 		}
+
+		// chain the unit into the bucket(s) it touches
+		bin_unit<ParamCount>(unit, unit_index);
 	}
 
 	// enqueue the work items
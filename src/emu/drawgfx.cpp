@@ -11,6 +11,11 @@
 #include "emu.h"
 #include "drawgfxt.ipp"
 
+#include "emuopts.h"
+
+#include <algorithm>
+#include <type_traits>
+
 
 /***************************************************************************
     INLINE FUNCTIONS
@@ -94,6 +99,7 @@ gfx_element::gfx_element(device_palette_interface *palette, u8 *base, u16 width,
 		m_srcdata(base),
 		m_dirtyseq(1),
 		m_gfxdata(base),
+		m_predecoded(false),
 		m_layout_is_raw(true),
 		m_layout_planes(0),
 		m_layout_xormask(0),
@@ -119,6 +125,7 @@ gfx_element::gfx_element(device_palette_interface *palette, const gfx_layout &gl
 		m_srcdata(nullptr),
 		m_dirtyseq(1),
 		m_gfxdata(nullptr),
+		m_predecoded(false),
 		m_layout_is_raw(false),
 		m_layout_planes(0),
 		m_layout_xormask(xormask),
@@ -183,12 +190,11 @@ void gfx_element::set_layout(const gfx_layout &gl, const u8 *srcdata)
 			m_layout_xoffset[x] = gl.xoffs(x);
 
 		// we get to pick our own modulos
-		m_line_modulo = m_origwidth;
+		m_line_modulo = m_predecoded ? ((m_origwidth + PREDECODED_ALIGN - 1) & ~(PREDECODED_ALIGN - 1)) : m_origwidth;
 		m_char_modulo = m_line_modulo * m_origheight;
 
 		// allocate memory for the data
-		m_gfxdata_allocated.resize(m_total_elements * m_char_modulo);
-		m_gfxdata = &m_gfxdata_allocated[0];
+		allocate_gfxdata();
 	}
 
 	// mark everything dirty
@@ -200,6 +206,11 @@ void gfx_element::set_layout(const gfx_layout &gl, const u8 *srcdata)
 		m_pen_usage.resize(m_total_elements);
 	else
 		m_pen_usage.clear();
+
+	// and per-row pen usage for pre-decoded elements
+	m_row_pen_usage.clear();
+	if (m_predecoded && !m_layout_is_raw && (m_color_depth <= 32))
+		m_row_pen_usage.resize(m_total_elements * m_origheight);
 }
 
 
@@ -250,6 +261,8 @@ void gfx_element::set_source_and_total(const u8 *source, u32 total)
 	// allocate a pen usage array for entries with 32 pens or less
 	if (m_color_depth <= 32)
 		m_pen_usage.resize(m_total_elements);
+	if (has_row_pen_usage())
+		m_row_pen_usage.resize(m_total_elements * m_origheight);
 
 	if (m_layout_is_raw)
 	{
@@ -258,8 +271,7 @@ void gfx_element::set_source_and_total(const u8 *source, u32 total)
 	else
 	{
 		// allocate memory for the data
-		m_gfxdata_allocated.resize(m_total_elements * m_char_modulo);
-		m_gfxdata = &m_gfxdata_allocated[0];
+		allocate_gfxdata();
 	}
 }
 
@@ -282,6 +294,56 @@ void gfx_element::set_source_clip(u32 xoffs, u32 width, u32 yoffs, u32 height)
 }
 
 
+//-------------------------------------------------
+//  set_predecoded - decode elements into rows
+//  that start on aligned boundaries, and track
+//  which pens each row uses if there are 32 pens
+//  or less, so transparent draws can use the
+//  vector row kernels, skip empty rows and draw
+//  solid rows without testing pens; raw layouts
+//  still draw straight from their source data,
+//  with the row kernels but no row pen usage;
+//  rows are padded to a multiple of 16 pixels,
+//  which tilemaps don't expect
+//-------------------------------------------------
+
+void gfx_element::set_predecoded(bool enable)
+{
+	if (enable == m_predecoded)
+		return;
+	m_predecoded = enable;
+	if (m_layout_is_raw)
+		return;
+
+	// pick new modulos and decode everything again into the new layout
+	m_line_modulo = enable ? ((m_origwidth + PREDECODED_ALIGN - 1) & ~(PREDECODED_ALIGN - 1)) : m_origwidth;
+	m_char_modulo = m_line_modulo * m_origheight;
+	allocate_gfxdata();
+
+	m_row_pen_usage.clear();
+	if (enable && (m_color_depth <= 32))
+		m_row_pen_usage.resize(m_total_elements * m_origheight);
+	if (!m_dirty.empty())
+		mark_all_dirty();
+}
+
+
+//-------------------------------------------------
+//  allocate_gfxdata - allocate memory for the
+//  decoded data, aligning it for pre-decoded
+//  elements
+//-------------------------------------------------
+
+void gfx_element::allocate_gfxdata()
+{
+	u32 const slack = m_predecoded ? (PREDECODED_ALIGN - 1) : 0;
+	m_gfxdata_allocated.resize(m_total_elements * m_char_modulo + slack);
+	m_gfxdata = &m_gfxdata_allocated[0];
+	if (m_predecoded)
+		m_gfxdata += -uintptr_t(m_gfxdata) & (PREDECODED_ALIGN - 1);
+}
+
+
 //-------------------------------------------------
 //  decode - decode a single character
 //-------------------------------------------------
@@ -322,11 +384,16 @@ void gfx_element::decode(u32 code)
 	{
 		// iterate over data, creating a bitmask of live pens
 		const u8 *dp = m_gfxdata + code * m_char_modulo;
+		u32 *rowusage = has_row_pen_usage() ? &m_row_pen_usage[code * m_origheight] : nullptr;
 		u32 usage = 0;
 		for (int y = 0; y < m_origheight; y++)
 		{
+			u32 row = 0;
 			for (int x = 0; x < m_origwidth; x++)
-				usage |= 1 << dp[x];
+				row |= 1 << dp[x];
+			if (rowusage)
+				rowusage[y] = row;
+			usage |= row;
 			dp += m_line_modulo;
 		}
 
@@ -395,7 +462,12 @@ void gfx_element::transpen(bitmap_ind16 &dest, const rectangle &cliprect,
 
 	// render
 	color = colorbase() + granularity() * (color % colors());
-	drawgfx_core(dest, cliprect, code, flipx, flipy, destx, desty, [trans_pen, color](u16 &destp, const u8 &srcp) { PIXEL_OP_REBASE_TRANSPEN(destp, srcp); });
+	if (has_predecoded())
+		drawgfx_rows_core(dest, cliprect, code, flipx, flipy, destx, desty, (trans_pen < 32) ? (1 << trans_pen) : 0,
+				[color](u16 *destp, const u8 *srcp, s32 count, bool flip) { drawgfx_scanline<>::opaque_ind16(destp, srcp, count, flip, color); },
+				[trans_pen, color](u16 *destp, const u8 *srcp, s32 count, bool flip) { drawgfx_scanline<>::transpen_ind16(destp, srcp, count, flip, color, trans_pen); });
+	else
+		drawgfx_core(dest, cliprect, code, flipx, flipy, destx, desty, [trans_pen, color](u16 &destp, const u8 &srcp) { PIXEL_OP_REBASE_TRANSPEN(destp, srcp); });
 }
 
 void gfx_element::transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -422,7 +494,12 @@ void gfx_element::transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
 
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
-	drawgfx_core(dest, cliprect, code, flipx, flipy, destx, desty, [trans_pen, paldata](u32 &destp, const u8 &srcp) { PIXEL_OP_REMAP_TRANSPEN(destp, srcp); });
+	if (has_predecoded())
+		drawgfx_rows_core(dest, cliprect, code, flipx, flipy, destx, desty, (trans_pen < 32) ? (1 << trans_pen) : 0,
+				[paldata](u32 *destp, const u8 *srcp, s32 count, bool flip) { drawgfx_scanline<>::opaque_rgb32(destp, srcp, count, flip, paldata); },
+				[trans_pen, paldata](u32 *destp, const u8 *srcp, s32 count, bool flip) { drawgfx_scanline<>::transpen_rgb32(destp, srcp, count, flip, paldata, trans_pen); });
+	else
+		drawgfx_core(dest, cliprect, code, flipx, flipy, destx, desty, [trans_pen, paldata](u32 &destp, const u8 &srcp) { PIXEL_OP_REMAP_TRANSPEN(destp, srcp); });
 }
 
 
@@ -489,7 +566,12 @@ void gfx_element::transmask(bitmap_ind16 &dest, const rectangle &cliprect,
 
 	// render
 	color = colorbase() + granularity() * (color % colors());
-	drawgfx_core(dest, cliprect, code, flipx, flipy, destx, desty, [trans_mask, color](u16 &destp, const u8 &srcp) { PIXEL_OP_REBASE_TRANSMASK(destp, srcp); });
+	if (has_predecoded())
+		drawgfx_rows_core(dest, cliprect, code, flipx, flipy, destx, desty, trans_mask,
+				[color](u16 *destp, const u8 *srcp, s32 count, bool flip) { drawgfx_scanline<>::opaque_ind16(destp, srcp, count, flip, color); },
+				[trans_mask, color](u16 *destp, const u8 *srcp, s32 count, bool flip) { drawgfx_scanline<>::pixels(destp, srcp, count, flip, [trans_mask, color](u16 &d, const u8 &s) { PIXEL_OP_REBASE_TRANSMASK(d, s); }); });
+	else
+		drawgfx_core(dest, cliprect, code, flipx, flipy, destx, desty, [trans_mask, color](u16 &destp, const u8 &srcp) { PIXEL_OP_REBASE_TRANSMASK(destp, srcp); });
 }
 
 void gfx_element::transmask(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -516,7 +598,12 @@ void gfx_element::transmask(bitmap_rgb32 &dest, const rectangle &cliprect,
 
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
-	drawgfx_core(dest, cliprect, code, flipx, flipy, destx, desty, [trans_mask, paldata](u32 &destp, const u8 &srcp) { PIXEL_OP_REMAP_TRANSMASK(destp, srcp); });
+	if (has_predecoded())
+		drawgfx_rows_core(dest, cliprect, code, flipx, flipy, destx, desty, trans_mask,
+				[paldata](u32 *destp, const u8 *srcp, s32 count, bool flip) { drawgfx_scanline<>::opaque_rgb32(destp, srcp, count, flip, paldata); },
+				[trans_mask, paldata](u32 *destp, const u8 *srcp, s32 count, bool flip) { drawgfx_scanline<>::pixels(destp, srcp, count, flip, [trans_mask, paldata](u32 &d, const u8 &s) { PIXEL_OP_REMAP_TRANSMASK(d, s); }); });
+	else
+		drawgfx_core(dest, cliprect, code, flipx, flipy, destx, desty, [trans_mask, paldata](u32 &destp, const u8 &srcp) { PIXEL_OP_REMAP_TRANSMASK(destp, srcp); });
 }
 
 
@@ -1665,6 +1752,228 @@ void gfx_element::alphatable(bitmap_rgb32 &dest, const rectangle &cliprect,
 }
 
 
+/***************************************************************************
+    COMMAND LISTS
+***************************************************************************/
+
+namespace {
+
+constexpr int MIN_BAND_HEIGHT = 16;             // don't split areas into bands shorter than this
+constexpr int MAX_BANDS = 64;                   // most bands a list is split into
+
+} // anonymous namespace
+
+
+/*-------------------------------------------------
+    gfx_command_list - constructor
+-------------------------------------------------*/
+
+gfx_command_list::gfx_command_list(running_machine &machine)
+	: gfx_command_list(machine.options().sprite_threads())
+{
+}
+
+gfx_command_list::gfx_command_list(int bands)
+	: m_work_queue(nullptr)
+	, m_bands(std::clamp(bands, 1, MAX_BANDS))
+	, m_needs_rgb(false)
+{
+	if (m_bands > 1)
+		m_work_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+}
+
+
+/*-------------------------------------------------
+    ~gfx_command_list - destructor
+-------------------------------------------------*/
+
+gfx_command_list::~gfx_command_list()
+{
+	if (m_work_queue)
+		osd_work_queue_free(m_work_queue);
+}
+
+
+/*-------------------------------------------------
+    add - record a command, noting the rows it
+    can touch so bands can skip it quickly
+-------------------------------------------------*/
+
+gfx_command_list::gfx_command &gfx_command_list::add(u8 op, gfx_element &gfx, u32 code, u32 color, int flipx, int flipy, s32 destx, s32 desty, u32 pmask)
+{
+	gfx_command &cmd = m_commands.emplace_back();
+	cmd.gfx = &gfx;
+	cmd.code = code;
+	cmd.color = color;
+	cmd.destx = destx;
+	cmd.desty = desty;
+	cmd.scalex = cmd.scaley = 0x10000;
+	cmd.pmask = pmask;
+	cmd.trans = 0;
+	cmd.top = desty;
+	cmd.bottom = desty + gfx.height() - 1;
+	cmd.op = op;
+	cmd.flipx = flipx ? 1 : 0;
+	cmd.flipy = flipy ? 1 : 0;
+	cmd.alpha = 0xff;
+	return cmd;
+}
+
+gfx_command_list::gfx_command &gfx_command_list::add_zoom(u8 op, gfx_element &gfx, u32 code, u32 color, int flipx, int flipy, s32 destx, s32 desty, u32 scalex, u32 scaley, u32 pmask)
+{
+	gfx_command &cmd = add(op | OP_ZOOM, gfx, code, color, flipx, flipy, destx, desty, pmask);
+	cmd.scalex = scalex;
+	cmd.scaley = scaley;
+
+	// same rounding as drawgfxzoom_core, but never smaller than the unscaled element
+	cmd.bottom = desty + (std::max<s32>)(gfx.height(), (scaley * gfx.height() + 0x8000) >> 16) - 1;
+	return cmd;
+}
+
+
+/*-------------------------------------------------
+    execute - draw all recorded commands into a
+    bitmap
+-------------------------------------------------*/
+
+void gfx_command_list::execute(bitmap_ind16 &dest, const rectangle &cliprect, bitmap_ind8 &priority)
+{
+	if (m_needs_rgb)
+		throw emu_fatalerror("gfx_command_list: alpha blended commands require an RGB32 bitmap");
+	execute_bands(dest, cliprect, priority);
+}
+
+void gfx_command_list::execute(bitmap_rgb32 &dest, const rectangle &cliprect, bitmap_ind8 &priority)
+{
+	execute_bands(dest, cliprect, priority);
+}
+
+
+/*-------------------------------------------------
+    execute_bands - split the cliprect into
+    horizontal bands drawn concurrently; each
+    pixel sees the same commands in the same
+    order as when drawing them immediately
+-------------------------------------------------*/
+
+template <typename BitmapType>
+void gfx_command_list::execute_bands(BitmapType &dest, const rectangle &cliprect, bitmap_ind8 &priority)
+{
+	if (m_commands.empty() || cliprect.empty())
+		return;
+
+	// decode every element up front, so bands only ever read gfx data
+	for (gfx_command const &cmd : m_commands)
+		cmd.gfx->get_data(cmd.code % cmd.gfx->elements());
+
+	// don't bother splitting small areas
+	int const bands = std::min(m_bands, cliprect.height() / MIN_BAND_HEIGHT);
+	if ((bands > 1) && m_work_queue)
+	{
+		// divide the rows evenly between the bands
+		band_data<BitmapType> band[MAX_BANDS];
+		for (int index = 0; index < bands; index++)
+		{
+			band[index].list = this;
+			band[index].dest = &dest;
+			band[index].priority = &priority;
+			band[index].cliprect = cliprect;
+			band[index].cliprect.sety(cliprect.top() + cliprect.height() * index / bands, cliprect.top() + cliprect.height() * (index + 1) / bands - 1);
+		}
+
+		// queue all but the first band, and draw that one ourselves while we wait
+		osd_work_item_queue_multiple(m_work_queue, draw_band_callback<BitmapType>, bands - 1, &band[1], sizeof(band[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		draw_band_callback<BitmapType>(&band[0], 0);
+
+		// the bands live on this stack frame, so don't leave until they're all done
+		while (!osd_work_queue_wait(m_work_queue, osd_ticks_per_second()))
+		{
+		}
+	}
+	else
+	{
+		draw_band(dest, cliprect, priority);
+	}
+}
+
+
+/*-------------------------------------------------
+    draw_band - draw every command that touches
+    the rows of the cliprect, clipped to it
+-------------------------------------------------*/
+
+template <typename BitmapType>
+void gfx_command_list::draw_band(BitmapType &dest, const rectangle &cliprect, bitmap_ind8 &priority) const
+{
+	for (gfx_command const &cmd : m_commands)
+		if ((cmd.bottom >= cliprect.top()) && (cmd.top <= cliprect.bottom()))
+			draw_command(cmd, dest, cliprect, priority);
+}
+
+
+/*-------------------------------------------------
+    draw_command - replay a single command using
+    the matching gfx_element method
+-------------------------------------------------*/
+
+template <typename BitmapType>
+void gfx_command_list::draw_command(const gfx_command &cmd, BitmapType &dest, const rectangle &cliprect, bitmap_ind8 &priority)
+{
+	gfx_element &gfx = *cmd.gfx;
+	switch (cmd.op)
+	{
+	case OP_OPAQUE:                         gfx.opaque(dest, cliprect, cmd.code, cmd.color, cmd.flipx, cmd.flipy, cmd.destx, cmd.desty); break;
+	case OP_TRANSPEN:                       gfx.transpen(dest, cliprect, cmd.code, cmd.color, cmd.flipx, cmd.flipy, cmd.destx, cmd.desty, cmd.trans); break;
+	case OP_TRANSPEN_RAW:                   gfx.transpen_raw(dest, cliprect, cmd.code, cmd.color, cmd.flipx, cmd.flipy, cmd.destx, cmd.desty, cmd.trans); break;
+	case OP_TRANSMASK:                      gfx.transmask(dest, cliprect, cmd.code, cmd.color, cmd.flipx, cmd.flipy, cmd.destx, cmd.desty, cmd.trans); break;
+
+	case OP_OPAQUE | OP_ZOOM:               gfx.zoom_opaque(dest, cliprect, cmd.code, cmd.color, cmd.flipx, cmd.flipy, cmd.destx, cmd.desty, cmd.scalex, cmd.scaley); break;
+	case OP_TRANSPEN | OP_ZOOM:             gfx.zoom_transpen(dest, cliprect, cmd.code, cmd.color, cmd.flipx, cmd.flipy, cmd.destx, cmd.desty, cmd.scalex, cmd.scaley, cmd.trans); break;
+	case OP_TRANSPEN_RAW | OP_ZOOM:         gfx.zoom_transpen_raw(dest, cliprect, cmd.code, cmd.color, cmd.flipx, cmd.flipy, cmd.destx, cmd.desty, cmd.scalex, cmd.scaley, cmd.trans); break;
+	case OP_TRANSMASK | OP_ZOOM:            gfx.zoom_transmask(dest, cliprect, cmd.code, cmd.color, cmd.flipx, cmd.flipy, cmd.destx, cmd.desty, cmd.scalex, cmd.scaley, cmd.trans); break;
+
+	case OP_OPAQUE | OP_PRIO:               gfx.prio_opaque(dest, cliprect, cmd.code, cmd.color, cmd.flipx, cmd.flipy, cmd.destx, cmd.desty, priority, cmd.pmask); break;
+	case OP_TRANSPEN | OP_PRIO:             gfx.prio_transpen(dest, cliprect, cmd.code, cmd.color, cmd.flipx, cmd.flipy, cmd.destx, cmd.desty, priority, cmd.pmask, cmd.trans); break;
+	case OP_TRANSPEN_RAW | OP_PRIO:         gfx.prio_transpen_raw(dest, cliprect, cmd.code, cmd.color, cmd.flipx, cmd.flipy, cmd.destx, cmd.desty, priority, cmd.pmask, cmd.trans); break;
+	case OP_TRANSMASK | OP_PRIO:            gfx.prio_transmask(dest, cliprect, cmd.code, cmd.color, cmd.flipx, cmd.flipy, cmd.destx, cmd.desty, priority, cmd.pmask, cmd.trans); break;
+
+	case OP_OPAQUE | OP_ZOOM | OP_PRIO:     gfx.prio_zoom_opaque(dest, cliprect, cmd.code, cmd.color, cmd.flipx, cmd.flipy, cmd.destx, cmd.desty, cmd.scalex, cmd.scaley, priority, cmd.pmask); break;
+	case OP_TRANSPEN | OP_ZOOM | OP_PRIO:   gfx.prio_zoom_transpen(dest, cliprect, cmd.code, cmd.color, cmd.flipx, cmd.flipy, cmd.destx, cmd.desty, cmd.scalex, cmd.scaley, priority, cmd.pmask, cmd.trans); break;
+	case OP_TRANSPEN_RAW | OP_ZOOM | OP_PRIO: gfx.prio_zoom_transpen_raw(dest, cliprect, cmd.code, cmd.color, cmd.flipx, cmd.flipy, cmd.destx, cmd.desty, cmd.scalex, cmd.scaley, priority, cmd.pmask, cmd.trans); break;
+	case OP_TRANSMASK | OP_ZOOM | OP_PRIO:  gfx.prio_zoom_transmask(dest, cliprect, cmd.code, cmd.color, cmd.flipx, cmd.flipy, cmd.destx, cmd.desty, cmd.scalex, cmd.scaley, priority, cmd.pmask, cmd.trans); break;
+
+	default:
+		// alpha blending only exists for RGB32 bitmaps; execute() rejects it for anything else
+		if constexpr (std::is_same_v<BitmapType, bitmap_rgb32>)
+		{
+			switch (cmd.op)
+			{
+			case OP_ALPHA:                      gfx.alpha(dest, cliprect, cmd.code, cmd.color, cmd.flipx, cmd.flipy, cmd.destx, cmd.desty, cmd.trans, cmd.alpha); break;
+			case OP_ALPHA | OP_ZOOM:            gfx.zoom_alpha(dest, cliprect, cmd.code, cmd.color, cmd.flipx, cmd.flipy, cmd.destx, cmd.desty, cmd.scalex, cmd.scaley, cmd.trans, cmd.alpha); break;
+			case OP_ALPHA | OP_PRIO:            gfx.prio_alpha(dest, cliprect, cmd.code, cmd.color, cmd.flipx, cmd.flipy, cmd.destx, cmd.desty, priority, cmd.pmask, cmd.trans, cmd.alpha); break;
+			case OP_ALPHA | OP_ZOOM | OP_PRIO:  gfx.prio_zoom_alpha(dest, cliprect, cmd.code, cmd.color, cmd.flipx, cmd.flipy, cmd.destx, cmd.desty, cmd.scalex, cmd.scaley, priority, cmd.pmask, cmd.trans, cmd.alpha); break;
+			}
+		}
+		break;
+	}
+}
+
+
+/*-------------------------------------------------
+    draw_band_callback - work item callback for
+    drawing a single band
+-------------------------------------------------*/
+
+template <typename BitmapType>
+void *gfx_command_list::draw_band_callback(void *param, int threadid)
+{
+	band_data<BitmapType> const &band = *reinterpret_cast<band_data<BitmapType> const *>(param);
+	band.list->draw_band(*band.dest, band.cliprect, *band.priority);
+	return nullptr;
+}
+
+
+
 /***************************************************************************
     DRAW_SCANLINE IMPLEMENTATIONS
 ***************************************************************************/
@@ -108,6 +108,27 @@
     (whether that be a field in the sprite attributes or simply their
     order in sprite RAM) before drawing.
 
+    Drivers that draw many sprites per frame can record them into a
+    gfx_command_list instead of drawing them immediately. The list
+    methods take the same arguments as the gfx_element methods, minus
+    the bitmaps and cliprect, which are supplied when the list is
+    executed:
+
+        m_sprites->reset();
+        for (each sprite, in drawing order)
+            m_sprites->prio_transpen(*m_gfxdecode->gfx(1),
+                    code, color,
+                    flipx, flipy,
+                    sx, sy,
+                    pmask,
+                    trans_pen);
+        m_sprites->execute(bitmap, cliprect, screen.priority());
+
+    With the spritethreads option above 1 the list is drawn in
+    horizontal bands on worker threads; otherwise it is drawn in order
+    on the calling thread. Either way the result is the same as
+    drawing each sprite immediately.
+
 
 *********************************************************************/
 
@@ -166,6 +187,8 @@ public:
 	u32 colors() const { return m_total_colors; }
 	u32 rowbytes() const { return m_line_modulo; }
 	bool has_pen_usage() const { return !m_pen_usage.empty(); }
+	bool has_row_pen_usage() const { return !m_row_pen_usage.empty(); }
+	bool has_predecoded() const { return m_predecoded; }
 	bool has_palette() const { return m_palette; }
 
 	// used by tilemaps
@@ -182,6 +205,7 @@ public:
 	void set_colorbase(u16 colorbase) { m_color_base = colorbase; }
 	void set_granularity(u16 granularity) { m_color_granularity = granularity; }
 	void set_source_clip(u32 xoffs, u32 width, u32 yoffs, u32 height);
+	void set_predecoded(bool enable);
 
 	// operations
 	void mark_dirty(u32 code) { if (code < elements()) { m_dirty[code] = 1; m_dirtyseq++; } }
@@ -206,6 +230,9 @@ public:
 	// core drawgfx implementation
 	template <typename BitmapType, typename FunctionClass> void drawgfx_core(BitmapType &dest, const rectangle &cliprect, u32 code, int flipx, int flipy, s32 destx, s32 desty, FunctionClass pixel_op);
 
+	// core implementation drawing whole rows, for elements with a pre-decoded store
+	template <typename BitmapType, typename OpaqueRowClass, typename RowClass> void drawgfx_rows_core(BitmapType &dest, const rectangle &cliprect, u32 code, int flipx, int flipy, s32 destx, s32 desty, u32 transmask, OpaqueRowClass opaque_row, RowClass row_op);
+
 	// specific drawgfx implementations for each transparency type
 	void opaque(bitmap_ind16 &dest, const rectangle &cliprect, u32 code, u32 color, int flipx, int flipy, s32 destx, s32 desty);
 	void opaque(bitmap_rgb32 &dest, const rectangle &cliprect, u32 code, u32 color, int flipx, int flipy, s32 destx, s32 desty);
@@ -280,7 +307,11 @@ public:
 	void alphatable(bitmap_rgb32 &dest, const rectangle &cliprect, u32 code, u32 color, int flipx, int flipy, s32 destx, s32 desty, int fixedalpha, u8 *alphatable);
 
 private:
+	// pre-decoded rows start on multiples of this many bytes
+	static constexpr u32 PREDECODED_ALIGN = 16;
+
 	// internal helpers
+	void allocate_gfxdata();
 	void decode(u32 code);
 
 	// internal state
@@ -309,6 +340,8 @@ private:
 	std::vector<u8> m_gfxdata_allocated;    // allocated decoded pixel data, 8bpp
 	std::vector<u8> m_dirty;                // dirty array for detecting chars that need decoding
 	std::vector<u32>  m_pen_usage;      // bitmask of pens that are used (pens 0-31 only)
+	std::vector<u32>  m_row_pen_usage;  // bitmask of pens that are used in each row (pens 0-31 only, pre-decoded only)
+	bool            m_predecoded;           // decode into aligned rows and track row pen usage?
 
 	bool            m_layout_is_raw;        // raw layout?
 	u8              m_layout_planes;        // bit planes in the layout
@@ -320,6 +353,120 @@ private:
 };
 
 
+// ======================> gfx_command_list
+
+// records gfx_element draws and replays them in horizontal bands drawn
+// concurrently; each band sees every command in recorded order, clipped to
+// its own rows, so the result is the same as drawing them immediately
+class gfx_command_list
+{
+public:
+	// construction/destruction; bands is the most bands drawn concurrently,
+	// taken from the sprite_threads option when given a machine
+	gfx_command_list(running_machine &machine);
+	gfx_command_list(int bands);
+	~gfx_command_list();
+
+	// getters
+	bool empty() const { return m_commands.empty(); }
+	size_t size() const { return m_commands.size(); }
+
+	// discard all recorded commands
+	void reset() { m_commands.clear(); m_needs_rgb = false; }
+
+	// record commands, in the same form as the gfx_element methods without the bitmaps and cliprect
+	void opaque(gfx_element &gfx, u32 code, u32 color, int flipx, int flipy, s32 destx, s32 desty) { add(OP_OPAQUE, gfx, code, color, flipx, flipy, destx, desty); }
+	void transpen(gfx_element &gfx, u32 code, u32 color, int flipx, int flipy, s32 destx, s32 desty, u32 transpen) { add(OP_TRANSPEN, gfx, code, color, flipx, flipy, destx, desty).trans = transpen; }
+	void transpen_raw(gfx_element &gfx, u32 code, u32 color, int flipx, int flipy, s32 destx, s32 desty, u32 transpen) { add(OP_TRANSPEN_RAW, gfx, code, color, flipx, flipy, destx, desty).trans = transpen; }
+	void transmask(gfx_element &gfx, u32 code, u32 color, int flipx, int flipy, s32 destx, s32 desty, u32 transmask) { add(OP_TRANSMASK, gfx, code, color, flipx, flipy, destx, desty).trans = transmask; }
+	void alpha(gfx_element &gfx, u32 code, u32 color, int flipx, int flipy, s32 destx, s32 desty, u32 transpen, u8 alpha) { set_alpha(add(OP_ALPHA, gfx, code, color, flipx, flipy, destx, desty), transpen, alpha); }
+
+	void zoom_opaque(gfx_element &gfx, u32 code, u32 color, int flipx, int flipy, s32 destx, s32 desty, u32 scalex, u32 scaley) { add_zoom(OP_OPAQUE, gfx, code, color, flipx, flipy, destx, desty, scalex, scaley); }
+	void zoom_transpen(gfx_element &gfx, u32 code, u32 color, int flipx, int flipy, s32 destx, s32 desty, u32 scalex, u32 scaley, u32 transpen) { add_zoom(OP_TRANSPEN, gfx, code, color, flipx, flipy, destx, desty, scalex, scaley).trans = transpen; }
+	void zoom_transpen_raw(gfx_element &gfx, u32 code, u32 color, int flipx, int flipy, s32 destx, s32 desty, u32 scalex, u32 scaley, u32 transpen) { add_zoom(OP_TRANSPEN_RAW, gfx, code, color, flipx, flipy, destx, desty, scalex, scaley).trans = transpen; }
+	void zoom_transmask(gfx_element &gfx, u32 code, u32 color, int flipx, int flipy, s32 destx, s32 desty, u32 scalex, u32 scaley, u32 transmask) { add_zoom(OP_TRANSMASK, gfx, code, color, flipx, flipy, destx, desty, scalex, scaley).trans = transmask; }
+	void zoom_alpha(gfx_element &gfx, u32 code, u32 color, int flipx, int flipy, s32 destx, s32 desty, u32 scalex, u32 scaley, u32 transpen, u8 alpha) { set_alpha(add_zoom(OP_ALPHA, gfx, code, color, flipx, flipy, destx, desty, scalex, scaley), transpen, alpha); }
+
+	void prio_opaque(gfx_element &gfx, u32 code, u32 color, int flipx, int flipy, s32 destx, s32 desty, u32 pmask) { add_prio(OP_OPAQUE, gfx, code, color, flipx, flipy, destx, desty, pmask); }
+	void prio_transpen(gfx_element &gfx, u32 code, u32 color, int flipx, int flipy, s32 destx, s32 desty, u32 pmask, u32 transpen) { add_prio(OP_TRANSPEN, gfx, code, color, flipx, flipy, destx, desty, pmask).trans = transpen; }
+	void prio_transpen_raw(gfx_element &gfx, u32 code, u32 color, int flipx, int flipy, s32 destx, s32 desty, u32 pmask, u32 transpen) { add_prio(OP_TRANSPEN_RAW, gfx, code, color, flipx, flipy, destx, desty, pmask).trans = transpen; }
+	void prio_transmask(gfx_element &gfx, u32 code, u32 color, int flipx, int flipy, s32 destx, s32 desty, u32 pmask, u32 transmask) { add_prio(OP_TRANSMASK, gfx, code, color, flipx, flipy, destx, desty, pmask).trans = transmask; }
+	void prio_alpha(gfx_element &gfx, u32 code, u32 color, int flipx, int flipy, s32 destx, s32 desty, u32 pmask, u32 transpen, u8 alpha) { set_alpha(add_prio(OP_ALPHA, gfx, code, color, flipx, flipy, destx, desty, pmask), transpen, alpha); }
+
+	void prio_zoom_opaque(gfx_element &gfx, u32 code, u32 color, int flipx, int flipy, s32 destx, s32 desty, u32 scalex, u32 scaley, u32 pmask) { add_zoom(OP_OPAQUE | OP_PRIO, gfx, code, color, flipx, flipy, destx, desty, scalex, scaley, pmask); }
+	void prio_zoom_transpen(gfx_element &gfx, u32 code, u32 color, int flipx, int flipy, s32 destx, s32 desty, u32 scalex, u32 scaley, u32 pmask, u32 transpen) { add_zoom(OP_TRANSPEN | OP_PRIO, gfx, code, color, flipx, flipy, destx, desty, scalex, scaley, pmask).trans = transpen; }
+	void prio_zoom_transpen_raw(gfx_element &gfx, u32 code, u32 color, int flipx, int flipy, s32 destx, s32 desty, u32 scalex, u32 scaley, u32 pmask, u32 transpen) { add_zoom(OP_TRANSPEN_RAW | OP_PRIO, gfx, code, color, flipx, flipy, destx, desty, scalex, scaley, pmask).trans = transpen; }
+	void prio_zoom_transmask(gfx_element &gfx, u32 code, u32 color, int flipx, int flipy, s32 destx, s32 desty, u32 scalex, u32 scaley, u32 pmask, u32 transmask) { add_zoom(OP_TRANSMASK | OP_PRIO, gfx, code, color, flipx, flipy, destx, desty, scalex, scaley, pmask).trans = transmask; }
+	void prio_zoom_alpha(gfx_element &gfx, u32 code, u32 color, int flipx, int flipy, s32 destx, s32 desty, u32 scalex, u32 scaley, u32 pmask, u32 transpen, u8 alpha) { set_alpha(add_zoom(OP_ALPHA | OP_PRIO, gfx, code, color, flipx, flipy, destx, desty, scalex, scaley, pmask), transpen, alpha); }
+
+	// draw all recorded commands; priority is only used by the prio_ commands
+	void execute(bitmap_ind16 &dest, const rectangle &cliprect, bitmap_ind8 &priority);
+	void execute(bitmap_rgb32 &dest, const rectangle &cliprect, bitmap_ind8 &priority);
+
+private:
+	// operation types, with modifier flags
+	enum : u8
+	{
+		OP_OPAQUE = 0,
+		OP_TRANSPEN,
+		OP_TRANSPEN_RAW,
+		OP_TRANSMASK,
+		OP_ALPHA,
+		OP_TYPE_MASK = 0x0f,
+
+		OP_ZOOM = 0x10,
+		OP_PRIO = 0x20
+	};
+
+	// a single recorded draw
+	struct gfx_command
+	{
+		gfx_element *   gfx;
+		u32             code;
+		u32             color;
+		s32             destx;
+		s32             desty;
+		u32             scalex;
+		u32             scaley;
+		u32             pmask;
+		u32             trans;                  // transparent pen or pen mask
+		s32             top;                    // first destination row covered
+		s32             bottom;                 // last destination row covered
+		u8              op;
+		u8              flipx;
+		u8              flipy;
+		u8              alpha;
+	};
+
+	// a band of rows drawn on its own work item
+	template <typename BitmapType> struct band_data
+	{
+		gfx_command_list *  list;
+		BitmapType *        dest;
+		bitmap_ind8 *       priority;
+		rectangle           cliprect;
+	};
+
+	// recording helpers
+	gfx_command &add(u8 op, gfx_element &gfx, u32 code, u32 color, int flipx, int flipy, s32 destx, s32 desty, u32 pmask = 0);
+	gfx_command &add_zoom(u8 op, gfx_element &gfx, u32 code, u32 color, int flipx, int flipy, s32 destx, s32 desty, u32 scalex, u32 scaley, u32 pmask = 0);
+	gfx_command &add_prio(u8 op, gfx_element &gfx, u32 code, u32 color, int flipx, int flipy, s32 destx, s32 desty, u32 pmask) { return add(op | OP_PRIO, gfx, code, color, flipx, flipy, destx, desty, pmask); }
+	gfx_command &set_alpha(gfx_command &cmd, u32 transpen, u8 alpha) { cmd.trans = transpen; cmd.alpha = alpha; m_needs_rgb = true; return cmd; }
+
+	// execution helpers
+	template <typename BitmapType> void execute_bands(BitmapType &dest, const rectangle &cliprect, bitmap_ind8 &priority);
+	template <typename BitmapType> void draw_band(BitmapType &dest, const rectangle &cliprect, bitmap_ind8 &priority) const;
+	template <typename BitmapType> static void draw_command(const gfx_command &cmd, BitmapType &dest, const rectangle &cliprect, bitmap_ind8 &priority);
+	template <typename BitmapType> static void *draw_band_callback(void *param, int threadid);
+
+	// internal state
+	std::vector<gfx_command> m_commands;        // recorded commands, in drawing order
+	osd_work_queue *        m_work_queue;       // work queue for drawing in bands
+	int                     m_bands;            // maximum number of bands to draw concurrently
+	bool                    m_needs_rgb;        // true if any command can only draw to RGB32 bitmaps
+};
+
+
 /***************************************************************************
     FUNCTION PROTOTYPES
 ***************************************************************************/
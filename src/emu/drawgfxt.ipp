@@ -15,6 +15,12 @@
 
 #pragma once
 
+// use SSE2 row kernels where it can be assumed, as rgbutil.h does
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define MAME_DRAWGFX_SSE2
+#include <emmintrin.h>
+#endif
+
 
 /***************************************************************************
     PIXEL OPERATIONS
@@ -399,6 +405,277 @@ do
 while (0)
 
 
+/***************************************************************************
+    ROW KERNELS
+***************************************************************************/
+
+/*
+    Row kernels for elements with a pre-decoded store.  Each draws count
+    pixels of one row, reading the source forwards, or backwards from srcptr
+    when flipx is set.  The scalar loops are the reference for the vector
+    kernels and are used when Vectorize is false or SSE2 can't be assumed.
+    The vector kernels compare 16 source pixels at once against the
+    transparent pen, skip runs that are entirely transparent, store runs
+    that are entirely opaque, and blend the rest with the destination.
+    Source loads are aligned when the row's first 16 pens start on a
+    16-byte boundary, as they do for unclipped pre-decoded rows of widths
+    that are a multiple of 16; destination rows needn't be aligned.
+*/
+
+template <bool Vectorize = true>
+class drawgfx_scanline
+{
+#if defined(MAME_DRAWGFX_SSE2)
+	static constexpr bool VectorKernels = Vectorize;
+#else
+	static constexpr bool VectorKernels = false;
+#endif
+
+public:
+	/*-------------------------------------------------
+	    rows - draw rows with row_op, skipping rows
+	    that only use pens in transmask and drawing
+	    rows that use none of them with opaque_row;
+	    rowusage is optional
+	-------------------------------------------------*/
+
+	template <typename PixelType, typename OpaqueRowClass, typename RowClass>
+	static void rows(PixelType *destptr, s32 destmodulo, const u8 *srcptr, s32 srcmodulo, const u32 *rowusage, s32 usagestep, s32 count, s32 height, bool flipx, u32 transmask, OpaqueRowClass opaque_row, RowClass row_op)
+	{
+		for (s32 y = 0; y < height; y++, destptr += destmodulo, srcptr += srcmodulo)
+		{
+			if (rowusage)
+			{
+				u32 const usage = *rowusage;
+				rowusage += usagestep;
+
+				// fully transparent row; do nothing
+				if ((usage & ~transmask) == 0)
+					continue;
+
+				// fully opaque row; draw as such
+				if ((usage & transmask) == 0)
+				{
+					opaque_row(destptr, srcptr, count, flipx);
+					continue;
+				}
+			}
+			row_op(destptr, srcptr, count, flipx);
+		}
+	}
+
+
+	/*-------------------------------------------------
+	    pixels - apply a pixel op across a row
+	-------------------------------------------------*/
+
+	template <typename PixelType, typename FunctionClass>
+	static void pixels(PixelType *destptr, const u8 *srcptr, s32 count, bool flipx, FunctionClass pixel_op)
+	{
+		if (!flipx)
+		{
+			for (s32 x = 0; x < count; x++)
+				pixel_op(destptr[x], srcptr[x]);
+		}
+		else
+		{
+			for (s32 x = 0; x < count; x++)
+				pixel_op(destptr[x], srcptr[-x]);
+		}
+	}
+
+
+	/*-------------------------------------------------
+	    opaque_ind16 - add color to every pen
+	-------------------------------------------------*/
+
+	static void opaque_ind16(u16 *destptr, const u8 *srcptr, s32 count, bool flipx, u32 color)
+	{
+		if (!flipx)
+			(aligned_pens(srcptr, false) ? &opaque_ind16<false, true> : &opaque_ind16<false, false>)(destptr, srcptr, count, color);
+		else
+			(aligned_pens(srcptr, true) ? &opaque_ind16<true, true> : &opaque_ind16<true, false>)(destptr, srcptr, count, color);
+	}
+
+
+	/*-------------------------------------------------
+	    transpen_ind16 - add color to every pen
+	    other than trans_pen
+	-------------------------------------------------*/
+
+	static void transpen_ind16(u16 *destptr, const u8 *srcptr, s32 count, bool flipx, u32 color, u32 trans_pen)
+	{
+		if (!flipx)
+			(aligned_pens(srcptr, false) ? &transpen_ind16<false, true> : &transpen_ind16<false, false>)(destptr, srcptr, count, color, trans_pen);
+		else
+			(aligned_pens(srcptr, true) ? &transpen_ind16<true, true> : &transpen_ind16<true, false>)(destptr, srcptr, count, color, trans_pen);
+	}
+
+
+	/*-------------------------------------------------
+	    opaque_rgb32 - look up every pen in paldata
+	-------------------------------------------------*/
+
+	static void opaque_rgb32(u32 *destptr, const u8 *srcptr, s32 count, bool flipx, const pen_t *paldata)
+	{
+		pixels(destptr, srcptr, count, flipx, [paldata] (u32 &destp, const u8 &srcp) { PIXEL_OP_REMAP_OPAQUE(destp, srcp); });
+	}
+
+
+	/*-------------------------------------------------
+	    transpen_rgb32 - look up every pen other
+	    than trans_pen in paldata
+	-------------------------------------------------*/
+
+	static void transpen_rgb32(u32 *destptr, const u8 *srcptr, s32 count, bool flipx, const pen_t *paldata, u32 trans_pen)
+	{
+		if (!flipx)
+			(aligned_pens(srcptr, false) ? &transpen_rgb32<false, true> : &transpen_rgb32<false, false>)(destptr, srcptr, count, paldata, trans_pen);
+		else
+			(aligned_pens(srcptr, true) ? &transpen_rgb32<true, true> : &transpen_rgb32<true, false>)(destptr, srcptr, count, paldata, trans_pen);
+	}
+
+private:
+	// whether the first 16 pens a vector kernel loads start on a 16-byte
+	// boundary; the rest follow at 16-byte steps
+	static bool aligned_pens(const u8 *srcptr, bool flipx)
+	{
+		return ((uintptr_t(srcptr) - (flipx ? 15 : 0)) & 15) == 0;
+	}
+
+	template <bool FlipX, bool Aligned>
+	static void opaque_ind16(u16 *destptr, const u8 *srcptr, s32 count, u32 color)
+	{
+		s32 x = 0;
+#if defined(MAME_DRAWGFX_SSE2)
+		if constexpr (VectorKernels)
+		{
+			__m128i const base = _mm_set1_epi16(s16(color));
+			__m128i const zero = _mm_setzero_si128();
+			for ( ; x + 16 <= count; x += 16)
+			{
+				__m128i const pens = load_pens<FlipX, Aligned>(srcptr, x);
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(&destptr[x]), _mm_add_epi16(_mm_unpacklo_epi8(pens, zero), base));
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(&destptr[x + 8]), _mm_add_epi16(_mm_unpackhi_epi8(pens, zero), base));
+			}
+		}
+#endif
+		for ( ; x < count; x++)
+			PIXEL_OP_REBASE_OPAQUE(destptr[x], srcptr[FlipX ? -x : x]);
+	}
+
+	template <bool FlipX, bool Aligned>
+	static void transpen_ind16(u16 *destptr, const u8 *srcptr, s32 count, u32 color, u32 trans_pen)
+	{
+		s32 x = 0;
+#if defined(MAME_DRAWGFX_SSE2)
+		if constexpr (VectorKernels)
+		{
+			__m128i const base = _mm_set1_epi16(s16(color));
+			__m128i const trans = _mm_set1_epi8(s8(trans_pen));
+			__m128i const zero = _mm_setzero_si128();
+			for ( ; x + 16 <= count; x += 16)
+			{
+				__m128i const pens = load_pens<FlipX, Aligned>(srcptr, x);
+				__m128i const transparent = _mm_cmpeq_epi8(pens, trans);
+				int const mask = _mm_movemask_epi8(transparent);
+				if (mask == 0xffff)
+					continue;
+
+				__m128i *const dest = reinterpret_cast<__m128i *>(&destptr[x]);
+				__m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(pens, zero), base);
+				__m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(pens, zero), base);
+				if (mask != 0)
+				{
+					// keep the destination where the source is transparent
+					__m128i const keeplo = _mm_unpacklo_epi8(transparent, transparent);
+					__m128i const keephi = _mm_unpackhi_epi8(transparent, transparent);
+					lo = _mm_or_si128(_mm_and_si128(keeplo, _mm_loadu_si128(dest)), _mm_andnot_si128(keeplo, lo));
+					hi = _mm_or_si128(_mm_and_si128(keephi, _mm_loadu_si128(dest + 1)), _mm_andnot_si128(keephi, hi));
+				}
+				_mm_storeu_si128(dest, lo);
+				_mm_storeu_si128(dest + 1, hi);
+			}
+		}
+#endif
+		for ( ; x < count; x++)
+			PIXEL_OP_REBASE_TRANSPEN(destptr[x], srcptr[FlipX ? -x : x]);
+	}
+
+	template <bool FlipX, bool Aligned>
+	static void transpen_rgb32(u32 *destptr, const u8 *srcptr, s32 count, const pen_t *paldata, u32 trans_pen)
+	{
+		s32 x = 0;
+#if defined(MAME_DRAWGFX_SSE2)
+		if constexpr (VectorKernels)
+		{
+			__m128i const trans = _mm_set1_epi8(s8(trans_pen));
+			for ( ; x + 16 <= count; x += 16)
+			{
+				__m128i const pens = load_pens<FlipX, Aligned>(srcptr, x);
+				__m128i const transparent = _mm_cmpeq_epi8(pens, trans);
+				int const mask = _mm_movemask_epi8(transparent);
+				if (mask == 0xffff)
+					continue;
+
+				// there's no gather in SSE2, so look the pens up four at a time
+				alignas(16) u8 pen[16];
+				_mm_store_si128(reinterpret_cast<__m128i *>(pen), pens);
+				__m128i const keep[2] = { _mm_unpacklo_epi8(transparent, transparent), _mm_unpackhi_epi8(transparent, transparent) };
+				__m128i *const dest = reinterpret_cast<__m128i *>(&destptr[x]);
+				for (int group = 0; group < 4; group++)
+				{
+					int const groupmask = (mask >> (group * 4)) & 0x0f;
+					if (groupmask == 0x0f)
+						continue;
+
+					u8 const *const p = &pen[group * 4];
+					__m128i color = _mm_setr_epi32(paldata[p[0]], paldata[p[1]], paldata[p[2]], paldata[p[3]]);
+					if (groupmask != 0)
+					{
+						// keep the destination where the source is transparent
+						__m128i const keepw = keep[group >> 1];
+						__m128i const keepd = (group & 1) ? _mm_unpackhi_epi16(keepw, keepw) : _mm_unpacklo_epi16(keepw, keepw);
+						color = _mm_or_si128(_mm_and_si128(keepd, _mm_loadu_si128(dest + group)), _mm_andnot_si128(keepd, color));
+					}
+					_mm_storeu_si128(dest + group, color);
+				}
+			}
+		}
+#endif
+		for ( ; x < count; x++)
+			PIXEL_OP_REMAP_TRANSPEN(destptr[x], srcptr[FlipX ? -x : x]);
+	}
+
+#if defined(MAME_DRAWGFX_SSE2)
+	// load 16 pens starting at pixel x, in drawing order
+	template <bool FlipX, bool Aligned>
+	static __m128i load_pens(const u8 *srcptr, s32 x)
+	{
+		if (!FlipX)
+			return load<Aligned>(srcptr + x);
+
+		// the pens run backwards from srcptr - x, so load the 16 ending there and reverse them
+		__m128i pens = load<Aligned>(srcptr - x - 15);
+		pens = _mm_or_si128(_mm_slli_epi16(pens, 8), _mm_srli_epi16(pens, 8));
+		pens = _mm_shufflelo_epi16(pens, _MM_SHUFFLE(0, 1, 2, 3));
+		pens = _mm_shufflehi_epi16(pens, _MM_SHUFFLE(0, 1, 2, 3));
+		return _mm_shuffle_epi32(pens, _MM_SHUFFLE(1, 0, 3, 2));
+	}
+
+	template <bool Aligned>
+	static __m128i load(const u8 *ptr)
+	{
+		if (Aligned)
+			return _mm_load_si128(reinterpret_cast<const __m128i *>(ptr));
+		else
+			return _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+	}
+#endif
+};
+
+
+
 /***************************************************************************
     BASIC DRAWGFX CORE
 ***************************************************************************/
@@ -555,6 +832,87 @@ inline void gfx_element::drawgfx_core(BitmapType &dest, const rectangle &cliprec
 }
 
 
+/*
+    Row variant of the basic core, for elements with a pre-decoded store.
+    Rows are drawn whole by the drawgfx_scanline kernels in opaque_row and
+    row_op.  When per-row pen usage is available, rows that only use pens
+    in transmask are skipped and rows that use none of them are drawn with
+    opaque_row, which doesn't need to test each pixel.
+*/
+
+template <typename BitmapType, typename OpaqueRowClass, typename RowClass>
+inline void gfx_element::drawgfx_rows_core(BitmapType &dest, const rectangle &cliprect, u32 code, int flipx, int flipy, s32 destx, s32 desty, u32 transmask, OpaqueRowClass opaque_row, RowClass row_op)
+{
+	g_profiler.start(PROFILER_DRAWGFX);
+	do {
+		assert(dest.valid());
+		assert(dest.cliprect().contains(cliprect));
+		assert(code < elements());
+
+		// ignore empty/invalid cliprects
+		if (cliprect.empty())
+			break;
+
+		// compute final pixel in X and exit if we are entirely clipped
+		s32 destendx = destx + width() - 1;
+		if (destx > cliprect.right() || destendx < cliprect.left())
+			break;
+
+		// apply left clip
+		s32 srcx = 0;
+		if (destx < cliprect.left())
+		{
+			srcx = cliprect.left() - destx;
+			destx = cliprect.left();
+		}
+
+		// apply right clip
+		if (destendx > cliprect.right())
+			destendx = cliprect.right();
+
+		// compute final pixel in Y and exit if we are entirely clipped
+		s32 destendy = desty + height() - 1;
+		if (desty > cliprect.bottom() || destendy < cliprect.top())
+			break;
+
+		// apply top clip
+		s32 srcy = 0;
+		if (desty < cliprect.top())
+		{
+			srcy = cliprect.top() - desty;
+			desty = cliprect.top();
+		}
+
+		// apply bottom clip
+		if (destendy > cliprect.bottom())
+			destendy = cliprect.bottom();
+
+		// apply X flipping
+		if (flipx)
+			srcx = width() - 1 - srcx;
+
+		// apply Y flipping
+		s32 dy = rowbytes();
+		s32 drow = 1;
+		if (flipy)
+		{
+			srcy = height() - 1 - srcy;
+			dy = -dy;
+			drow = -1;
+		}
+
+		// fetch the source data and the usage for each row, which covers the whole unclipped row
+		const u8 *srcdata = get_data(code) + srcy * rowbytes() + srcx;
+		const u32 *rowusage = has_row_pen_usage() ? &m_row_pen_usage[code * m_origheight + m_starty + srcy] : nullptr;
+
+		// draw the rows
+		drawgfx_scanline<>::rows(&dest.pix(desty, destx), dest.rowpixels(), srcdata, dy, rowusage, drow,
+				destendx + 1 - destx, destendy + 1 - desty, flipx, transmask, opaque_row, row_op);
+	} while (0);
+	g_profiler.stop();
+}
+
+
 template <typename BitmapType, typename PriorityType, typename FunctionClass>
 inline void gfx_element::drawgfx_core(BitmapType &dest, const rectangle &cliprect, u32 code, int flipx, int flipy, s32 destx, s32 desty, PriorityType &priority, FunctionClass pixel_op)
 {
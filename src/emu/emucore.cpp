@@ -13,6 +13,11 @@
 #include "emucore.h"
 #include "osdcore.h"
 
+// the CPU is checked the same way the x86 DRC back-ends check it
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include "asmjit/src/asmjit/asmjit.h"
+#endif
+
 emu_fatalerror::emu_fatalerror(util::format_argument_pack<std::ostream> const &args)
 	: emu_fatalerror(0, args)
 {
@@ -37,3 +42,14 @@ void report_bad_device_cast(const device_t *dev, const std::type_info &src_type,
 	throw emu_fatalerror("Error: bad downcast<> or device<>.  Tried to convert the device %s (%s) of type %s to a %s, which are incompatible.\n",
 			dev->tag(), dev->name(), src_type.name(), dst_type.name());
 }
+
+
+bool host_has_avx2()
+{
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+	static bool const supported = asmjit::CpuInfo::host().features().x86().hasAVX2();
+	return supported;
+#else
+	return false;
+#endif
+}
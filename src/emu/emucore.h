@@ -307,6 +307,16 @@ inline Dest downcast(Source &src)
 
 
 
+//**************************************************************************
+//  HOST CPU FEATURES
+//**************************************************************************
+
+// true if functions marked ATTR_TARGET_AVX2 can be called; decided on first
+// use, since the CPU information isn't valid during static initialization
+bool host_has_avx2();
+
+
+
 //**************************************************************************
 //  INLINE FUNCTIONS
 //**************************************************************************
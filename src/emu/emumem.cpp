@@ -14,6 +14,8 @@
 #include "emuopts.h"
 #include "debug/debugcpu.h"
 
+#include "../osd/modules/lib/osdlib.h"
+
 #include "emumem_mud.h"
 #include "emumem_hea.h"
 #include "emumem_hem.h"
@@ -332,6 +334,22 @@ memory_region *memory_manager::region_alloc(std::string name, u32 length, u8 wid
 }
 
 
+//-------------------------------------------------
+//  region_alloc - creates a region backed by a
+//  copy-on-write file mapping
+//-------------------------------------------------
+
+memory_region *memory_manager::region_alloc(std::string name, std::unique_ptr<osd::file_mapping> &&mapping, u32 length, u8 width, endianness_t endian)
+{
+	// make sure we don't have a region of the same name; also find the end of the list
+	if (m_regionlist.find(name) != m_regionlist.end())
+		fatalerror("region_alloc called with duplicate region name \"%s\"\n", name);
+
+	// create the region around the mapping
+	return m_regionlist.emplace(name, std::make_unique<memory_region>(machine(), name, std::move(mapping), length, width, endian)).first->second.get();
+}
+
+
 //-------------------------------------------------
 //  region_find - find a region by name
 //-------------------------------------------------
@@ -360,7 +378,11 @@ void memory_manager::region_free(std::string name)
 void *memory_manager::anonymous_alloc(address_space &space, size_t bytes, u8 width, offs_t start, offs_t end, const std::string &key)
 {
 	std::string name = util::string_format("%s%x-%x", key, start, end);
-	return allocate_memory(space.device(), space.spacenum(), name, width, bytes);
+	void *const ptr = allocate_memory(space.device(), space.spacenum(), name, width, bytes);
+
+	// nothing else knows about anonymous memory, so all writes go through handlers
+	machine().save().track_changes(ptr);
+	return ptr;
 }
 
 
@@ -1038,6 +1060,8 @@ memory_region::memory_region(running_machine &machine, std::string name, u32 len
 	: m_machine(machine),
 		m_name(std::move(name)),
 		m_buffer(length),
+		m_base(m_buffer.data()),
+		m_length(length),
 		m_endianness(endian),
 		m_bitwidth(width * 8),
 		m_bytewidth(width)
@@ -1045,6 +1069,24 @@ memory_region::memory_region(running_machine &machine, std::string name, u32 len
 	assert(width == 1 || width == 2 || width == 4 || width == 8);
 }
 
+memory_region::memory_region(running_machine &machine, std::string name, std::unique_ptr<osd::file_mapping> &&mapping, u32 length, u8 width, endianness_t endian)
+	: m_machine(machine),
+		m_name(std::move(name)),
+		m_mapping(std::move(mapping)),
+		m_base(reinterpret_cast<u8 *>(m_mapping->get())),
+		m_length(length),
+		m_endianness(endian),
+		m_bitwidth(width * 8),
+		m_bytewidth(width)
+{
+	assert(width == 1 || width == 2 || width == 4 || width == 8);
+	assert(m_mapping->size() >= length);
+}
+
+memory_region::~memory_region()
+{
+}
+
 std::string memory_share::compare(u8 width, size_t bytes, endianness_t endianness) const
 {
 	if (width != m_bitwidth)
@@ -56,6 +56,8 @@ enum class read_or_write
 //  FORWARD DECLARATIONS
 //**************************************************************************
 
+namespace osd { class file_mapping; }
+
 class handler_entry;
 template<int Width, int AddrShift> class handler_entry_read_passthrough;
 template<int Width, int AddrShift> class handler_entry_write_passthrough;
@@ -2525,13 +2527,16 @@ class memory_region
 public:
 	// construction/destruction
 	memory_region(running_machine &machine, std::string name, u32 length, u8 width, endianness_t endian);
+	memory_region(running_machine &machine, std::string name, std::unique_ptr<osd::file_mapping> &&mapping, u32 length, u8 width, endianness_t endian);
+	~memory_region();
 
 	// getters
 	running_machine &machine() const { return m_machine; }
-	u8 *base() { return (m_buffer.size() > 0) ? &m_buffer[0] : nullptr; }
-	u8 *end() { return base() + m_buffer.size(); }
-	u32 bytes() const { return m_buffer.size(); }
+	u8 *base() { return (m_length > 0) ? m_base : nullptr; }
+	u8 *end() { return base() + m_length; }
+	u32 bytes() const { return m_length; }
 	const std::string &name() const { return m_name; }
+	bool mapped() const { return bool(m_mapping); }
 
 	// flag expansion
 	endianness_t endianness() const { return m_endianness; }
@@ -2539,7 +2544,7 @@ public:
 	u8 bytewidth() const { return m_bytewidth; }
 
 	// data access
-	u8 &as_u8(offs_t offset = 0) { return m_buffer[offset]; }
+	u8 &as_u8(offs_t offset = 0) { return m_base[offset]; }
 	u16 &as_u16(offs_t offset = 0) { return reinterpret_cast<u16 *>(base())[offset]; }
 	u32 &as_u32(offs_t offset = 0) { return reinterpret_cast<u32 *>(base())[offset]; }
 	u64 &as_u64(offs_t offset = 0) { return reinterpret_cast<u64 *>(base())[offset]; }
@@ -2549,6 +2554,9 @@ private:
 	running_machine &       m_machine;
 	std::string             m_name;
 	std::vector<u8>         m_buffer;
+	std::unique_ptr<osd::file_mapping> m_mapping;
+	u8 *                    m_base;
+	u32                     m_length;
 	endianness_t            m_endianness;
 	u8                      m_bitwidth;
 	u8                      m_bytewidth;
@@ -2670,6 +2678,7 @@ public:
 
 	// regions
 	memory_region *region_alloc(std::string name, u32 length, u8 width, endianness_t endian);
+	memory_region *region_alloc(std::string name, std::unique_ptr<osd::file_mapping> &&mapping, u32 length, u8 width, endianness_t endian);
 	memory_region *region_find(std::string name);
 	void region_free(std::string name);
 
@@ -22,6 +22,9 @@ template<int Width, int AddrShift> u16 handler_entry_read_memory<Width, AddrShif
 
 template<int Width, int AddrShift> void *handler_entry_read_memory<Width, AddrShift>::get_ptr(offs_t offset) const
 {
+	// writes through the pointer can't be seen
+	if (m_tracker)
+		m_tracker->untrack();
 	return m_base + (((offset - this->m_address_base) & this->m_address_mask) >> (Width + AddrShift));
 }
 
@@ -35,12 +38,16 @@ template<int Width, int AddrShift> void handler_entry_write_memory<Width, AddrSh
 {
 	offs_t off = ((offset - this->m_address_base) & this->m_address_mask) >> (Width + AddrShift);
 	m_base[off] = (m_base[off] & ~mem_mask) | (data & mem_mask);
+	if (m_tracker)
+		m_tracker->touch(m_tracker_offset + off * sizeof(uX));
 }
 
 template<int Width, int AddrShift> u16 handler_entry_write_memory<Width, AddrShift>::write_flags(offs_t offset, uX data, uX mem_mask) const
 {
 	offs_t off = ((offset - this->m_address_base) & this->m_address_mask) >> (Width + AddrShift);
 	m_base[off] = (m_base[off] & ~mem_mask) | (data & mem_mask);
+	if (m_tracker)
+		m_tracker->touch(m_tracker_offset + off * sizeof(uX));
 	return this->m_flags;
 }
 
@@ -51,17 +58,26 @@ template<int Width, int AddrShift> u16 handler_entry_write_memory<Width, AddrShi
 
 template<> void handler_entry_write_memory<0, 0>::write(offs_t offset, u8 data, u8 mem_mask) const
 {
-	m_base[(offset - this->m_address_base) & this->m_address_mask] = data;
+	offs_t off = (offset - this->m_address_base) & this->m_address_mask;
+	m_base[off] = data;
+	if (m_tracker)
+		m_tracker->touch(m_tracker_offset + off);
 }
 
 template<> u16 handler_entry_write_memory<0, 0>::write_flags(offs_t offset, u8 data, u8 mem_mask) const
 {
-	m_base[(offset - this->m_address_base) & this->m_address_mask] = data;
+	offs_t off = (offset - this->m_address_base) & this->m_address_mask;
+	m_base[off] = data;
+	if (m_tracker)
+		m_tracker->touch(m_tracker_offset + off);
 	return this->m_flags;
 }
 
 template<int Width, int AddrShift> void *handler_entry_write_memory<Width, AddrShift>::get_ptr(offs_t offset) const
 {
+	// writes through the pointer can't be seen
+	if (m_tracker)
+		m_tracker->untrack();
 	return m_base + (((offset - this->m_address_base) & this->m_address_mask) >> (Width + AddrShift));
 }
 
@@ -14,7 +14,9 @@ template<int Width, int AddrShift> class handler_entry_read_memory : public hand
 public:
 	using uX = typename emu::detail::handler_entry_size<Width>::uX;
 
-	handler_entry_read_memory(address_space *space, u16 flags, void *base) : handler_entry_read_address<Width, AddrShift>(space, flags), m_base(reinterpret_cast<uX *>(base)) {}
+	handler_entry_read_memory(address_space *space, u16 flags, void *base) : handler_entry_read_address<Width, AddrShift>(space, flags), m_base(reinterpret_cast<uX *>(base)), m_tracker_offset(0) {
+		m_tracker = space->device().machine().save().find_tracker(base, m_tracker_offset);
+	}
 	~handler_entry_read_memory() = default;
 
 	uX read(offs_t offset, uX mem_mask) const override;
@@ -26,6 +28,8 @@ public:
 
 private:
 	uX *m_base;
+	save_change_tracker *m_tracker;
+	size_t m_tracker_offset;
 };
 
 template<int Width, int AddrShift> class handler_entry_write_memory : public handler_entry_write_address<Width, AddrShift>
@@ -33,7 +37,9 @@ template<int Width, int AddrShift> class handler_entry_write_memory : public han
 public:
 	using uX = typename emu::detail::handler_entry_size<Width>::uX;
 
-	handler_entry_write_memory(address_space *space, u16 flags, void *base) : handler_entry_write_address<Width, AddrShift>(space, flags), m_base(reinterpret_cast<uX *>(base)) {}
+	handler_entry_write_memory(address_space *space, u16 flags, void *base) : handler_entry_write_address<Width, AddrShift>(space, flags), m_base(reinterpret_cast<uX *>(base)), m_tracker_offset(0) {
+		m_tracker = space->device().machine().save().find_tracker(base, m_tracker_offset);
+	}
 	~handler_entry_write_memory() = default;
 
 	void write(offs_t offset, uX data, uX mem_mask) const override;
@@ -45,6 +51,8 @@ public:
 
 private:
 	uX *m_base;
+	save_change_tracker *m_tracker;
+	size_t m_tracker_offset;
 };
 
 
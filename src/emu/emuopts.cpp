@@ -62,6 +62,7 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_COMMENT_DIRECTORY,                          "comments",  core_options::option_type::STRING,     "directory to save debugger comments" },
 	{ OPTION_VIDEO_DIRECTORY,                          	 "video",     core_options::option_type::STRING,     "directory to save/load video files" },  // MAMEFX
 	{ OPTION_SHARE_DIRECTORY,                            "share",     core_options::option_type::STRING,     "directory to share with emulated machines" },
+	{ OPTION_DRC_CACHE_DIRECTORY,                        "drc",       core_options::option_type::STRING,     "directory to save DRC opcode descriptions between runs" },
 
 	// state/playback options
 	{ nullptr,                                           nullptr,     core_options::option_type::HEADER,     "CORE STATE/PLAYBACK OPTIONS" },
@@ -69,6 +70,8 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_AUTOSAVE,                                   "0",         core_options::option_type::BOOLEAN,    "automatically restore state on start and save on exit for supported systems" },
 	{ OPTION_REWIND,                                     "0",         core_options::option_type::BOOLEAN,    "enable rewind savestates" },
 	{ OPTION_REWIND_CAPACITY "(1-2048)",                 "100",       core_options::option_type::INTEGER,    "rewind buffer size in megabytes" },
+	{ OPTION_REWIND_KEYFRAME "(0-1000)",                 "0",         core_options::option_type::INTEGER,    "number of rewind states per keyframe; states in between are stored as compressed differences (0 to store every state in full)" },
+	{ OPTION_STATE_TRACKING,                             "0",         core_options::option_type::BOOLEAN,    "track writes to RAM so rewind states only copy the pages that changed" },
 	{ OPTION_PLAYBACK ";pb",                             nullptr,     core_options::option_type::STRING,     "playback an input file" },
 	{ OPTION_RECORD ";rec",                              nullptr,     core_options::option_type::STRING,     "record an input file" },
 	{ OPTION_EXIT_AFTER_PLAYBACK,                        "0",         core_options::option_type::BOOLEAN,    "close the program at the end of playback" },
@@ -94,6 +97,9 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_SPEED "(0.01-100)",                         "1.0",       core_options::option_type::FLOAT,      "controls the speed of gameplay, relative to realtime; smaller numbers are slower" },
 	{ OPTION_REFRESHSPEED ";rs",                         "0",         core_options::option_type::BOOLEAN,    "automatically adjust emulation speed to keep the emulated refresh rate slower than the host screen" },
 	{ OPTION_LOWLATENCY ";lolat",                        "0",         core_options::option_type::BOOLEAN,    "draws new frame before throttling to reduce input latency" },
+	{ OPTION_RENDER_THREADS "(1-64)",                    "1",         core_options::option_type::INTEGER,    "number of horizontal bands the software renderer draws concurrently for display, snapshots and movies (1 to disable)" },
+	{ OPTION_TILEMAP_THREADS "(1-64)",                   "1",         core_options::option_type::INTEGER,    "number of horizontal bands tilemaps are drawn in concurrently (1 to disable)" },
+	{ OPTION_SPRITE_THREADS "(1-64)",                    "1",         core_options::option_type::INTEGER,    "number of horizontal bands graphics command lists are drawn in concurrently (1 to disable)" },
 
 	// render options
 	{ nullptr,                                           nullptr,     core_options::option_type::HEADER,     "CORE RENDER OPTIONS" },
@@ -146,6 +152,7 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_VOLUME ";vol",                              "0",         core_options::option_type::INTEGER,    "sound volume in decibels (-32 min, 0 max)" },
 	{ OPTION_COMPRESSOR,                                 "1",         core_options::option_type::BOOLEAN,    "enable compressor for sound" },
 	{ OPTION_SPEAKER_REPORT "(0-4)",                     "0",         core_options::option_type::INTEGER,    "print report of speaker ouput maxima (0=none, or 1-4 for more detail)" },
+	{ OPTION_SOUND_THREADS "(1-64)",                     "1",         core_options::option_type::INTEGER,    "number of threads used to update independent sound chips concurrently (1 to disable)" },
 
 	// input options
 	{ nullptr,                                           nullptr,     core_options::option_type::HEADER,     "CORE INPUT OPTIONS" },
@@ -201,6 +208,8 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_DRC_USE_C,                                  "0",         core_options::option_type::BOOLEAN,    "force DRC to use C backend" },
 	{ OPTION_DRC_LOG_UML,                                "0",         core_options::option_type::BOOLEAN,    "write DRC UML disassembly log" },
 	{ OPTION_DRC_LOG_NATIVE,                             "0",         core_options::option_type::BOOLEAN,    "write DRC native disassembly log" },
+	{ OPTION_DRC_CACHE,                                  "0",         core_options::option_type::BOOLEAN,    "keep DRC opcode descriptions between runs" },
+	{ OPTION_DRC_TRACE_THRESHOLD,                        "0",         core_options::option_type::INTEGER,    "times a branch out of a DRC block must be taken before its target is compiled into the block (0 = never)" },
 	{ OPTION_BIOS,                                       nullptr,     core_options::option_type::STRING,     "select the system BIOS to use" },
 	{ OPTION_CHEAT ";c",                                 "0",         core_options::option_type::BOOLEAN,    "enable cheat subsystem" },
 	{ OPTION_SKIP_GAMEINFO,                              "0",         core_options::option_type::BOOLEAN,    "skip displaying the system information screen at startup" },
@@ -211,6 +220,10 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_UI_MOUSE,                                   "1",         core_options::option_type::BOOLEAN,    "display UI mouse cursor" },
 	{ OPTION_LANGUAGE ";lang",                           "",          core_options::option_type::STRING,     "set UI display language" },
 	{ OPTION_NVRAM_SAVE ";nvwrite",                      "1",         core_options::option_type::BOOLEAN,    "save NVRAM data on exit" },
+	{ OPTION_AUDIT_CACHE,                                "0",         core_options::option_type::BOOLEAN,    "reuse audit results for ROM sets whose files have not changed" },
+	{ OPTION_CHD_CACHE,                                  "1",         core_options::option_type::INTEGER,    "number of decompressed hunks to cache for each CHD disk image" },
+	{ OPTION_CHD_READ_AHEAD,                             "0",         core_options::option_type::INTEGER,    "number of hunks to decompress in the background when a CHD is read sequentially (0 to disable)" },
+	{ OPTION_ROM_MAP,                                    "0",         core_options::option_type::BOOLEAN,    "map large unpacked ROM files into memory instead of loading them, sharing pages between instances" },
 
 	{ nullptr,                                           nullptr,     core_options::option_type::HEADER,     "SCRIPTING OPTIONS" },
 	{ OPTION_AUTOBOOT_COMMAND ";ab",                     nullptr,     core_options::option_type::STRING,     "command to execute after machine boot" },
@@ -49,12 +49,15 @@
 #define OPTION_COMMENT_DIRECTORY    "comment_directory"
 #define OPTION_VIDEO_DIRECTORY      "video_directory"
 #define OPTION_SHARE_DIRECTORY      "share_directory"
+#define OPTION_DRC_CACHE_DIRECTORY  "drc_cache_directory"
 
 // core state/playback options
 #define OPTION_STATE                "state"
 #define OPTION_AUTOSAVE             "autosave"
 #define OPTION_REWIND               "rewind"
 #define OPTION_REWIND_CAPACITY      "rewind_capacity"
+#define OPTION_REWIND_KEYFRAME      "rewind_keyframe"
+#define OPTION_STATE_TRACKING       "state_tracking"
 #define OPTION_PLAYBACK             "playback"
 #define OPTION_RECORD               "record"
 #define OPTION_EXIT_AFTER_PLAYBACK  "exit_after_playback"
@@ -78,6 +81,9 @@
 #define OPTION_SPEED                "speed"
 #define OPTION_REFRESHSPEED         "refreshspeed"
 #define OPTION_LOWLATENCY           "lowlatency"
+#define OPTION_RENDER_THREADS       "renderthreads"
+#define OPTION_TILEMAP_THREADS      "tilemapthreads"
+#define OPTION_SPRITE_THREADS       "spritethreads"
 
 // core render options
 #define OPTION_KEEPASPECT           "keepaspect"
@@ -124,6 +130,7 @@
 #define OPTION_VOLUME               "volume"
 #define OPTION_COMPRESSOR           "compressor"
 #define OPTION_SPEAKER_REPORT       "speaker_report"
+#define OPTION_SOUND_THREADS        "soundthreads"
 
 // core input options
 #define OPTION_COIN_LOCKOUT         "coin_lockout"
@@ -167,6 +174,8 @@
 #define OPTION_DRC_USE_C            "drc_use_c"
 #define OPTION_DRC_LOG_UML          "drc_log_uml"
 #define OPTION_DRC_LOG_NATIVE       "drc_log_native"
+#define OPTION_DRC_CACHE            "drc_cache"
+#define OPTION_DRC_TRACE_THRESHOLD  "drc_trace_threshold"
 #define OPTION_BIOS                 "bios"
 #define OPTION_CHEAT                "cheat"
 #define OPTION_SKIP_GAMEINFO        "skip_gameinfo"
@@ -174,6 +183,10 @@
 #define OPTION_UI                   "ui"
 #define OPTION_RAMSIZE              "ramsize"
 #define OPTION_NVRAM_SAVE           "nvram_save"
+#define OPTION_AUDIT_CACHE          "auditcache"
+#define OPTION_CHD_CACHE            "chdcache"
+#define OPTION_CHD_READ_AHEAD       "chdreadahead"
+#define OPTION_ROM_MAP              "rommap"
 
 // core comm options
 #define OPTION_COMM_LOCAL_HOST      "comm_localhost"
@@ -337,12 +350,15 @@ public:
 	const char *comment_directory() const { return value(OPTION_COMMENT_DIRECTORY); }
 	const char *video_directory() const { return value(OPTION_VIDEO_DIRECTORY); }
 	const char *share_directory() const { return value(OPTION_SHARE_DIRECTORY); }
+	const char *drc_cache_directory() const { return value(OPTION_DRC_CACHE_DIRECTORY); }
 
 	// core state/playback options
 	const char *state() const { return value(OPTION_STATE); }
 	bool autosave() const { return bool_value(OPTION_AUTOSAVE); }
 	int rewind() const { return bool_value(OPTION_REWIND); }
 	int rewind_capacity() const { return int_value(OPTION_REWIND_CAPACITY); }
+	int rewind_keyframe() const { return int_value(OPTION_REWIND_KEYFRAME); }
+	bool state_tracking() const { return bool_value(OPTION_STATE_TRACKING); }
 	const char *playback() const { return value(OPTION_PLAYBACK); }
 	const char *record() const { return value(OPTION_RECORD); }
 	bool exit_after_playback() const { return bool_value(OPTION_EXIT_AFTER_PLAYBACK); }
@@ -366,6 +382,9 @@ public:
 	float speed() const { return float_value(OPTION_SPEED); }
 	bool refresh_speed() const { return m_refresh_speed; }
 	bool low_latency() const { return bool_value(OPTION_LOWLATENCY); }
+	int render_threads() const { return int_value(OPTION_RENDER_THREADS); }
+	int tilemap_threads() const { return int_value(OPTION_TILEMAP_THREADS); }
+	int sprite_threads() const { return int_value(OPTION_SPRITE_THREADS); }
 
 	// core render options
 	bool keep_aspect() const { return bool_value(OPTION_KEEPASPECT); }
@@ -412,6 +431,7 @@ public:
 	int volume() const { return int_value(OPTION_VOLUME); }
 	bool compressor() const { return bool_value(OPTION_COMPRESSOR); }
 	int speaker_report() const { return int_value(OPTION_SPEAKER_REPORT); }
+	int sound_threads() const { return int_value(OPTION_SOUND_THREADS); }
 
 	// core input options
 	bool coin_lockout() const { return bool_value(OPTION_COIN_LOCKOUT); }
@@ -453,6 +473,8 @@ public:
 	bool drc_use_c() const { return bool_value(OPTION_DRC_USE_C); }
 	bool drc_log_uml() const { return bool_value(OPTION_DRC_LOG_UML); }
 	bool drc_log_native() const { return bool_value(OPTION_DRC_LOG_NATIVE); }
+	bool drc_cache() const { return bool_value(OPTION_DRC_CACHE); }
+	int drc_trace_threshold() const { return int_value(OPTION_DRC_TRACE_THRESHOLD); }
 	const char *bios() const { return value(OPTION_BIOS); }
 	bool cheat() const { return bool_value(OPTION_CHEAT); }
 	bool skip_gameinfo() const { return bool_value(OPTION_SKIP_GAMEINFO); }
@@ -460,6 +482,10 @@ public:
 	ui_option ui() const { return m_ui; }
 	const char *ram_size() const { return value(OPTION_RAMSIZE); }
 	bool nvram_save() const { return bool_value(OPTION_NVRAM_SAVE); }
+	bool audit_cache() const { return bool_value(OPTION_AUDIT_CACHE); }
+	int chd_cache() const { return int_value(OPTION_CHD_CACHE); }
+	int chd_read_ahead() const { return int_value(OPTION_CHD_READ_AHEAD); }
+	bool rom_map() const { return bool_value(OPTION_ROM_MAP); }
 
 	// core comm options
 	const char *comm_localhost() const { return value(OPTION_COMM_LOCAL_HOST); }
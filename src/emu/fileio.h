@@ -149,6 +149,7 @@ public:
 	const char *filename() const { return m_filename.c_str(); }
 	const char *fullpath() const { return m_fullpath.c_str(); }
 	u32 openflags() const { return m_openflags; }
+	bool archived() const { return m_zipfile || !m_zipdata.empty(); }
 	util::hash_collection &hashes(std::string_view types);
 
 	// setters
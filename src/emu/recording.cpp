@@ -31,7 +31,7 @@ namespace
 		virtual bool add_sound_to_recording(const s16 *sound, int numsamples) override;
 
 	protected:
-		virtual bool append_single_video_frame(bitmap_rgb32 &bitmap, const rgb_t *palette, int palette_entries) override;
+		virtual bool append_single_video_frame(bitmap_rgb32 &bitmap, const rectangle &dirty, const rgb_t *palette, int palette_entries) override;
 
 	private:
 		avi_file::ptr m_avi_file; // handle to the open movie file
@@ -48,7 +48,7 @@ namespace
 		virtual bool add_sound_to_recording(const s16 *sound, int numsamples) override;
 
 	protected:
-		virtual bool append_single_video_frame(bitmap_rgb32 &bitmap, const rgb_t *palette, int palette_entries) override;
+		virtual bool append_single_video_frame(bitmap_rgb32 &bitmap, const rectangle &dirty, const rgb_t *palette, int palette_entries) override;
 
 	private:
 		std::unique_ptr<emu_file> m_mng_file; // handle to the open movie file
@@ -70,6 +70,7 @@ movie_recording::movie_recording(screen_device *screen)
 	, m_frame_period(attotime::zero)
 	, m_next_frame_time(attotime::zero)
 	, m_frame(0)
+	, m_snapshot_serial(0)
 {
 }
 
@@ -87,20 +88,22 @@ movie_recording::~movie_recording()
 //  movie_recording::append_video_frame
 //-------------------------------------------------
 
-bool movie_recording::append_video_frame(bitmap_rgb32 &bitmap, attotime curtime)
+bool movie_recording::append_video_frame(bitmap_rgb32 &bitmap, const rectangle &dirty, attotime curtime)
 {
 	// identify the palette
 	bool has_palette = screen() && screen()->has_palette();
 	const rgb_t *palette = has_palette ? screen()->palette().palette()->entry_list_adjusted() : nullptr;
 	int palette_entries = has_palette ? screen()->palette().entries() : 0;
 
-	// keep appending frames until we're at curtime
+	// keep appending frames until we're at curtime; repeats of the same bitmap have nothing dirty
+	rectangle curdirty = dirty;
 	while (next_frame_time() <= curtime)
 	{
 		// append this bitmap as a single frame
-		if (!append_single_video_frame(bitmap, palette, palette_entries))
+		if (!append_single_video_frame(bitmap, curdirty, palette, palette_entries))
 			return false;
 		m_frame++;
+		curdirty.set(0, -1, 0, -1);
 
 		// advance time
 		set_next_frame_time(next_frame_time() + frame_period());
@@ -208,9 +211,9 @@ bool avi_movie_recording::initialize(running_machine &machine, std::unique_ptr<e
 //  avi_movie_recording::append_single_video_frame
 //-------------------------------------------------
 
-bool avi_movie_recording::append_single_video_frame(bitmap_rgb32 &bitmap, const rgb_t *palette, int palette_entries)
+bool avi_movie_recording::append_single_video_frame(bitmap_rgb32 &bitmap, const rectangle &dirty, const rgb_t *palette, int palette_entries)
 {
-	avi_file::error avierr = m_avi_file->append_video_frame(bitmap);
+	avi_file::error avierr = m_avi_file->append_video_frame(bitmap, dirty);
 	return avierr == avi_file::error::NONE;
 }
 
@@ -278,7 +281,7 @@ bool mng_movie_recording::initialize(std::unique_ptr<emu_file> &&file, bitmap_t
 //  mng_movie_recording::append_single_video_frame
 //-------------------------------------------------
 
-bool mng_movie_recording::append_single_video_frame(bitmap_rgb32 &bitmap, const rgb_t *palette, int palette_entries)
+bool mng_movie_recording::append_single_video_frame(bitmap_rgb32 &bitmap, const rectangle &dirty, const rgb_t *palette, int palette_entries)
 {
 	// set up the text fields in the movie info
 	util::png_info pnginfo;
@@ -51,9 +51,11 @@ public:
 	attotime frame_period()                 { return m_frame_period; }
 	void set_next_frame_time(attotime time) { m_next_frame_time = time; }
 	attotime next_frame_time() const        { return m_next_frame_time; }
+	u64 snapshot_serial() const             { return m_snapshot_serial; }
+	void set_snapshot_serial(u64 serial)    { m_snapshot_serial = serial; }
 
 	// methods
-	bool append_video_frame(bitmap_rgb32 &bitmap, attotime curtime);
+	bool append_video_frame(bitmap_rgb32 &bitmap, const rectangle &dirty, attotime curtime);
 
 	// virtuals
 	virtual bool add_sound_to_recording(const s16 *sound, int numsamples) = 0;
@@ -69,7 +71,7 @@ protected:
 	movie_recording(movie_recording &&) = delete;
 
 	// virtuals
-	virtual bool append_single_video_frame(bitmap_rgb32 &bitmap, const rgb_t *palette, int palette_entries) = 0;
+	virtual bool append_single_video_frame(bitmap_rgb32 &bitmap, const rectangle &dirty, const rgb_t *palette, int palette_entries) = 0;
 
 	// accessors
 	int current_frame() const { return m_frame; }
@@ -80,6 +82,7 @@ private:
 	attotime        m_frame_period;         // duration of movie frame
 	attotime        m_next_frame_time;      // time of next frame
 	int             m_frame;                // current movie frame number
+	u64             m_snapshot_serial;      // serial number of the snapshot bitmap last appended
 };
 
 
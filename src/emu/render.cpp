@@ -57,6 +57,7 @@
 #include "util/xmlfile.h"
 
 #include <algorithm>
+#include <limits>
 
 
 
@@ -167,6 +168,129 @@ inline void normalize_bounds(render_bounds &bounds)
 }
 
 
+//-------------------------------------------------
+//  pixel_extent - return the pixels touched by
+//  a floating-point area, padded by a margin and
+//  clipped to the target
+//-------------------------------------------------
+
+inline rectangle pixel_extent(float x0, float y0, float x1, float y1, float margin, s32 width, s32 height)
+{
+	float const left = std::clamp(std::min(x0, x1) - margin, -1.0f, float(width));
+	float const right = std::clamp(std::max(x0, x1) + margin, -1.0f, float(width));
+	float const top = std::clamp(std::min(y0, y1) - margin, -1.0f, float(height));
+	float const bottom = std::clamp(std::max(y0, y1) + margin, -1.0f, float(height));
+	return rectangle(s32(floorf(left)), s32(ceilf(right)), s32(floorf(top)), s32(ceilf(bottom))) & rectangle(0, width - 1, 0, height - 1);
+}
+
+
+//-------------------------------------------------
+//  primitive_extent - return the pixels a
+//  primitive can touch, including antialiasing
+//  and filtering fringes
+//-------------------------------------------------
+
+inline rectangle primitive_extent(const render_primitive &prim, s32 width, s32 height)
+{
+	float const margin = (prim.type == render_primitive::LINE) ? (prim.width * 0.5f + 2.0f) : 1.0f;
+	return pixel_extent(prim.bounds.x0, prim.bounds.y0, prim.bounds.x1, prim.bounds.y1, margin, width, height);
+}
+
+
+//-------------------------------------------------
+//  texel_extent - map an area of a quad's texture
+//  to the target pixels it can affect
+//-------------------------------------------------
+
+inline rectangle texel_extent(const render_primitive &prim, const rectangle &texels, s32 width, s32 height)
+{
+	const render_texinfo &texture = prim.texture;
+	const render_quad_texuv &texcoords = prim.texcoords;
+
+	// wrapped textures repeat, so any texel can land anywhere
+	float const bwidth = prim.bounds.x1 - prim.bounds.x0;
+	float const bheight = prim.bounds.y1 - prim.bounds.y0;
+	if (PRIMFLAG_GET_TEXWRAP(prim.flags) || bwidth <= 0.0f || bheight <= 0.0f || texture.width == 0 || texture.height == 0)
+		return primitive_extent(prim, width, height);
+
+	// the quad maps target space to texture space with an affine transform; invert it
+	float const dudx = (texcoords.tr.u - texcoords.tl.u) / bwidth;
+	float const dvdx = (texcoords.tr.v - texcoords.tl.v) / bwidth;
+	float const dudy = (texcoords.bl.u - texcoords.tl.u) / bheight;
+	float const dvdy = (texcoords.bl.v - texcoords.tl.v) / bheight;
+	float const det = dudx * dvdy - dudy * dvdx;
+	if (det == 0.0f)
+		return primitive_extent(prim, width, height);
+
+	// widen the area by a texel on each side to cover bilinear filtering
+	float const u[2] = { float(texels.left() - 1) / float(texture.width), float(texels.right() + 2) / float(texture.width) };
+	float const v[2] = { float(texels.top() - 1) / float(texture.height), float(texels.bottom() + 2) / float(texture.height) };
+	float x0 = std::numeric_limits<float>::max(), y0 = x0;
+	float x1 = std::numeric_limits<float>::lowest(), y1 = x1;
+	for (float const curu : u)
+		for (float const curv : v)
+		{
+			float const du = curu - texcoords.tl.u;
+			float const dv = curv - texcoords.tl.v;
+			float const x = prim.bounds.x0 + (dvdy * du - dudy * dv) / det;
+			float const y = prim.bounds.y0 + (dudx * dv - dvdx * du) / det;
+			x0 = std::min(x0, x);
+			x1 = std::max(x1, x);
+			y0 = std::min(y0, y);
+			y1 = std::max(y1, y);
+		}
+	return pixel_extent(x0, y0, x1, y1, 1.0f, width, height) & primitive_extent(prim, width, height);
+}
+
+
+//-------------------------------------------------
+//  add_dirty - grow a dirty rectangle to cover an
+//  area, either of which may be empty
+//-------------------------------------------------
+
+inline void add_dirty(rectangle &dirty, const rectangle &area)
+{
+	if (area.empty())
+		return;
+	if (dirty.empty())
+		dirty = area;
+	else
+		dirty |= area;
+}
+
+
+//-------------------------------------------------
+//  same_placement - return true if two primitives
+//  draw the same way, apart from the texture
+//  contents
+//-------------------------------------------------
+
+inline bool same_placement(const render_primitive &a, const render_primitive &b)
+{
+	if (a.type != b.type || a.flags != b.flags || a.width != b.width || a.container != b.container)
+		return false;
+	if (a.bounds.x0 != b.bounds.x0 || a.bounds.y0 != b.bounds.y0 || a.bounds.x1 != b.bounds.x1 || a.bounds.y1 != b.bounds.y1)
+		return false;
+	if (a.color.a != b.color.a || a.color.r != b.color.r || a.color.g != b.color.g || a.color.b != b.color.b)
+		return false;
+	if ((a.texture.base == nullptr) != (b.texture.base == nullptr))
+		return false;
+	if (a.texture.base == nullptr)
+		return true;
+
+	// textured primitives also need the same mapping and the same image
+	if (memcmp(&a.texcoords, &b.texcoords, sizeof(a.texcoords)) != 0)
+		return false;
+	if (a.texture.width != b.texture.width || a.texture.height != b.texture.height)
+		return false;
+	if (a.texture.palette != b.texture.palette || (a.texture.palette != nullptr && a.texture.palette_seq != b.texture.palette_seq))
+		return false;
+	if (a.texture.content_id != b.texture.content_id)
+		return false;
+	return a.texture.content_id != 0 || (a.texture.base == b.texture.base && a.texture.rowpixels == b.texture.rowpixels);
+}
+
+
 //**************************************************************************
 //  RENDER PRIMITIVE
 //**************************************************************************
@@ -296,11 +420,14 @@ render_texture::render_texture()
 		m_format(TEXFORMAT_ARGB32),
 		m_id(~0ULL),
 		m_old_id(~0ULL),
+		m_content_id(0),
+		m_content_seq(0),
 		m_scaler(nullptr),
 		m_param(nullptr),
 		m_curseq(0)
 {
 	m_sbounds.set(0, -1, 0, -1);
+	m_dirty.set(0, -1, 0, -1);
 	memset(m_scaled, 0, sizeof(m_scaled));
 }
 
@@ -354,6 +481,7 @@ void render_texture::release()
 	m_sbounds.set(0, -1, 0, -1);
 	m_format = TEXFORMAT_ARGB32;
 	m_curseq = 0;
+	m_content_id = 0;
 }
 
 
@@ -373,10 +501,11 @@ void render_texture::set_bitmap(bitmap_t &bitmap, const rectangle &sbounds, text
 	if (&bitmap != m_bitmap && m_bitmap != nullptr)
 		m_manager->invalidate_all(m_bitmap);
 
-	// set the new bitmap/palette
+	// set the new bitmap/palette; the contents are unknown until told otherwise
 	m_bitmap = &bitmap;
 	m_sbounds = sbounds;
 	m_format = format;
+	m_content_id = 0;
 
 	// invalidate all scaled versions
 	for (auto & elem : m_scaled)
@@ -389,6 +518,23 @@ void render_texture::set_bitmap(bitmap_t &bitmap, const rectangle &sbounds, text
 }
 
 
+//-------------------------------------------------
+//  set_contents - identify the contents of the
+//  source bitmap; textures that share an id hold
+//  successive versions of the same image, and
+//  dirty is the area (in bitmap coordinates) that
+//  changed since sequence seq - 1
+//-------------------------------------------------
+
+void render_texture::set_contents(u64 id, u32 seq, const rectangle &dirty)
+{
+	m_content_id = id;
+	m_content_seq = seq;
+	m_dirty = dirty;
+	m_dirty &= m_sbounds;
+}
+
+
 //-------------------------------------------------
 //  hq_scale - generic high quality resampling
 //  scaler
@@ -434,6 +580,12 @@ void render_texture::get_scaled(u32 dwidth, u32 dheight, render_texinfo &texinfo
 		texinfo.height = sheight;
 		// palette will be set later
 		texinfo.seqid = ++m_curseq;
+
+		// pass along what we know about the contents
+		texinfo.content_id = m_content_id;
+		texinfo.content_seq = m_content_seq;
+		texinfo.dirty = m_dirty;
+		texinfo.dirty.offset(-m_sbounds.left(), -m_sbounds.top());
 	}
 	else
 	{
@@ -476,6 +628,7 @@ void render_texture::get_scaled(u32 dwidth, u32 dheight, render_texinfo &texinfo
 			// allocate a new bitmap
 			scaled->bitmap = std::make_unique<bitmap_argb32>(dwidth, dheight);
 			scaled->seqid = ++m_curseq;
+			scaled->content_id = m_manager->alloc_content_id();
 
 			// let the scaler do the work
 			(*m_scaler)(*scaled->bitmap, srcbitmap, m_sbounds, m_param);
@@ -489,6 +642,11 @@ void render_texture::get_scaled(u32 dwidth, u32 dheight, render_texinfo &texinfo
 		texinfo.height = dheight;
 		// palette will be set later
 		texinfo.seqid = scaled->seqid;
+
+		// a scaled bitmap never changes once it has been generated
+		texinfo.content_id = scaled->content_id;
+		texinfo.content_seq = 0;
+		texinfo.dirty.set(0, -1, 0, -1);
 	}
 }
 
@@ -541,6 +699,7 @@ render_container::render_container(render_manager &manager, screen_device *scree
 	, m_screen(screen)
 	, m_overlaybitmap(nullptr)
 	, m_overlaytexture(nullptr)
+	, m_palette_seq(0)
 {
 	// make sure it is empty
 	empty();
@@ -773,6 +932,9 @@ render_container::item &render_container::add_generic(u8 type, float x0, float y
 
 void render_container::recompute_lookups()
 {
+	// anything drawn through the old tables is now stale
+	m_palette_seq++;
+
 	// recompute the 256 entry lookup table
 	for (int i = 0; i < 0x100; i++)
 	{
@@ -825,6 +987,7 @@ void render_container::update_palette()
 	// iterate over dirty items and update them
 	if (dirty != nullptr)
 	{
+		m_palette_seq++;
 		palette_t &palette = m_palclient->palette();
 		const rgb_t *adjusted_palette = palette.entry_list_adjusted();
 
@@ -912,6 +1075,9 @@ template <typename T> render_target::render_target(render_manager &manager, T &&
 	, m_maxtexheight(65536)
 	, m_transform_container(true)
 	, m_external_artwork(false)
+	, m_last_sequence(0)
+	, m_last_width(0)
+	, m_last_height(0)
 {
 	// determine the base layer configuration based on options
 	m_base_layerconfig.set_zoom_to_screen(manager.machine().options().artwork_crop());
@@ -1469,8 +1635,9 @@ render_primitive_list &render_target::get_primitives()
 		add_container_primitives(list, root_xform, ui_xform, m_manager.ui_container(), BLENDMODE_ALPHA);
 	}
 
-	// optimize the list before handing it off
+	// optimize the list and work out what changed before handing it off
 	add_clear_and_optimize_primitive_list(list);
+	compute_dirty(list);
 	list.release_lock();
 	return list;
 }
@@ -2382,6 +2549,7 @@ void render_target::add_container_primitives(render_primitive_list &list, const
 
 					// set the palette
 					prim->texture.palette = curitem.texture()->get_adjusted_palette(container, prim->texture.palette_length);
+					prim->texture.palette_seq = container.palette_seq();
 
 					// determine UV coordinates
 					prim->texcoords = oriented_texcoords[finalorient];
@@ -3087,6 +3255,68 @@ done:
 }
 
 
+//-------------------------------------------------
+//  compute_dirty - work out which pixels of the
+//  target can differ from the previous list, by
+//  pairing up primitives with the previous list;
+//  anything that doesn't line up is assumed to
+//  have changed everywhere it is drawn
+//-------------------------------------------------
+
+void render_target::compute_dirty(render_primitive_list &list)
+{
+	list.m_sequence = ++m_manager.m_list_sequence;
+	list.m_prev_sequence = m_last_sequence;
+	list.m_dirty.set(0, -1, 0, -1);
+
+	bool whole = (m_width != m_last_width) || (m_height != m_last_height);
+	auto last = m_lastprims.cbegin();
+	for (const render_primitive &prim : list)
+	{
+		if (whole)
+			break;
+		if (last == m_lastprims.cend())
+		{
+			whole = true;
+			break;
+		}
+
+		const render_primitive &prev = *last++;
+		if (!same_placement(prev, prim))
+		{
+			// moved or changed appearance; both the old and new positions need redrawing
+			add_dirty(list.m_dirty, primitive_extent(prev, m_width, m_height));
+			add_dirty(list.m_dirty, primitive_extent(prim, m_width, m_height));
+		}
+		else if (prim.texture.base == nullptr)
+		{
+			// identical untextured primitive
+		}
+		else if (prim.texture.content_id == 0 || prim.texture.content_seq != prev.texture.content_seq + 1)
+		{
+			// unknown contents, or we missed an update; skip only if it's the exact same image
+			if (prim.texture.content_id == 0 || prim.texture.content_seq != prev.texture.content_seq)
+				add_dirty(list.m_dirty, primitive_extent(prim, m_width, m_height));
+		}
+		else if (!prim.texture.dirty.empty())
+		{
+			// the next version of the same image; only the changed texels matter
+			add_dirty(list.m_dirty, texel_extent(prim, prim.texture.dirty, m_width, m_height));
+		}
+	}
+	if (whole || last != m_lastprims.cend())
+		list.m_dirty.set(0, m_width - 1, 0, m_height - 1);
+
+	// remember this list for next time
+	m_lastprims.clear();
+	for (const render_primitive &prim : list)
+		m_lastprims.push_back(prim);
+	m_last_sequence = list.m_sequence;
+	m_last_width = m_width;
+	m_last_height = m_height;
+}
+
+
 
 //**************************************************************************
 //  CORE IMPLEMENTATION
@@ -3101,6 +3331,8 @@ render_manager::render_manager(running_machine &machine)
 	, m_ui_target(nullptr)
 	, m_live_textures(0)
 	, m_texture_id(0)
+	, m_content_id(0)
+	, m_list_sequence(0)
 	, m_ui_container(std::make_unique<render_container>(*this))
 {
 	// register callbacks
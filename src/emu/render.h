@@ -154,6 +154,13 @@ typedef void (*texture_scaler_func)(bitmap_argb32 &dest, bitmap_argb32 &source,
 // render_texinfo - texture information
 struct render_texinfo
 {
+	// true if both describe the same version of a tracked image with the same palette contents
+	bool same_contents(const render_texinfo &that) const
+	{
+		return content_id != 0 && content_id == that.content_id && content_seq == that.content_seq &&
+				palette == that.palette && palette_seq == that.palette_seq;
+	}
+
 	void *              base;               // base of the data
 	u32                 rowpixels;          // pixels per row
 	u32                 width;              // width of the image
@@ -163,6 +170,10 @@ struct render_texinfo
 	u64                 old_id;             // previously allocated id, if applicable
 	const rgb_t *       palette;            // palette for PALETTE16 textures, bcg lookup table for RGB32/YUY16
 	u32                 palette_length;
+	u32                 palette_seq;        // sequence number of the palette contents
+	u64                 content_id;         // identifies the image across textures (0 if untracked)
+	u32                 content_seq;        // sequence number of the image contents
+	rectangle           dirty;              // texels changed since content_seq - 1, relative to base
 };
 
 
@@ -273,6 +284,11 @@ public:
 	void add_reference(void *refptr);
 	bool has_reference(void *refptr) const;
 
+	// dirty tracking
+	u64 sequence() const { return m_sequence; }
+	u64 previous_sequence() const { return m_prev_sequence; }
+	const rectangle &dirty() const { return m_dirty; }
+
 private:
 	// helpers for our friends to manipulate the list
 	render_primitive *alloc(render_primitive::primitive_type type);
@@ -296,6 +312,10 @@ private:
 	fixed_allocator<render_primitive> m_primitive_allocator;// allocator for primitives
 	fixed_allocator<reference> m_reference_allocator;       // allocator for references
 
+	u64                      m_sequence = 0;                // unique number identifying this list
+	u64                      m_prev_sequence = 0;           // number of the list dirty is relative to
+	rectangle                m_dirty;                       // target pixels that differ from that list
+
 	std::recursive_mutex     m_lock;                             // lock to protect list accesses
 };
 
@@ -331,6 +351,9 @@ public:
 	// set a unique identifier
 	void set_id(u64 id) { m_old_id = m_id; m_id = id; }
 
+	// describe the bitmap contents for dirty tracking
+	void set_contents(u64 id, u32 seq, const rectangle &dirty);
+
 	// generic high-quality bitmap scaler
 	static void hq_scale(bitmap_argb32 &dest, bitmap_argb32 &source, const rectangle &sbounds, void *param);
 
@@ -346,6 +369,7 @@ private:
 	{
 		std::unique_ptr<bitmap_argb32>  bitmap;     // final bitmap
 		u32                             seqid;      // sequence number
+		u64                             content_id; // contents identifier
 	};
 
 	// internal state
@@ -356,6 +380,9 @@ private:
 	texture_format      m_format;                   // format of the texture data
 	u64                 m_id;                       // unique id to pass to osd
 	u64                 m_old_id;                   // previous id, if applicable
+	u64                 m_content_id;               // contents identifier (0 if untracked)
+	u32                 m_content_seq;              // contents sequence number
+	rectangle           m_dirty;                    // area of the bitmap changed since m_content_seq - 1
 
 	// scaling state (ARGB32 only)
 	texture_scaler_func m_scaler;                   // scaling callback
@@ -426,6 +453,7 @@ public:
 	u8 apply_brightness_contrast_gamma(u8 value);
 	float apply_brightness_contrast_gamma_fp(float value);
 	const rgb_t *bcg_lookup_table(int texformat, u32 &out_length, palette_t *palette = nullptr);
+	u32 palette_seq() const { return m_palette_seq; }
 
 private:
 	// an item describes a high level primitive that is added to a container
@@ -479,6 +507,7 @@ private:
 	std::unique_ptr<palette_client> m_palclient;    // client to the screen palette
 	std::vector<rgb_t>      m_bcglookup;            // copy of screen palette with bcg adjustment
 	rgb_t                   m_bcglookup256[0x400];  // lookup table for brightness/contrast/gamma
+	u32                     m_palette_seq;          // bumped whenever either lookup table changes
 };
 
 
@@ -592,6 +621,9 @@ private:
 	void add_clear_extents(render_primitive_list &list);
 	void add_clear_and_optimize_primitive_list(render_primitive_list &list);
 
+	// dirty tracking
+	void compute_dirty(render_primitive_list &list);
+
 	// constants
 	static constexpr int NUM_PRIMLISTS = 3;
 	static constexpr int MAX_CLEAR_EXTENTS = 1000;
@@ -628,6 +660,10 @@ private:
 	bool                    m_transform_container;      // determines whether the screen container is transformed by the core renderer,
 														// otherwise the respective render API will handle the transformation (scale, offset)
 	bool                    m_external_artwork;         // external artwork was loaded (driver file or override)
+	std::vector<render_primitive> m_lastprims;          // primitives of the previous list, for dirty tracking
+	u64                     m_last_sequence;            // sequence number of the previous list
+	s32                     m_last_width;               // width of the previous list
+	s32                     m_last_height;              // height of the previous list
 };
 
 
@@ -666,6 +702,9 @@ public:
 	// UI containers
 	render_container &ui_container() const { assert(m_ui_container != nullptr); return *m_ui_container; }
 
+	// dirty tracking
+	u64 alloc_content_id() { return ++m_content_id; }
+
 	// textures
 	render_texture *texture_alloc(texture_scaler_func scaler = nullptr, void *param = nullptr);
 	void texture_free(render_texture *texture);
@@ -694,6 +733,8 @@ private:
 	// texture lists
 	u32                             m_live_textures;    // number of live textures
 	u64                             m_texture_id;       // rolling texture ID counter
+	u64                             m_content_id;       // rolling texture contents ID counter
+	u64                             m_list_sequence;    // rolling primitive list sequence counter
 	fixed_allocator<render_texture> m_texture_allocator;// texture allocator
 
 	// containers for the UI and for screens
@@ -14,8 +14,24 @@
 #include "video/rgbutil.h"
 #include "render.h"
 
+#include <algorithm>
+#include <type_traits>
 
-template <typename PixelType, int SrcShiftR, int SrcShiftG, int SrcShiftB, int DstShiftR, int DstShiftG, int DstShiftB, bool NoDestRead = false, bool BilinearFilter = false>
+// use SSE2 span kernels where it can be assumed, as rgbutil.h does
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define MAME_RENDERSW_SSE2
+#include <emmintrin.h>
+
+// the blend kernels also have AVX2 versions, compiled for AVX2 whatever the
+// build targets and only used once host_has_avx2() says they can be
+#if defined(__GNUC__) || defined(_MSC_VER)
+#define MAME_RENDERSW_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+
+template <typename PixelType, int SrcShiftR, int SrcShiftG, int SrcShiftB, int DstShiftR, int DstShiftG, int DstShiftB, bool NoDestRead = false, bool BilinearFilter = false, bool Vectorize = true>
 class software_renderer
 {
 private:
@@ -28,6 +44,32 @@ private:
 		s32 endx, endy;
 	};
 
+	struct band_data
+	{
+		render_primitive_list const *primlist;
+		PixelType *dstdata;
+		s32 width, height;
+		s32 top, bottom;
+		u32 pitch;
+	};
+
+	struct cosine_table
+	{
+		cosine_table()
+		{
+			for (int entry = 0; entry <= 2048; entry++)
+				value[entry] = int(double(1.0 / cos(atan(double(entry) / 2048.0))) * 0x10000000 + 0.5);
+		}
+
+		u32 value[2049];
+	};
+
+	// span kernels only handle 32-bit destinations in the standard format; the
+	// per-pixel loops remain as the reference implementation for everything else
+	static constexpr bool VectorKernels = Vectorize && std::is_same_v<PixelType, u32> &&
+			(SrcShiftR == 0) && (SrcShiftG == 0) && (SrcShiftB == 0) && (DstShiftR == 16) && (DstShiftG == 8) && (DstShiftB == 0);
+	static constexpr s32 SPAN_CHUNK = 64;
+
 	// internal helpers
 	static constexpr bool is_opaque(float alpha) { return (alpha >= (NoDestRead ? 0.5f : 1.0f)); }
 	static constexpr bool is_transparent(float alpha) { return (alpha < (NoDestRead ? 0.5f : 0.0001f)); }
@@ -412,13 +454,16 @@ private:
 
 
 	//-------------------------------------------------
-	//  draw_line - draw a line or point
+	//  draw_line - draw the part of a line or point
+	//  that falls within rows top to bottom - 1
 	//-------------------------------------------------
 
-	static void draw_line(render_primitive const &prim, PixelType *dstdata, s32 width, s32 height, u32 pitch)
+	static void draw_line(render_primitive const &prim, PixelType *dstdata, s32 width, s32 top, s32 bottom, u32 pitch)
 	{
-		// internal tables
-		static u32 s_cosine_table[2049];
+		// skip lines that can't touch any of the rows we're drawing
+		float const margin = std::max(prim.width, 1.0f) * 2.0f + 2.0f;
+		if ((std::max(prim.bounds.y0, prim.bounds.y1) + margin < float(top)) || (std::min(prim.bounds.y0, prim.bounds.y1) - margin >= float(bottom)))
+			return;
 
 		// compute the start/end coordinates
 		int x1 = int(prim.bounds.x0 * 65536.0f);
@@ -432,9 +477,7 @@ private:
 		if (PRIMFLAG_GET_ANTIALIAS(prim.flags))
 		{
 			// build up the cosine table if we haven't yet
-			if (s_cosine_table[0] == 0)
-				for (int entry = 0; entry <= 2048; entry++)
-					s_cosine_table[entry] = int(double(1.0 / cos(atan(double(entry) / 2048.0))) * 0x10000000 + 0.5);
+			static cosine_table const s_cosine_table;
 
 			int beam = prim.width * 65536.0f;
 			if (beam < 0x00010000)
@@ -452,7 +495,7 @@ private:
 					dy--;
 				x1 >>= 16;
 				int xx = x2 >> 16;
-				int bwidth = mul_32x32_hi(beam << 4, s_cosine_table[abs(sy) >> 5]);
+				int bwidth = mul_32x32_hi(beam << 4, s_cosine_table.value[abs(sy) >> 5]);
 				y1 -= bwidth >> 1; // start back half the diameter
 				for (;;)
 				{
@@ -460,7 +503,7 @@ private:
 					{
 						dx = bwidth;    // init diameter of beam
 						dy = y1 >> 16;
-						if (dy >= 0 && dy < height)
+						if (dy >= top && dy < bottom)
 							draw_aa_pixel(dstdata, pitch, x1, dy, apply_intensity(0xff & (~y1 >> 8), col));
 						dy++;
 						dx -= 0x10000 - (0xffff & y1); // take off amount plotted
@@ -468,11 +511,11 @@ private:
 						dx >>= 16;                   // adjust to pixel (solid) count
 						while (dx--)                 // plot rest of pixels
 						{
-							if (dy >= 0 && dy < height)
+							if (dy >= top && dy < bottom)
 								draw_aa_pixel(dstdata, pitch, x1, dy, col);
 							dy++;
 						}
-						if (dy >= 0 && dy < height)
+						if (dy >= top && dy < bottom)
 							draw_aa_pixel(dstdata, pitch, x1, dy, apply_intensity(a1,col));
 					}
 					if (x1 == xx) break;
@@ -488,11 +531,11 @@ private:
 					dx--;
 				y1 >>= 16;
 				int yy = y2 >> 16;
-				int bwidth = mul_32x32_hi(beam << 4,s_cosine_table[abs(sx) >> 5]);
+				int bwidth = mul_32x32_hi(beam << 4,s_cosine_table.value[abs(sx) >> 5]);
 				x1 -= bwidth >> 1; // start back half the width
 				for (;;)
 				{
-					if (y1 >= 0 && y1 < height)
+					if (y1 >= top && y1 < bottom)
 					{
 						dy = bwidth;    // calc diameter of beam
 						dx = x1 >> 16;
@@ -535,7 +578,7 @@ private:
 			{
 				for (;;)
 				{
-					if (x1 >= 0 && x1 < width && y1 >= 0 && y1 < height)
+					if (x1 >= 0 && x1 < width && y1 >= top && y1 < bottom)
 						draw_aa_pixel(dstdata, pitch, x1, y1, col);
 					if (x1 == x2) break;
 					x1 += sx;
@@ -551,7 +594,7 @@ private:
 			{
 				for (;;)
 				{
-					if (x1 >= 0 && x1 < width && y1 >= 0 && y1 < height)
+					if (x1 >= 0 && x1 < width && y1 >= top && y1 < bottom)
 						draw_aa_pixel(dstdata, pitch, x1, y1, col);
 					if (y1 == y2) break;
 					y1 += sy;
@@ -573,10 +616,11 @@ private:
 	//**************************************************************************
 
 	//-------------------------------------------------
-	//  draw_rect - draw a solid rectangle
+	//  draw_rect - draw the part of a solid rectangle
+	//  that falls within rows top to bottom - 1
 	//-------------------------------------------------
 
-	static void draw_rect(render_primitive const &prim, PixelType *dstdata, s32 width, s32 height, u32 pitch)
+	static void draw_rect(render_primitive const &prim, PixelType *dstdata, s32 width, s32 top, s32 bottom, u32 pitch)
 	{
 		render_bounds const fpos = prim.bounds;
 		assert(fpos.x0 <= fpos.x1);
@@ -584,9 +628,9 @@ private:
 
 		// clamp to integers and ensure we fit
 		s32 const startx = std::clamp<s32>(round_nearest(fpos.x0), 0, width);
-		s32 const starty = std::clamp<s32>(round_nearest(fpos.y0), 0, height);
+		s32 const starty = std::clamp<s32>(round_nearest(fpos.y0), top, bottom);
 		s32 const endx = std::clamp<s32>(round_nearest(fpos.x1), 0, width);
-		s32 const endy = std::clamp<s32>(round_nearest(fpos.y1), 0, height);
+		s32 const endy = std::clamp<s32>(round_nearest(fpos.y1), top, bottom);
 
 		// bail if nothing left
 		if ((startx > endx) || (starty > endy))
@@ -653,6 +697,347 @@ private:
 	}
 
 
+	//**************************************************************************
+	//  SPAN KERNELS
+	//**************************************************************************
+
+	//-------------------------------------------------
+	//  fetch_span_argb32 - get a run of texels from
+	//  a 32bpp source, pointing straight into the
+	//  texture when no resampling is needed
+	//-------------------------------------------------
+
+	template <bool Wrap>
+	static u32 const *fetch_span_argb32(render_texinfo const &texture, u32 *buffer, s32 count, s32 &curu, s32 &curv, s32 dudx, s32 dvdx)
+	{
+		if constexpr (!Wrap && !BilinearFilter)
+		{
+			s32 const u = curu >> 16;
+			s32 const v = curv >> 16;
+			if ((dudx == 0x10000) && (dvdx == 0) && (u >= 0) && ((u + count) <= s32(texture.width)) && (v >= 0) && (v < s32(texture.height)))
+			{
+				curu += count * dudx;
+				return reinterpret_cast<u32 const *>(texture.base) + (v * texture.rowpixels) + u;
+			}
+		}
+
+		for (s32 x = 0; x < count; x++)
+		{
+			buffer[x] = get_texel_argb32<Wrap>(texture, curu, curv);
+			curu += dudx;
+			curv += dvdx;
+		}
+		return buffer;
+	}
+
+
+	//-------------------------------------------------
+	//  fetch_span_palette16 - get a run of looked-up
+	//  texels from a palettized 16bpp source
+	//-------------------------------------------------
+
+	static u32 const *fetch_span_palette16(render_texinfo const &texture, u32 *buffer, s32 count, s32 &curu, s32 &curv, s32 dudx, s32 dvdx)
+	{
+		if constexpr (!BilinearFilter)
+		{
+			if ((dudx == 0x10000) && (dvdx == 0))
+			{
+				rgb_t const *const palbase = texture.palette;
+				u16 const *const texbase = reinterpret_cast<u16 const *>(texture.base) + (curv >> 16) * texture.rowpixels + (curu >> 16);
+				for (s32 x = 0; x < count; x++)
+					buffer[x] = palbase[texbase[x]];
+				curu += count * dudx;
+				return buffer;
+			}
+		}
+
+		for (s32 x = 0; x < count; x++)
+		{
+			buffer[x] = get_texel_palette16(texture, curu, curv);
+			curu += dudx;
+			curv += dvdx;
+		}
+		return buffer;
+	}
+
+
+	// the kernels are public so they can be checked directly; with Vectorize
+	// false they're just the scalar loops, and avx2 selects the AVX2 versions
+	// where they're compiled, which draw_span does when the host supports them
+public:
+	//-------------------------------------------------
+	//  copy_span - store texels that are already in
+	//  the destination format
+	//-------------------------------------------------
+
+	static void copy_span(u32 *dest, u32 const *src, s32 count, bool avx2)
+	{
+		std::copy_n(src, count, dest);
+	}
+
+
+	//-------------------------------------------------
+	//  alpha_span - blend texels over the
+	//  destination using their own alpha
+	//-------------------------------------------------
+
+	static void alpha_span(u32 *dest, u32 const *src, s32 count, bool avx2)
+	{
+		s32 x = 0;
+
+#if defined(MAME_RENDERSW_AVX2)
+		if constexpr (VectorKernels && !NoDestRead)
+		{
+			if (avx2)
+				x = alpha_span_avx2(dest, src, count);
+		}
+#endif
+#if defined(MAME_RENDERSW_SSE2)
+		if constexpr (VectorKernels && !NoDestRead)
+		{
+			__m128i const zero = _mm_setzero_si128();
+			__m128i const rgbmask = _mm_set1_epi32(0x00ffffff);
+			__m128i const full = _mm_set1_epi32(0x100);
+			for ( ; (x + 4) <= count; x += 4)
+			{
+				__m128i const spix = _mm_loadu_si128(reinterpret_cast<__m128i const *>(&src[x]));
+				__m128i const dpix = _mm_loadu_si128(reinterpret_cast<__m128i const *>(&dest[x]));
+
+				// pair each pixel's alpha with its inverse so one multiply-add blends a component
+				__m128i const ta = _mm_srli_epi32(spix, 24);
+				__m128i const factors = _mm_or_si128(ta, _mm_slli_epi32(_mm_sub_epi32(full, ta), 16));
+
+				// interleave source and destination components and blend
+				__m128i const slo = _mm_unpacklo_epi8(spix, zero);
+				__m128i const shi = _mm_unpackhi_epi8(spix, zero);
+				__m128i const dlo = _mm_unpacklo_epi8(dpix, zero);
+				__m128i const dhi = _mm_unpackhi_epi8(dpix, zero);
+				__m128i const p0 = _mm_srli_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(slo, dlo), _mm_shuffle_epi32(factors, 0x00)), 8);
+				__m128i const p1 = _mm_srli_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(slo, dlo), _mm_shuffle_epi32(factors, 0x55)), 8);
+				__m128i const p2 = _mm_srli_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(shi, dhi), _mm_shuffle_epi32(factors, 0xaa)), 8);
+				__m128i const p3 = _mm_srli_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(shi, dhi), _mm_shuffle_epi32(factors, 0xff)), 8);
+				__m128i const result = _mm_and_si128(_mm_packus_epi16(_mm_packs_epi32(p0, p1), _mm_packs_epi32(p2, p3)), rgbmask);
+
+				// leave the destination untouched under fully transparent texels
+				__m128i const keep = _mm_cmpeq_epi32(ta, zero);
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(&dest[x]), _mm_or_si128(_mm_and_si128(keep, dpix), _mm_andnot_si128(keep, result)));
+			}
+		}
+#endif
+
+		for ( ; x < count; x++)
+		{
+			u32 const pix = src[x];
+			u32 const ta = pix >> 24;
+			if (ta != 0)
+			{
+				u32 const dpix = NoDestRead ? 0 : dest[x];
+				u32 const invta = 0x100 - ta;
+				u32 const r = (source32_r(pix) * ta + dest_r(dpix) * invta) >> 8;
+				u32 const g = (source32_g(pix) * ta + dest_g(dpix) * invta) >> 8;
+				u32 const b = (source32_b(pix) * ta + dest_b(dpix) * invta) >> 8;
+				dest[x] = dest_assemble_rgb(r, g, b);
+			}
+		}
+	}
+
+
+	//-------------------------------------------------
+	//  add_span - add texels to the destination with
+	//  saturation
+	//-------------------------------------------------
+
+	static void add_span(u32 *dest, u32 const *src, s32 count, bool avx2)
+	{
+		s32 x = 0;
+
+#if defined(MAME_RENDERSW_AVX2)
+		if constexpr (VectorKernels && !NoDestRead)
+		{
+			if (avx2)
+				x = add_span_avx2(dest, src, count);
+		}
+#endif
+#if defined(MAME_RENDERSW_SSE2)
+		if constexpr (VectorKernels && !NoDestRead)
+		{
+			__m128i const rgbmask = _mm_set1_epi32(0x00ffffff);
+			for ( ; (x + 4) <= count; x += 4)
+			{
+				__m128i const spix = _mm_loadu_si128(reinterpret_cast<__m128i const *>(&src[x]));
+				__m128i const dpix = _mm_loadu_si128(reinterpret_cast<__m128i const *>(&dest[x]));
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(&dest[x]), _mm_and_si128(_mm_adds_epu8(spix, dpix), rgbmask));
+			}
+		}
+#endif
+
+		for ( ; x < count; x++)
+		{
+			u32 const pix = src[x];
+			u32 const dpix = NoDestRead ? 0 : dest[x];
+			u32 const r = std::min<u32>(source32_r(pix) + dest_r(dpix), 0xff);
+			u32 const g = std::min<u32>(source32_g(pix) + dest_g(dpix), 0xff);
+			u32 const b = std::min<u32>(source32_b(pix) + dest_b(dpix), 0xff);
+			dest[x] = dest_assemble_rgb(r, g, b);
+		}
+	}
+
+
+	//-------------------------------------------------
+	//  alpha_add_span - scale texels by their own
+	//  alpha and add them to the destination with
+	//  saturation
+	//-------------------------------------------------
+
+	static void alpha_add_span(u32 *dest, u32 const *src, s32 count, bool avx2)
+	{
+		s32 x = 0;
+
+#if defined(MAME_RENDERSW_AVX2)
+		if constexpr (VectorKernels && !NoDestRead)
+		{
+			if (avx2)
+				x = alpha_add_span_avx2(dest, src, count);
+		}
+#endif
+#if defined(MAME_RENDERSW_SSE2)
+		if constexpr (VectorKernels && !NoDestRead)
+		{
+			__m128i const zero = _mm_setzero_si128();
+			__m128i const rgbmask = _mm_set1_epi32(0x00ffffff);
+			for ( ; (x + 4) <= count; x += 4)
+			{
+				__m128i const spix = _mm_loadu_si128(reinterpret_cast<__m128i const *>(&src[x]));
+				__m128i const dpix = _mm_loadu_si128(reinterpret_cast<__m128i const *>(&dest[x]));
+
+				// spread each pixel's alpha across its four 16-bit components
+				__m128i const ta = _mm_srli_epi32(spix, 24);
+				__m128i const ta16 = _mm_or_si128(ta, _mm_slli_epi32(ta, 16));
+				__m128i const talo = _mm_unpacklo_epi32(ta16, ta16);
+				__m128i const tahi = _mm_unpackhi_epi32(ta16, ta16);
+
+				// scale the source, then add with saturation
+				__m128i const slo = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(spix, zero), talo), 8);
+				__m128i const shi = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(spix, zero), tahi), 8);
+				__m128i const result = _mm_and_si128(_mm_adds_epu8(_mm_packus_epi16(slo, shi), dpix), rgbmask);
+
+				// leave the destination untouched under fully transparent texels
+				__m128i const keep = _mm_cmpeq_epi32(ta, zero);
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(&dest[x]), _mm_or_si128(_mm_and_si128(keep, dpix), _mm_andnot_si128(keep, result)));
+			}
+		}
+#endif
+
+		for ( ; x < count; x++)
+		{
+			u32 const pix = src[x];
+			u32 const ta = pix >> 24;
+			if (ta != 0)
+			{
+				u32 const dpix = NoDestRead ? 0 : dest[x];
+				u32 const r = std::min<u32>(((source32_r(pix) * ta) >> 8) + dest_r(dpix), 0xff);
+				u32 const g = std::min<u32>(((source32_g(pix) * ta) >> 8) + dest_g(dpix), 0xff);
+				u32 const b = std::min<u32>(((source32_b(pix) * ta) >> 8) + dest_b(dpix), 0xff);
+				dest[x] = dest_assemble_rgb(r, g, b);
+			}
+		}
+	}
+
+
+#if defined(MAME_RENDERSW_AVX2)
+	//-------------------------------------------------
+	//  alpha_span_avx2/add_span_avx2/
+	//  alpha_add_span_avx2 - the SSE2 kernels eight
+	//  pixels at a time; unpacking and packing work
+	//  within 128-bit lanes, so each lane follows
+	//  the SSE2 steps exactly; they return the number
+	//  of pixels handled
+	//-------------------------------------------------
+
+	ATTR_TARGET_AVX2 static s32 alpha_span_avx2(u32 *dest, u32 const *src, s32 count)
+	{
+		__m256i const zero = _mm256_setzero_si256();
+		__m256i const rgbmask = _mm256_set1_epi32(0x00ffffff);
+		__m256i const full = _mm256_set1_epi32(0x100);
+		s32 x = 0;
+		for ( ; (x + 8) <= count; x += 8)
+		{
+			__m256i const spix = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&src[x]));
+			__m256i const dpix = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&dest[x]));
+			__m256i const ta = _mm256_srli_epi32(spix, 24);
+			__m256i const factors = _mm256_or_si256(ta, _mm256_slli_epi32(_mm256_sub_epi32(full, ta), 16));
+			__m256i const slo = _mm256_unpacklo_epi8(spix, zero);
+			__m256i const shi = _mm256_unpackhi_epi8(spix, zero);
+			__m256i const dlo = _mm256_unpacklo_epi8(dpix, zero);
+			__m256i const dhi = _mm256_unpackhi_epi8(dpix, zero);
+			__m256i const p0 = _mm256_srli_epi32(_mm256_madd_epi16(_mm256_unpacklo_epi16(slo, dlo), _mm256_shuffle_epi32(factors, 0x00)), 8);
+			__m256i const p1 = _mm256_srli_epi32(_mm256_madd_epi16(_mm256_unpackhi_epi16(slo, dlo), _mm256_shuffle_epi32(factors, 0x55)), 8);
+			__m256i const p2 = _mm256_srli_epi32(_mm256_madd_epi16(_mm256_unpacklo_epi16(shi, dhi), _mm256_shuffle_epi32(factors, 0xaa)), 8);
+			__m256i const p3 = _mm256_srli_epi32(_mm256_madd_epi16(_mm256_unpackhi_epi16(shi, dhi), _mm256_shuffle_epi32(factors, 0xff)), 8);
+			__m256i const result = _mm256_and_si256(_mm256_packus_epi16(_mm256_packs_epi32(p0, p1), _mm256_packs_epi32(p2, p3)), rgbmask);
+			__m256i const keep = _mm256_cmpeq_epi32(ta, zero);
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(&dest[x]), _mm256_blendv_epi8(result, dpix, keep));
+		}
+		return x;
+	}
+
+	ATTR_TARGET_AVX2 static s32 add_span_avx2(u32 *dest, u32 const *src, s32 count)
+	{
+		__m256i const rgbmask = _mm256_set1_epi32(0x00ffffff);
+		s32 x = 0;
+		for ( ; (x + 8) <= count; x += 8)
+		{
+			__m256i const spix = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&src[x]));
+			__m256i const dpix = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&dest[x]));
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(&dest[x]), _mm256_and_si256(_mm256_adds_epu8(spix, dpix), rgbmask));
+		}
+		return x;
+	}
+
+	ATTR_TARGET_AVX2 static s32 alpha_add_span_avx2(u32 *dest, u32 const *src, s32 count)
+	{
+		__m256i const zero = _mm256_setzero_si256();
+		__m256i const rgbmask = _mm256_set1_epi32(0x00ffffff);
+		s32 x = 0;
+		for ( ; (x + 8) <= count; x += 8)
+		{
+			__m256i const spix = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&src[x]));
+			__m256i const dpix = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&dest[x]));
+			__m256i const ta = _mm256_srli_epi32(spix, 24);
+			__m256i const ta16 = _mm256_or_si256(ta, _mm256_slli_epi32(ta, 16));
+			__m256i const talo = _mm256_unpacklo_epi32(ta16, ta16);
+			__m256i const tahi = _mm256_unpackhi_epi32(ta16, ta16);
+			__m256i const slo = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(spix, zero), talo), 8);
+			__m256i const shi = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(spix, zero), tahi), 8);
+			__m256i const result = _mm256_and_si256(_mm256_adds_epu8(_mm256_packus_epi16(slo, shi), dpix), rgbmask);
+			__m256i const keep = _mm256_cmpeq_epi32(ta, zero);
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(&dest[x]), _mm256_blendv_epi8(result, dpix, keep));
+		}
+		return x;
+	}
+#endif
+
+private:
+	//-------------------------------------------------
+	//  draw_span - fetch a row of texels in chunks
+	//  and hand each chunk to a span kernel
+	//-------------------------------------------------
+
+	template <typename Fetch, typename Kernel>
+	static void draw_span(render_texinfo const &texture, u32 *dest, s32 count, s32 curu, s32 curv, quad_setup_data const &setup, Fetch fetch, Kernel kernel)
+	{
+		bool const avx2 = host_has_avx2();
+		u32 texels[SPAN_CHUNK];
+		while (count > 0)
+		{
+			s32 const chunk = std::min(count, SPAN_CHUNK);
+			kernel(dest, fetch(texture, texels, chunk, curu, curv, setup.dudx, setup.dvdx), chunk, avx2);
+			dest += chunk;
+			count -= chunk;
+		}
+	}
+
+
 	//**************************************************************************
 	//  16-BIT PALETTE RASTERIZERS
 	//**************************************************************************
@@ -678,13 +1063,20 @@ private:
 				s32 curu = setup.startu + (y - setup.starty) * setup.dudy;
 				s32 curv = setup.startv + (y - setup.starty) * setup.dvdy;
 
-				// loop over cols
-				for (s32 x = setup.startx; x < setup.endx; x++)
+				if constexpr (VectorKernels)
 				{
-					u32 const pix = get_texel_palette16(prim.texture, curu, curv);
-					*dest++ = source32_to_dest(pix);
-					curu += setup.dudx;
-					curv += setup.dvdx;
+					draw_span(prim.texture, dest, setup.endx - setup.startx, curu, curv, setup, &fetch_span_palette16, &copy_span);
+				}
+				else
+				{
+					// loop over cols
+					for (s32 x = setup.startx; x < setup.endx; x++)
+					{
+						u32 const pix = get_texel_palette16(prim.texture, curu, curv);
+						*dest++ = source32_to_dest(pix);
+						curu += setup.dudx;
+						curv += setup.dvdx;
+					}
 				}
 			}
 		}
@@ -1037,13 +1429,20 @@ private:
 				{
 					// no lookup case
 
-					// loop over cols
-					for (s32 x = setup.startx; x < setup.endx; x++)
+					if constexpr (VectorKernels)
 					{
-						u32 const pix = get_texel_rgb32<Wrap>(prim.texture, curu, curv);
-						*dest++ = source32_to_dest(pix);
-						curu += setup.dudx;
-						curv += setup.dvdx;
+						draw_span(prim.texture, dest, setup.endx - setup.startx, curu, curv, setup, &fetch_span_argb32<Wrap>, &copy_span);
+					}
+					else
+					{
+						// loop over cols
+						for (s32 x = setup.startx; x < setup.endx; x++)
+						{
+							u32 const pix = get_texel_rgb32<Wrap>(prim.texture, curu, curv);
+							*dest++ = source32_to_dest(pix);
+							curu += setup.dudx;
+							curv += setup.dvdx;
+						}
 					}
 				}
 				else
@@ -1204,20 +1603,27 @@ private:
 				{
 					// no lookup case
 
-					// loop over cols
-					for (s32 x = setup.startx; x < setup.endx; x++)
+					if constexpr (VectorKernels)
 					{
-						u32 const pix = get_texel_argb32<Wrap>(prim.texture, curu, curv);
-						u32 const dpix = NoDestRead ? 0 : *dest;
-						u32 r = source32_r(pix) + dest_r(dpix);
-						u32 g = source32_g(pix) + dest_g(dpix);
-						u32 b = source32_b(pix) + dest_b(dpix);
-						r = (r | -(r >> (8 - SrcShiftR))) & (0xff >> SrcShiftR);
-						g = (g | -(g >> (8 - SrcShiftG))) & (0xff >> SrcShiftG);
-						b = (b | -(b >> (8 - SrcShiftB))) & (0xff >> SrcShiftB);
-						*dest++ = dest_assemble_rgb(r, g, b);
-						curu += setup.dudx;
-						curv += setup.dvdx;
+						draw_span(prim.texture, dest, setup.endx - setup.startx, curu, curv, setup, &fetch_span_argb32<Wrap>, &add_span);
+					}
+					else
+					{
+						// loop over cols
+						for (s32 x = setup.startx; x < setup.endx; x++)
+						{
+							u32 const pix = get_texel_argb32<Wrap>(prim.texture, curu, curv);
+							u32 const dpix = NoDestRead ? 0 : *dest;
+							u32 r = source32_r(pix) + dest_r(dpix);
+							u32 g = source32_g(pix) + dest_g(dpix);
+							u32 b = source32_b(pix) + dest_b(dpix);
+							r = (r | -(r >> (8 - SrcShiftR))) & (0xff >> SrcShiftR);
+							g = (g | -(g >> (8 - SrcShiftG))) & (0xff >> SrcShiftG);
+							b = (b | -(b >> (8 - SrcShiftB))) & (0xff >> SrcShiftB);
+							*dest++ = dest_assemble_rgb(r, g, b);
+							curu += setup.dudx;
+							curv += setup.dvdx;
+						}
 					}
 				}
 				else
@@ -1453,24 +1859,31 @@ private:
 				{
 					// no lookup case
 
-					// loop over cols
-					for (s32 x = setup.startx; x < setup.endx; x++)
+					if constexpr (VectorKernels)
 					{
-						u32 const pix = get_texel_argb32<Wrap>(prim.texture, curu, curv);
-						u32 const ta = pix >> 24;
-						if (ta != 0)
+						draw_span(prim.texture, dest, setup.endx - setup.startx, curu, curv, setup, &fetch_span_argb32<Wrap>, &alpha_span);
+					}
+					else
+					{
+						// loop over cols
+						for (s32 x = setup.startx; x < setup.endx; x++)
 						{
-							u32 const dpix = NoDestRead ? 0 : *dest;
-							u32 const invta = 0x100 - ta;
-							u32 const r = (source32_r(pix) * ta + dest_r(dpix) * invta) >> 8;
-							u32 const g = (source32_g(pix) * ta + dest_g(dpix) * invta) >> 8;
-							u32 const b = (source32_b(pix) * ta + dest_b(dpix) * invta) >> 8;
-
-							*dest = dest_assemble_rgb(r, g, b);
+							u32 const pix = get_texel_argb32<Wrap>(prim.texture, curu, curv);
+							u32 const ta = pix >> 24;
+							if (ta != 0)
+							{
+								u32 const dpix = NoDestRead ? 0 : *dest;
+								u32 const invta = 0x100 - ta;
+								u32 const r = (source32_r(pix) * ta + dest_r(dpix) * invta) >> 8;
+								u32 const g = (source32_g(pix) * ta + dest_g(dpix) * invta) >> 8;
+								u32 const b = (source32_b(pix) * ta + dest_b(dpix) * invta) >> 8;
+
+								*dest = dest_assemble_rgb(r, g, b);
+							}
+							dest++;
+							curu += setup.dudx;
+							curv += setup.dvdx;
 						}
-						dest++;
-						curu += setup.dudx;
-						curv += setup.dvdx;
 					}
 				}
 				else
@@ -1597,25 +2010,32 @@ private:
 				{
 					// no lookup case
 
-					// loop over cols
-					for (s32 x = setup.startx; x < setup.endx; x++)
+					if constexpr (VectorKernels)
 					{
-						u32 const pix = get_texel_argb32<Wrap>(prim.texture, curu, curv);
-						u32 const ta = pix >> 24;
-						if (ta != 0)
+						draw_span(prim.texture, dest, setup.endx - setup.startx, curu, curv, setup, &fetch_span_argb32<Wrap>, &alpha_add_span);
+					}
+					else
+					{
+						// loop over cols
+						for (s32 x = setup.startx; x < setup.endx; x++)
 						{
-							u32 const dpix = NoDestRead ? 0 : *dest;
-							u32 r = ((source32_r(pix) * ta) >> 8) + dest_r(dpix);
-							u32 g = ((source32_g(pix) * ta) >> 8) + dest_g(dpix);
-							u32 b = ((source32_b(pix) * ta) >> 8) + dest_b(dpix);
-							r = (r | -(r >> (8 - SrcShiftR))) & (0xff >> SrcShiftR);
-							g = (g | -(g >> (8 - SrcShiftG))) & (0xff >> SrcShiftG);
-							b = (b | -(b >> (8 - SrcShiftB))) & (0xff >> SrcShiftB);
-							*dest = dest_assemble_rgb(r, g, b);
+							u32 const pix = get_texel_argb32<Wrap>(prim.texture, curu, curv);
+							u32 const ta = pix >> 24;
+							if (ta != 0)
+							{
+								u32 const dpix = NoDestRead ? 0 : *dest;
+								u32 r = ((source32_r(pix) * ta) >> 8) + dest_r(dpix);
+								u32 g = ((source32_g(pix) * ta) >> 8) + dest_g(dpix);
+								u32 b = ((source32_b(pix) * ta) >> 8) + dest_b(dpix);
+								r = (r | -(r >> (8 - SrcShiftR))) & (0xff >> SrcShiftR);
+								g = (g | -(g >> (8 - SrcShiftG))) & (0xff >> SrcShiftG);
+								b = (b | -(b >> (8 - SrcShiftB))) & (0xff >> SrcShiftB);
+								*dest = dest_assemble_rgb(r, g, b);
+							}
+							dest++;
+							curu += setup.dudx;
+							curv += setup.dvdx;
 						}
-						dest++;
-						curu += setup.dudx;
-						curv += setup.dvdx;
 					}
 				}
 				else
@@ -1724,10 +2144,10 @@ private:
 	//-------------------------------------------------
 	//  setup_and_draw_textured_quad - perform setup
 	//  and then dispatch to a texture-mode-specific
-	//  drawing routine
+	//  drawing routine for rows top to bottom - 1
 	//-------------------------------------------------
 
-	static void setup_and_draw_textured_quad(render_primitive const &prim, PixelType *dstdata, s32 width, s32 height, u32 pitch)
+	static void setup_and_draw_textured_quad(render_primitive const &prim, PixelType *dstdata, s32 width, s32 height, s32 top, s32 bottom, u32 pitch)
 	{
 		assert(prim.bounds.x0 <= prim.bounds.x1);
 		assert(prim.bounds.y0 <= prim.bounds.y1);
@@ -1774,6 +2194,18 @@ private:
 			setup.startv -= 0x8000;
 		}
 
+		// clip to the rows we're drawing, stepping U/V down to the first one
+		if (setup.starty < top)
+		{
+			setup.startu += (top - setup.starty) * setup.dudy;
+			setup.startv += (top - setup.starty) * setup.dvdy;
+			setup.starty = top;
+		}
+		if (setup.endy > bottom)
+			setup.endy = bottom;
+		if (setup.starty >= setup.endy)
+			return;
+
 		// render based on the texture coordinates
 		switch (prim.flags & (PRIMFLAG_TEXFORMAT_MASK | PRIMFLAG_BLENDMODE_MASK))
 		{
@@ -1845,30 +2277,143 @@ private:
 	//**************************************************************************
 
 	//-------------------------------------------------
-	//  draw_primitives - draw a series of primitives
-	//  using a software rasterizer
+	//  draw_primitive - draw a single primitive,
+	//  touching only rows top to bottom - 1
 	//-------------------------------------------------
 
-public:
-	static void draw_primitives(render_primitive_list const &primlist, void *dstdata, u32 width, u32 height, u32 pitch)
+	static void draw_primitive(render_primitive const &prim, PixelType *dstdata, s32 width, s32 height, s32 top, s32 bottom, u32 pitch)
+	{
+		switch (prim.type)
+		{
+			case render_primitive::LINE:
+				draw_line(prim, dstdata, width, top, bottom, pitch);
+				break;
+
+			case render_primitive::QUAD:
+				if (!prim.texture.base)
+					draw_rect(prim, dstdata, width, top, bottom, pitch);
+				else
+					setup_and_draw_textured_quad(prim, dstdata, width, height, top, bottom, pitch);
+				break;
+
+			default:
+				throw emu_fatalerror("Unexpected render_primitive type");
+		}
+	}
+
+
+	//-------------------------------------------------
+	//  draw_band - draw a series of primitives,
+	//  touching only rows top to bottom - 1
+	//-------------------------------------------------
+
+	static void draw_band(render_primitive_list const &primlist, PixelType *dstdata, s32 width, s32 height, s32 top, s32 bottom, u32 pitch)
 	{
 		// loop over the list and render each element
 		for (render_primitive const *prim = primlist.first(); prim != nullptr; prim = prim->next())
-			switch (prim->type)
-			{
-				case render_primitive::LINE:
-					draw_line(*prim, reinterpret_cast<PixelType *>(dstdata), width, height, pitch);
-					break;
+			draw_primitive(*prim, dstdata, width, height, top, bottom, pitch);
+	}
 
-				case render_primitive::QUAD:
-					if (!prim->texture.base)
-						draw_rect(*prim, reinterpret_cast<PixelType *>(dstdata), width, height, pitch);
-					else
-						setup_and_draw_textured_quad(*prim, reinterpret_cast<PixelType *>(dstdata), width, height, pitch);
-					break;
 
-				default:
-					throw emu_fatalerror("Unexpected render_primitive type");
-			}
+	//-------------------------------------------------
+	//  draw_band_callback - work item callback for
+	//  drawing a single band
+	//-------------------------------------------------
+
+	static void *draw_band_callback(void *param, int threadid)
+	{
+		band_data const &band = *reinterpret_cast<band_data const *>(param);
+		draw_band(*band.primlist, band.dstdata, band.width, band.height, band.top, band.bottom, band.pitch);
+		return nullptr;
+	}
+
+
+	//-------------------------------------------------
+	//  draw_rows - draw a series of primitives into
+	//  rows top to bottom - 1, splitting them into
+	//  horizontal bands rasterized concurrently; each
+	//  pixel sees the same operations in the same
+	//  order as when drawing on a single thread, so
+	//  the result is identical
+	//-------------------------------------------------
+
+	static void draw_rows(render_primitive_list const &primlist, PixelType *dstdata, s32 width, s32 height, s32 top, s32 bottom, u32 pitch, osd_work_queue *queue, int bands)
+	{
+		// don't bother splitting small areas
+		bands = std::min<int>(std::min(bands, MAX_BANDS), (bottom - top) / MIN_BAND_HEIGHT);
+		if (!queue || (bands <= 1))
+		{
+			draw_band(primlist, dstdata, width, height, top, bottom, pitch);
+			return;
+		}
+
+		// divide the rows evenly between the bands
+		band_data band[MAX_BANDS];
+		for (int index = 0; index < bands; index++)
+		{
+			band[index].primlist = &primlist;
+			band[index].dstdata = dstdata;
+			band[index].width = width;
+			band[index].height = height;
+			band[index].top = top + (bottom - top) * index / bands;
+			band[index].bottom = top + (bottom - top) * (index + 1) / bands;
+			band[index].pitch = pitch;
+		}
+
+		// queue all but the first band, and draw that one ourselves while we wait
+		osd_work_item_queue_multiple(queue, draw_band_callback, bands - 1, &band[1], sizeof(band[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		draw_band_callback(&band[0], 0);
+		osd_work_queue_wait(queue, osd_ticks_per_second() * 100);
+	}
+
+
+	//-------------------------------------------------
+	//  draw_primitive/draw_primitives - draw a single
+	//  primitive or a series of primitives using a
+	//  software rasterizer
+	//-------------------------------------------------
+
+public:
+	static void draw_primitive(render_primitive const &prim, void *dstdata, u32 width, u32 height, u32 pitch)
+	{
+		draw_primitive(prim, reinterpret_cast<PixelType *>(dstdata), width, height, 0, height, pitch);
+	}
+
+	static void draw_primitives(render_primitive_list const &primlist, void *dstdata, u32 width, u32 height, u32 pitch)
+	{
+		draw_band(primlist, reinterpret_cast<PixelType *>(dstdata), width, height, 0, height, pitch);
+	}
+
+
+	//-------------------------------------------------
+	//  draw_primitives - draw a series of primitives
+	//  by splitting the target into horizontal bands
+	//  and rasterizing them concurrently
+	//-------------------------------------------------
+
+	static void draw_primitives(render_primitive_list const &primlist, void *dstdata, u32 width, u32 height, u32 pitch, osd_work_queue *queue, int bands)
+	{
+		draw_rows(primlist, reinterpret_cast<PixelType *>(dstdata), width, height, 0, height, pitch, queue, bands);
 	}
+
+
+	//-------------------------------------------------
+	//  draw_dirty_primitives - redraw only the rows
+	//  covered by the list's dirty rectangle; the
+	//  destination must still hold the result of
+	//  drawing the list identified by
+	//  primlist.previous_sequence()
+	//-------------------------------------------------
+
+	static void draw_dirty_primitives(render_primitive_list const &primlist, void *dstdata, u32 width, u32 height, u32 pitch, osd_work_queue *queue = nullptr, int bands = 1)
+	{
+		rectangle dirty = primlist.dirty();
+		dirty &= rectangle(0, width - 1, 0, height - 1);
+		if (!dirty.empty())
+			draw_rows(primlist, reinterpret_cast<PixelType *>(dstdata), width, height, dirty.top(), dirty.bottom() + 1, pitch, queue, bands);
+	}
+
+private:
+	static constexpr int MAX_BANDS = 64;
+	static constexpr int MIN_BAND_HEIGHT = 16;
 };
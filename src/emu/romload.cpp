@@ -19,6 +19,8 @@
 
 #include "corestr.h"
 
+#include "../osd/modules/lib/osdlib.h"
+
 #include <algorithm>
 #include <set>
 
@@ -32,6 +34,7 @@
 ***************************************************************************/
 
 #define TEMPBUFFER_MAX_SIZE     (1024 * 1024 * 1024)
+#define MAPPED_REGION_MIN_SIZE  (1024 * 1024)
 
 /***************************************************************************
     HELPERS
@@ -103,6 +106,13 @@ std::vector<std::string> make_software_searchpath(software_list_device &swlist,
 }
 
 
+void configure_disk_cache(const emu_options &options, chd_file &chd)
+{
+	chd.set_cache_hunks(std::max(options.chd_cache(), 1));
+	chd.set_read_ahead_hunks(std::max(options.chd_read_ahead(), 0));
+}
+
+
 std::error_condition do_open_disk(const emu_options &options, std::initializer_list<std::reference_wrapper<const std::vector<std::string> > > searchpath, const rom_entry *romp, chd_file &chd, std::function<const rom_entry * ()> next_parent)
 {
 	// hashes are fixed, but we might need to try multiple filenames
@@ -134,6 +144,7 @@ std::error_condition do_open_disk(const emu_options &options, std::initializer_l
 			{
 				fullpath = imgfile->fullpath();
 				imgfile.reset();
+				configure_disk_cache(options, chd);
 				result = chd.open(fullpath);
 			}
 		}
@@ -350,6 +361,7 @@ chd_file *rom_load_manager::get_disk_handle(std::string_view region)
 std::error_condition rom_load_manager::set_disk_handle(std::string_view region, const char *fullpath)
 {
 	auto chd = std::make_unique<open_chd>(region);
+	configure_disk_cache(machine().options(), chd->orig_chd());
 	auto err = chd->orig_chd().open(fullpath);
 	if (!err)
 		m_chd_list.push_back(std::move(chd));
@@ -892,6 +904,60 @@ void rom_load_manager::copy_rom_data(const rom_entry *romp)
 }
 
 
+/*-------------------------------------------------
+    map_rom_region - try to create a region
+    directly from a copy-on-write mapping of an
+    unpacked ROM file
+-------------------------------------------------*/
+
+bool rom_load_manager::map_rom_region(std::initializer_list<std::reference_wrapper<const std::vector<std::string> > > searchpath, const rom_entry *region, const std::string &regiontag, u8 width, endianness_t endianness, bool from_list)
+{
+	u32 const regionlength = ROMREGION_GETLENGTH(region);
+	if (!machine().options().rom_map() || (regionlength < MAPPED_REGION_MIN_SIZE))
+		return false;
+
+	// the region must not need any post-processing
+	if (ROMREGION_ISINVERTED(region) || ((width > 1) && (endianness != ENDIANNESS_NATIVE)))
+		return false;
+
+	// it must consist of a single plain load of a file covering the whole region
+	const rom_entry *romp = region + 1;
+	if (!ROMENTRY_ISFILE(romp) || !ROMENTRY_ISREGIONEND(romp + 1))
+		return false;
+	if (ROM_INHERITSFLAGS(romp) || ROM_GETBIOSFLAGS(romp) || (ROM_GETOFFSET(romp) != 0) || (ROM_GETLENGTH(romp) != regionlength))
+		return false;
+	if ((ROM_GETBITWIDTH(romp) != 8) || (ROM_GETBITSHIFT(romp) != 0) || (ROM_GETSKIPCOUNT(romp) != 0) || ((ROM_GETGROUPSIZE(romp) != 1) && ROM_ISREVERSED(romp)))
+		return false;
+
+	// find the file without counting it; if anything doesn't fit, the normal loader will take over
+	u32 crc = 0;
+	bool const has_crc = util::hash_collection(romp->hashdata()).crc(crc);
+	std::vector<std::string> tried;
+	std::error_condition filerr;
+	std::unique_ptr<emu_file> file;
+	for (const std::vector<std::string> &paths : searchpath)
+	{
+		file = open_rom_file(paths, tried, has_crc, crc, ROM_GETNAME(romp), filerr);
+		if (file)
+			break;
+	}
+	if (!file || file->archived() || (file->size() != regionlength))
+		return false;
+	auto mapping = std::make_unique<osd::file_mapping>(file->fullpath());
+	if (!*mapping || (mapping->size() != regionlength))
+		return false;
+
+	// create the region and account for the file as if it had been read
+	display_loading_rom_message(ROM_GETNAME(romp), from_list);
+	m_region = machine().memory().region_alloc(regiontag, std::move(mapping), regionlength, width, endianness);
+	LOG("Mapped %X bytes @ %p from %s\n", m_region->bytes(), m_region->base(), file->fullpath());
+	m_romsloaded++;
+	m_romsloadedsize += regionlength;
+	verify_length_and_hash(file.get(), romp->name(), regionlength, util::hash_collection(romp->hashdata()));
+	return true;
+}
+
+
 /*-------------------------------------------------
     process_rom_entries - process all ROM entries
     for a region
@@ -1282,6 +1348,19 @@ void rom_load_manager::load_software_part_region(device_t &device, software_list
 			machine().memory().region_free(memregion->name());
 		}
 
+		// update total number of roms
+		for (const rom_entry *rom = rom_first_file(region); rom != nullptr; rom = rom_next_file(rom))
+		{
+			m_romstotal++;
+			m_romstotalsize += rom_file_size(rom);
+		}
+
+		// map the ROM file directly if possible
+		if (ROMREGION_ISROMDATA(region) && (devsearch.empty()
+				? map_rom_region({ swsearch }, region, regiontag, width, endianness, true)
+				: map_rom_region({ swsearch, devsearch }, region, regiontag, width, endianness, true)))
+			continue;
+
 		// remember the base and length
 		m_region = machine().memory().region_alloc(regiontag, regionlength, width, endianness);
 		LOG("Allocated %X bytes @ %p\n", m_region->bytes(), m_region->base());
@@ -1295,13 +1374,6 @@ void rom_load_manager::load_software_part_region(device_t &device, software_list
 			fill_random(m_region->base(), m_region->bytes());
 #endif
 
-		// update total number of roms
-		for (const rom_entry *rom = rom_first_file(region); rom != nullptr; rom = rom_next_file(rom))
-		{
-			m_romstotal++;
-			m_romstotalsize += rom_file_size(rom);
-		}
-
 		// now process the entries in the region
 		if (ROMREGION_ISROMDATA(region))
 		{
@@ -1365,6 +1437,13 @@ void rom_load_manager::process_region_list()
 				endianness_t endianness = ROMREGION_ISBIGENDIAN(region) ? ENDIANNESS_BIG : ENDIANNESS_LITTLE;
 				normalize_flags_for_device(regiontag, width, endianness);
 
+				// map the ROM file directly if possible
+				if (searchpath.empty())
+					searchpath = device.searchpath();
+				assert(!searchpath.empty());
+				if (map_rom_region({ searchpath }, region, regiontag, width, endianness, false))
+					continue;
+
 				// remember the base and length
 				m_region = machine().memory().region_alloc(regiontag, regionlength, width, endianness);
 				LOG("Allocated %X bytes @ %p\n", m_region->bytes(), m_region->base());
@@ -1379,9 +1458,6 @@ void rom_load_manager::process_region_list()
 #endif
 
 				// now process the entries in the region
-				if (searchpath.empty())
-					searchpath = device.searchpath();
-				assert(!searchpath.empty());
 				process_rom_entries({ searchpath }, device.system_bios(), region, region + 1, false);
 			}
 			else if (ROMREGION_ISDISKDATA(region))
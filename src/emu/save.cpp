@@ -11,14 +11,27 @@
     Save state file format:
 
     00..07  'MAMESAVE'
-    08      Format version (this is format 2)
+    08      Format version (this is format 3)
     09      Flags
     0A..1B  Game name padded with \0
     1C..1F  Signature
-    20..end Save game data (compressed)
+    20..23  Number of chunks
+    24..    Index: two 32-bit words per chunk, the uncompressed size
+            followed by the compressed size
+    ...     Chunk data: each chunk's zlib stream, in index order
+
+    Flag 0x04 marks the chunked layout and is always set in format 3
+    files.  The save game data is split into 256KB pieces (the last one
+    may be shorter) that are compressed independently, so they can be
+    packed and unpacked in parallel.  The uncompressed chunks
+    concatenated in order give the same data a format 2 file holds.
 
     Data is always written as native-endian.
     Data is converted from the endiannness it was written upon load.
+    The chunk count and index are always little-endian.
+
+    Format 2 files, without the chunked flag, hold a single zlib stream
+    from 20 to the end of the file and can still be loaded.
 
 ***************************************************************************/
 
@@ -29,6 +42,8 @@
 #include "util/ioprocs.h"
 #include "util/ioprocsfilter.h"
 
+#include <zlib.h>
+
 
 //**************************************************************************
 //  DEBUGGING
@@ -45,16 +60,138 @@
 //**************************************************************************
 
 const int SAVE_VERSION      = 2;
+const int CHUNKED_SAVE_VERSION = 3;   // chunked files can't be read by older versions
 const int HEADER_SIZE       = 32;
 
 // Available flags
 enum
 {
-	SS_MSB_FIRST = 0x02
+	SS_MSB_FIRST = 0x02,
+	SS_CHUNKED = 0x04
 };
 
+// uncompressed size of each chunk in a chunked save file
+const u32 STATE_CHUNK_SIZE = 256 * 1024;
+
 #define STATE_MAGIC_NUM         "MAMESAVE"
 
+// shortest run of unchanged bytes worth ending a packed rewind literal for
+const size_t REWIND_MIN_RUN = 16;
+
+
+
+//**************************************************************************
+//  REWIND STATE PACKING
+//**************************************************************************
+
+namespace {
+
+//-------------------------------------------------
+//  write_length/read_length - variable-length
+//  run lengths, seven bits per byte
+//-------------------------------------------------
+
+inline void write_length(std::vector<u8> &out, size_t length)
+{
+	while (length >= 0x80)
+	{
+		out.push_back(u8(length) | 0x80);
+		length >>= 7;
+	}
+	out.push_back(u8(length));
+}
+
+inline size_t read_length(const u8 *&src)
+{
+	size_t length = 0;
+	for (int shift = 0; ; shift += 7)
+	{
+		const u8 byte = *src++;
+		length |= size_t(byte & 0x7f) << shift;
+		if (!(byte & 0x80))
+			return length;
+	}
+}
+
+
+//-------------------------------------------------
+//  pack_state - encode a state as alternating
+//  runs of unchanged bytes and literals XORed
+//  with the previous state; with no previous
+//  state this packs a keyframe
+//-------------------------------------------------
+
+void pack_state(const u8 *state, const u8 *prev, size_t size, std::vector<u8> &out)
+{
+	const auto changed = [state, prev] (size_t offset) { return state[offset] != (prev ? prev[offset] : 0); };
+
+	out.clear();
+	size_t offset = 0;
+	while (offset < size)
+	{
+		// skip unchanged bytes, a word at a time where we can
+		const size_t start = offset;
+		if (prev)
+			while ((offset + 8) <= size && !memcmp(&state[offset], &prev[offset], 8))
+				offset += 8;
+		while (offset < size && !changed(offset))
+			offset++;
+		write_length(out, offset - start);
+
+		// the literal runs until we find enough unchanged bytes in a row to be worth a new token
+		size_t end = offset;
+		for (size_t same = 0; (end + same) < size && same < REWIND_MIN_RUN; )
+		{
+			if (changed(end + same))
+			{
+				end += same + 1;
+				same = 0;
+			}
+			else
+			{
+				same++;
+			}
+		}
+		write_length(out, end - offset);
+		for ( ; offset < end; offset++)
+			out.push_back(state[offset] ^ (prev ? prev[offset] : 0));
+	}
+}
+
+
+//-------------------------------------------------
+//  unpack_state - decode a packed state over the
+//  previous one, or from scratch for a keyframe;
+//  since differences are XORed, applying one to
+//  the later state recovers the earlier one
+//-------------------------------------------------
+
+void unpack_state(const std::vector<u8> &packed, u8 *state, size_t size, bool keyframe)
+{
+	const u8 *src = packed.data();
+	const u8 *const end = src + packed.size();
+	size_t offset = 0;
+	while (src < end)
+	{
+		const size_t same = read_length(src);
+		if (keyframe)
+			std::fill_n(&state[offset], same, 0);
+		offset += same;
+
+		const size_t literal = read_length(src);
+		if (keyframe)
+			std::copy_n(src, literal, &state[offset]);
+		else
+			for (size_t i = 0; i < literal; i++)
+				state[offset + i] ^= src[i];
+		src += literal;
+		offset += literal;
+	}
+	assert(offset == size);
+}
+
+} // anonymous namespace
+
 //**************************************************************************
 //  INITIALIZATION
 //**************************************************************************
@@ -67,11 +204,39 @@ save_manager::save_manager(running_machine &machine)
 	: m_machine(machine)
 	, m_reg_allowed(true)
 	, m_illegal_regs(0)
+	, m_tracking(machine.options().state_tracking())
+	, m_generation(1)
+	, m_chunk_queue(nullptr)
 {
 	m_rewind = std::make_unique<rewinder>(*this);
 }
 
 
+//-------------------------------------------------
+//  ~save_manager - destructor
+//-------------------------------------------------
+
+save_manager::~save_manager()
+{
+	if (m_chunk_queue)
+		osd_work_queue_free(m_chunk_queue);
+}
+
+
+//-------------------------------------------------
+//  save_change_tracker - constructor
+//-------------------------------------------------
+
+save_change_tracker::save_change_tracker(const u32 &generation, u8 *base, size_t bytes)
+	: m_generation(generation)
+	, m_base(base)
+	, m_bytes(bytes)
+	, m_tracked(true)
+	, m_pages((bytes + PAGE_SIZE - 1) >> PAGE_SHIFT, generation)
+{
+}
+
+
 //-------------------------------------------------
 //  allow_registration - allow/disallow
 //  registrations to happen
@@ -129,6 +294,51 @@ const char *save_manager::indexed_item(int index, void *&base, u32 &valsize, u32
 }
 
 
+//-------------------------------------------------
+//  track_changes - start recording which pages
+//  of a registered memory block get written
+//-------------------------------------------------
+
+void save_manager::track_changes(void *base)
+{
+	if (!m_tracking || m_tracker_map.find(base) != m_tracker_map.end())
+		return;
+
+	// only contiguous blocks registered as a single entry can be tracked
+	for (const auto &entry : m_entry_list)
+	{
+		if (entry->m_data == base && entry->m_blockcount == 1)
+		{
+			const size_t bytes = entry->m_typesize * entry->m_typecount;
+			m_tracker_map.emplace(base, std::make_unique<save_change_tracker>(m_generation, reinterpret_cast<u8 *>(base), bytes));
+			return;
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  find_tracker - find the change tracker for
+//  the block containing a pointer, and the
+//  pointer's offset within it
+//-------------------------------------------------
+
+save_change_tracker *save_manager::find_tracker(const void *ptr, size_t &offset) const
+{
+	const u8 *const bytes = reinterpret_cast<const u8 *>(ptr);
+	for (const auto &tracker : m_tracker_map)
+	{
+		u8 *const base = tracker.second->base();
+		if (bytes >= base && bytes < (base + tracker.second->bytes()))
+		{
+			offset = bytes - base;
+			return tracker.second.get();
+		}
+	}
+	return nullptr;
+}
+
+
 //-------------------------------------------------
 //  register_presave - register a pre-save
 //  function callback
@@ -260,30 +470,48 @@ void save_manager::dispatch_presave()
 
 save_error save_manager::write_file(util::core_file &file)
 {
-	util::write_stream::ptr writer;
-	save_error err = do_write(
-			[] (size_t total_size) { return true; },
-			[&writer] (const void *data, size_t size)
-			{
-				size_t written;
-				std::error_condition filerr = writer->write(data, size, written);
-				return !filerr && (size == written);
-			},
-			[&file, &writer] ()
-			{
-				if (file.seek(0, SEEK_SET))
-					return false;
-				util::core_file::ptr proxy;
-				std::error_condition filerr = util::core_file::open_proxy(file, proxy);
-				writer = std::move(proxy);
-				return !filerr && writer;
-			},
-			[&file, &writer] ()
-			{
-				writer = util::zlib_write(file, 6, 16384);
-				return bool(writer);
-			});
-	return (STATERR_NONE != err) ? err : writer->finalize() ? STATERR_WRITE_ERROR : STATERR_NONE;
+	// take the whole state in memory first
+	std::vector<u8> state(ram_state::get_size(*this));
+	save_error err = write_buffer(&state[0], state.size());
+	if (err != STATERR_NONE)
+		return err;
+
+	// split it up and compress the pieces
+	std::vector<state_chunk> chunks((state.size() - HEADER_SIZE + STATE_CHUNK_SIZE - 1) / STATE_CHUNK_SIZE);
+	for (size_t index = 0; index < chunks.size(); index++)
+	{
+		state_chunk &chunk = chunks[index];
+		chunk.raw = &state[HEADER_SIZE + index * STATE_CHUNK_SIZE];
+		chunk.rawsize = std::min<size_t>(STATE_CHUNK_SIZE, state.size() - HEADER_SIZE - index * STATE_CHUNK_SIZE);
+		chunk.success = false;
+	}
+	process_chunks(chunks, &save_manager::compress_chunk);
+
+	// build the header and index
+	std::vector<u8> index(4 + chunks.size() * 8);
+	*(u32 *)&index[0] = little_endianize_int32(u32(chunks.size()));
+	for (size_t i = 0; i < chunks.size(); i++)
+	{
+		if (!chunks[i].success)
+			return STATERR_WRITE_ERROR;
+		*(u32 *)&index[4 + i * 8] = little_endianize_int32(chunks[i].rawsize);
+		*(u32 *)&index[8 + i * 8] = little_endianize_int32(u32(chunks[i].packed.size()));
+	}
+	state[8] = CHUNKED_SAVE_VERSION;
+	state[9] |= SS_CHUNKED;
+
+	// write it all out
+	size_t written;
+	if (file.seek(0, SEEK_SET) || file.write(&state[0], HEADER_SIZE, written) || (written != HEADER_SIZE))
+		return STATERR_WRITE_ERROR;
+	if (file.write(&index[0], index.size(), written) || (written != index.size()))
+		return STATERR_WRITE_ERROR;
+	for (const state_chunk &chunk : chunks)
+	{
+		if (file.write(&chunk.packed[0], chunk.packed.size(), written) || (written != chunk.packed.size()))
+			return STATERR_WRITE_ERROR;
+	}
+	return STATERR_NONE;
 }
 
 
@@ -293,6 +521,14 @@ save_error save_manager::write_file(util::core_file &file)
 
 save_error save_manager::read_file(util::core_file &file)
 {
+	// chunked files are unpacked into memory and loaded from there
+	u8 header[HEADER_SIZE];
+	size_t actual;
+	if (file.seek(0, SEEK_SET) || file.read(header, sizeof(header), actual) || (actual != sizeof(header)))
+		return STATERR_READ_ERROR;
+	if (header[9] & SS_CHUNKED)
+		return read_chunked_file(file, header);
+
 	util::read_stream::ptr reader;
 	return do_read(
 			[] (size_t total_size) { return true; },
@@ -319,6 +555,112 @@ save_error save_manager::read_file(util::core_file &file)
 }
 
 
+//-------------------------------------------------
+//  read_chunked_file - read and unpack the
+//  chunks of a chunked file following the
+//  header
+//-------------------------------------------------
+
+save_error save_manager::read_chunked_file(util::core_file &file, const u8 *header)
+{
+	// make sure it's for us before reading anything else
+	if (validate_header(header, machine().system().name, signature(), nullptr, "Error: ") != STATERR_NONE)
+		return STATERR_INVALID_HEADER;
+
+	// read the index and check it adds up to the state we expect
+	std::vector<u8> state(ram_state::get_size(*this));
+	u8 count[4];
+	size_t actual;
+	if (file.read(count, sizeof(count), actual) || (actual != sizeof(count)))
+		return STATERR_READ_ERROR;
+	std::vector<state_chunk> chunks(little_endianize_int32(*(const u32 *)count));
+	if (chunks.size() != (state.size() - HEADER_SIZE + STATE_CHUNK_SIZE - 1) / STATE_CHUNK_SIZE)
+		return STATERR_READ_ERROR;
+
+	std::vector<u8> index(chunks.size() * 8);
+	if (!index.empty() && (file.read(&index[0], index.size(), actual) || (actual != index.size())))
+		return STATERR_READ_ERROR;
+	size_t offset = HEADER_SIZE;
+	for (size_t i = 0; i < chunks.size(); i++)
+	{
+		state_chunk &chunk = chunks[i];
+		chunk.rawsize = little_endianize_int32(*(const u32 *)&index[i * 8]);
+		if (chunk.rawsize > STATE_CHUNK_SIZE || chunk.rawsize > (state.size() - offset))
+			return STATERR_READ_ERROR;
+		chunk.raw = &state[offset];
+		chunk.success = false;
+		offset += chunk.rawsize;
+
+		// read the compressed data as we go
+		chunk.packed.resize(little_endianize_int32(*(const u32 *)&index[i * 8 + 4]));
+		if (chunk.packed.empty() || file.read(&chunk.packed[0], chunk.packed.size(), actual) || (actual != chunk.packed.size()))
+			return STATERR_READ_ERROR;
+	}
+	if (offset != state.size())
+		return STATERR_READ_ERROR;
+
+	// unpack the chunks and load the result
+	process_chunks(chunks, &save_manager::decompress_chunk);
+	for (const state_chunk &chunk : chunks)
+	{
+		if (!chunk.success)
+			return STATERR_READ_ERROR;
+	}
+	std::copy_n(header, HEADER_SIZE, state.begin());
+	return read_buffer(&state[0], state.size());
+}
+
+
+//-------------------------------------------------
+//  process_chunks - run a callback on each of a
+//  list of chunks, in parallel if there's more
+//  than one
+//-------------------------------------------------
+
+void save_manager::process_chunks(std::vector<state_chunk> &chunks, osd_work_callback callback)
+{
+	if ((chunks.size() > 1) && !m_chunk_queue)
+		m_chunk_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+
+	if ((chunks.size() > 1) && m_chunk_queue && osd_work_item_queue_multiple(m_chunk_queue, callback, chunks.size(), &chunks[0], sizeof(state_chunk), WORK_ITEM_FLAG_AUTO_RELEASE))
+	{
+		// the caller reads the results as soon as this returns
+		while (!osd_work_queue_wait(m_chunk_queue, osd_ticks_per_second()))
+		{
+		}
+	}
+	else
+	{
+		for (state_chunk &chunk : chunks)
+			callback(&chunk, 0);
+	}
+}
+
+
+//-------------------------------------------------
+//  compress_chunk/decompress_chunk - work items
+//  that pack and unpack a single chunk
+//-------------------------------------------------
+
+void *save_manager::compress_chunk(void *param, int threadid)
+{
+	state_chunk &chunk = *reinterpret_cast<state_chunk *>(param);
+	uLongf size = compressBound(chunk.rawsize);
+	chunk.packed.resize(size);
+	chunk.success = compress2(&chunk.packed[0], &size, chunk.raw, chunk.rawsize, 6) == Z_OK;
+	chunk.packed.resize(size);
+	return nullptr;
+}
+
+void *save_manager::decompress_chunk(void *param, int threadid)
+{
+	state_chunk &chunk = *reinterpret_cast<state_chunk *>(param);
+	uLongf size = chunk.rawsize;
+	chunk.success = (uncompress(chunk.raw, &size, &chunk.packed[0], chunk.packed.size()) == Z_OK) && (size == chunk.rawsize);
+	return nullptr;
+}
+
+
 //-------------------------------------------------
 //  write_stream - write the current machine state
 //  to an output stream
@@ -375,6 +717,46 @@ save_error save_manager::write_buffer(void *buf, size_t size)
 }
 
 
+//-------------------------------------------------
+//  write_buffer_changes - update a buffer that
+//  held the machine state as of the given
+//  checkpoint, skipping tracked pages that
+//  haven't been written since
+//-------------------------------------------------
+
+save_error save_manager::write_buffer_changes(void *buf, size_t size, u32 since)
+{
+	// checkpoint zero means the buffer contents can't be trusted
+	if (!since)
+		return write_buffer(buf, size);
+
+	return do_write(
+			[size] (size_t total_size) { return size == total_size; },
+			[this, since, ptr = reinterpret_cast<u8 *>(buf)] (const void *data, size_t size) mutable
+			{
+				const auto found = m_tracker_map.find(data);
+				if (found == m_tracker_map.end() || !found->second->tracked())
+				{
+					memcpy(ptr, data, size);
+				}
+				else
+				{
+					const save_change_tracker &tracker = *found->second;
+					const u8 *const src = reinterpret_cast<const u8 *>(data);
+					for (size_t offset = 0, page = 0; offset < size; offset += save_change_tracker::PAGE_SIZE, page++)
+					{
+						if (tracker.page_changed(page, since))
+							memcpy(ptr + offset, src + offset, std::min(save_change_tracker::PAGE_SIZE, size - offset));
+					}
+				}
+				ptr += size;
+				return true;
+			},
+			[] () { return true; },
+			[] () { return true; });
+}
+
+
 //-------------------------------------------------
 //  read_buffer - restore the machine state from a
 //  buffer
@@ -491,6 +873,10 @@ inline save_error save_manager::do_read(T check_length, U read_block, V start_he
 			entry->flip_data();
 	}
 
+	// everything tracked has been overwritten
+	for (auto &tracker : m_tracker_map)
+		tracker.second->touch_all();
+
 	// call the post-load functions
 	dispatch_postload();
 
@@ -553,10 +939,11 @@ save_error save_manager::validate_header(const u8 *header, const char *gamename,
 	}
 
 	// check save state version
-	if (header[8] != SAVE_VERSION)
+	const int expected = (header[9] & SS_CHUNKED) ? CHUNKED_SAVE_VERSION : SAVE_VERSION;
+	if (header[8] != expected)
 	{
 		if (errormsg != nullptr)
-			(*errormsg)("%sWrong version in save file (version %d, expected %d)", error_prefix, header[8], SAVE_VERSION);
+			(*errormsg)("%sWrong version in save file (version %d, expected %d)", error_prefix, header[8], expected);
 		return STATERR_INVALID_HEADER;
 	}
 
@@ -682,7 +1069,30 @@ rewinder::rewinder(save_manager &save)
 	, m_first_invalid_index(REWIND_INDEX_NONE)
 	, m_first_time_warning(true)
 	, m_first_time_note(true)
+	, m_keyframe_interval(save.machine().options().rewind_keyframe())
+	, m_reference_token(0)
+	, m_capture_token(0)
+	, m_pack_queue(nullptr)
+	, m_pack_item(nullptr)
+{
+	if (m_enabled && m_keyframe_interval)
+		m_pack_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+}
+
+
+//-------------------------------------------------
+//  ~rewinder - destructor
+//-------------------------------------------------
+
+rewinder::~rewinder()
 {
+	if (m_pack_item)
+	{
+		osd_work_item_wait(m_pack_item, osd_ticks_per_second() * 100);
+		osd_work_item_release(m_pack_item);
+	}
+	if (m_pack_queue)
+		osd_work_queue_free(m_pack_queue);
 }
 
 
@@ -703,8 +1113,9 @@ void rewinder::clamp_capacity()
 	if (total < 0)
 		m_capacity = 0;
 
-	// if capacity is below savestate size, can't save anything
-	if (total < single)
+	// if capacity is below savestate size, can't save anything; packed states
+	// also need two unpacked working copies alongside the first keyframe
+	if (total < (m_keyframe_interval ? (single * 3) : single))
 	{
 		m_enabled = false;
 		m_save.machine().logerror("Rewind has been disabled, because rewind capacity is smaller than savestate size.\n");
@@ -725,6 +1136,15 @@ void rewinder::invalidate()
 	if (!m_enabled)
 		return;
 
+	// packed states ahead of us are never loaded, so free them right away
+	if (m_keyframe_interval)
+	{
+		finish_packing();
+		if (!current_index_is_last())
+			m_packed_list.erase(m_packed_list.begin() + m_current_index + 1, m_packed_list.end());
+		return;
+	}
+
 	// is there anything to invalidate?
 	if (!current_index_is_last())
 	{
@@ -751,6 +1171,9 @@ bool rewinder::capture()
 		return false;
 	}
 
+	if (m_keyframe_interval)
+		return capture_packed();
+
 	if (current_index_is_last())
 	{
 		// we need to create a new state
@@ -816,6 +1239,9 @@ bool rewinder::step()
 		return false;
 	}
 
+	if (m_keyframe_interval)
+		return step_packed();
+
 	// do we have states to load?
 	if (m_current_index <= REWIND_INDEX_FIRST || m_first_invalid_index == REWIND_INDEX_FIRST)
 	{
@@ -904,6 +1330,211 @@ bool rewinder::check_size()
 }
 
 
+//-------------------------------------------------
+//  capture_packed - take a quick copy of the
+//  state and pack it against the previous one
+//  on the work queue
+//-------------------------------------------------
+
+bool rewinder::capture_packed()
+{
+	finish_packing();
+
+	// anything ahead of us is history we've stepped back from
+	invalidate();
+
+	const size_t size = ram_state::get_size(m_save);
+	if (m_capture.size() != size)
+		m_capture_token = 0;
+	m_capture.resize(size);
+	m_reference.resize(size);
+
+	// the capture buffer holds an older state, so only pages written since then need copying
+	const u32 token = m_save.checkpoint();
+	const save_error error = m_save.write_buffer_changes(&m_capture[0], size, m_capture_token);
+	m_capture_token = (error == STATERR_NONE) ? token : 0;
+	if (error != STATERR_NONE)
+	{
+		// internal error, complain and evacuate
+		report_error(error, rewind_operation::SAVE);
+		return false;
+	}
+
+	// start a new keyframe if the last one is far enough back
+	bool keyframe = true;
+	for (s32 index = s32(m_packed_list.size()) - 1; index >= 0 && (m_packed_list.size() - index) < m_keyframe_interval; index--)
+	{
+		if (m_packed_list[index].m_keyframe)
+		{
+			keyframe = false;
+			break;
+		}
+	}
+	m_packed_list.push_back(packed_state{ std::vector<u8>(), keyframe });
+	m_current_index = m_packed_list.size() - 1;
+	m_first_invalid_index = REWIND_INDEX_NONE;
+
+	// pack it off the emulation thread; if we can't queue it, do it here
+	m_pack_item = osd_work_item_queue(m_pack_queue, &rewinder::pack_callback, this, 0);
+	if (!m_pack_item)
+	{
+		pack_callback(this, 0);
+		m_reference.swap(m_capture);
+		std::swap(m_reference_token, m_capture_token);
+		m_packed_list.back().m_data.assign(m_packing.begin(), m_packing.end());
+		check_packed_size();
+	}
+
+	// success
+	report_error(STATERR_NONE, rewind_operation::SAVE);
+	return true;
+}
+
+
+//-------------------------------------------------
+//  step_packed - single step back in time by
+//  undoing the current state's difference
+//-------------------------------------------------
+
+bool rewinder::step_packed()
+{
+	finish_packing();
+
+	// do we have states to load?
+	if (m_current_index <= REWIND_INDEX_FIRST)
+	{
+		// no valid states, complain and evacuate
+		report_error(STATERR_NOT_FOUND, rewind_operation::LOAD);
+		return false;
+	}
+
+	// the reference holds the current state; a keyframe has nothing to undo,
+	// so rebuild the previous state from the keyframe before it instead
+	const packed_state &current = m_packed_list[m_current_index--];
+	m_reference_token = 0;
+	if (current.m_keyframe)
+		unpack(m_current_index, m_reference);
+	else
+		unpack_state(current.m_data, &m_reference[0], m_reference.size(), false);
+
+	// try to load and report the result
+	const save_error error = m_save.read_buffer(&m_reference[0], m_reference.size());
+	report_error(error, rewind_operation::LOAD);
+
+	// the machine now matches the reference again
+	if (error == save_error::STATERR_NONE)
+		m_reference_token = m_save.checkpoint();
+
+	return error == save_error::STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  finish_packing - wait for the pending pack
+//  and make the new state the reference for the
+//  next one
+//-------------------------------------------------
+
+void rewinder::finish_packing()
+{
+	if (!m_pack_item)
+		return;
+
+	osd_work_item_wait(m_pack_item, osd_ticks_per_second() * 100);
+	osd_work_item_release(m_pack_item);
+	m_pack_item = nullptr;
+
+	// copy rather than swap so the stored state doesn't hold on to spare capacity
+	m_packed_list.back().m_data.assign(m_packing.begin(), m_packing.end());
+	m_reference.swap(m_capture);
+	std::swap(m_reference_token, m_capture_token);
+	check_packed_size();
+}
+
+
+//-------------------------------------------------
+//  check_packed_size - drop the oldest keyframes
+//  and the states that depend on them until the
+//  packed states fit in the capacity
+//-------------------------------------------------
+
+void rewinder::check_packed_size()
+{
+	// the unpacked working copies come out of the budget too
+	const size_t singlesize = ram_state::get_size(m_save);
+	const size_t capsize = m_capacity * 1024 * 1024 - singlesize * 2;
+
+	size_t totalsize = 0;
+	for (const packed_state &state : m_packed_list)
+		totalsize += state.m_data.size();
+
+	while (totalsize > capsize && m_packed_list.size() > 1)
+	{
+		// find the next keyframe
+		size_t count = 1;
+		while (count < m_packed_list.size() && !m_packed_list[count].m_keyframe)
+			count++;
+
+		// if there isn't one, promote the second state to a keyframe so the first can go
+		if (count == m_packed_list.size())
+		{
+			m_capture_token = 0;
+			unpack(1, m_capture);
+			pack_state(&m_capture[0], nullptr, m_capture.size(), m_packing);
+			totalsize -= m_packed_list[1].m_data.size();
+			m_packed_list[1].m_data.assign(m_packing.begin(), m_packing.end());
+			m_packed_list[1].m_keyframe = true;
+			totalsize += m_packed_list[1].m_data.size();
+			count = 1;
+		}
+
+		for (size_t index = 0; index < count; index++)
+			totalsize -= m_packed_list[index].m_data.size();
+		m_packed_list.erase(m_packed_list.begin(), m_packed_list.begin() + count);
+		m_current_index -= count;
+
+		if (m_first_time_note)
+		{
+			m_save.machine().logerror("Rewind note: Capacity has been reached. Old savestates will be erased.\n");
+			m_save.machine().logerror("Capacity: %d bytes. Packed size: %d bytes. Savestate count: %d.\n",
+				capsize, totalsize, m_packed_list.size());
+			m_first_time_note = false;
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  unpack - rebuild the state at the given index
+//  from the keyframe at or before it
+//-------------------------------------------------
+
+void rewinder::unpack(s32 index, std::vector<u8> &state)
+{
+	s32 first = index;
+	while (first > 0 && !m_packed_list[first].m_keyframe)
+		first--;
+	assert(m_packed_list[first].m_keyframe);
+
+	for (s32 i = first; i <= index; i++)
+		unpack_state(m_packed_list[i].m_data, &state[0], state.size(), m_packed_list[i].m_keyframe);
+}
+
+
+//-------------------------------------------------
+//  pack_callback - work item that packs the
+//  captured state against the reference
+//-------------------------------------------------
+
+void *rewinder::pack_callback(void *param, int threadid)
+{
+	rewinder &rew = *reinterpret_cast<rewinder *>(param);
+	const bool keyframe = rew.m_packed_list.back().m_keyframe;
+	pack_state(&rew.m_capture[0], keyframe ? nullptr : &rew.m_reference[0], rew.m_capture.size(), rew.m_packing);
+	return nullptr;
+}
+
+
 //-------------------------------------------------
 //  report_error - report rewind results
 //-------------------------------------------------
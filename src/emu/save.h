@@ -17,11 +17,13 @@
 #ifndef MAME_EMU_SAVE_H
 #define MAME_EMU_SAVE_H
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <memory>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 
@@ -91,6 +93,41 @@ typedef named_delegate<void ()> save_prepost_delegate;
 class ram_state;
 class rewinder;
 
+
+// ======================> save_change_tracker
+
+// records, page by page, the last generation in which a saved memory block
+// was written; once a raw pointer to the block escapes, writes can no longer
+// be seen and the whole block always counts as changed
+class save_change_tracker
+{
+public:
+	static constexpr unsigned PAGE_SHIFT = 12;
+	static constexpr size_t PAGE_SIZE = size_t(1) << PAGE_SHIFT;
+
+	// construction/destruction
+	save_change_tracker(const u32 &generation, u8 *base, size_t bytes);
+
+	// getters
+	u8 *base() const { return m_base; }
+	size_t bytes() const { return m_bytes; }
+	bool tracked() const { return m_tracked; }
+	bool page_changed(size_t page, u32 since) const { return !m_tracked || m_pages[page] > since; }
+
+	// recording changes
+	void touch(size_t offset) noexcept { m_pages[offset >> PAGE_SHIFT] = m_generation; }
+	void touch_all() noexcept { std::fill(m_pages.begin(), m_pages.end(), m_generation); }
+	void untrack() noexcept { m_tracked = false; }
+
+private:
+	const u32 &         m_generation;       // reference to the save manager's current generation
+	u8 *                m_base;             // base of the tracked block
+	size_t              m_bytes;            // size of the tracked block
+	bool                m_tracked;          // false once a raw pointer has escaped
+	std::vector<u32>    m_pages;            // generation of the last write to each page
+};
+
+
 class save_manager
 {
 	// stuff for working with arrays
@@ -154,6 +191,7 @@ public:
 
 	// construction/destruction
 	save_manager(running_machine &machine);
+	~save_manager();
 
 	// getters
 	running_machine &machine() const { return m_machine; }
@@ -165,6 +203,12 @@ public:
 	void allow_registration(bool allowed = true);
 	const char *indexed_item(int index, void *&base, u32 &valsize, u32 &valcount, u32 &blockcount, u32 &stride) const;
 
+	// change tracking
+	bool tracking_enabled() const { return m_tracking; }
+	u32 checkpoint() { return m_generation++; }
+	void track_changes(void *base);
+	save_change_tracker *find_tracker(const void *ptr, size_t &offset) const;
+
 	// function registration
 	void register_presave(save_prepost_delegate func);
 	void register_postload(save_prepost_delegate func);
@@ -309,6 +353,7 @@ public:
 
 	save_error write_buffer(void *buf, size_t size);
 	save_error read_buffer(const void *buf, size_t size);
+	save_error write_buffer_changes(void *buf, size_t size, u32 since);
 
 private:
 	// state callback item
@@ -321,6 +366,15 @@ private:
 		save_prepost_delegate m_func;                 // delegate
 	};
 
+	// piece of a chunked save file
+	struct state_chunk
+	{
+		u8 *            raw;                          // uncompressed data within the full state
+		u32             rawsize;                      // uncompressed size
+		std::vector<u8> packed;                       // compressed data
+		bool            success;                      // did (de)compression succeed?
+	};
+
 	// internal helpers
 	template <typename T, typename U, typename V, typename W>
 	save_error do_write(T check_space, U write_block, V start_header, W start_data);
@@ -328,6 +382,10 @@ private:
 	save_error do_read(T check_length, U read_block, V start_header, W start_data);
 	u32 signature() const;
 	void dump_registry() const;
+	save_error read_chunked_file(util::core_file &file, const u8 *header);
+	void process_chunks(std::vector<state_chunk> &chunks, osd_work_callback callback);
+	static void *compress_chunk(void *param, int threadid);
+	static void *decompress_chunk(void *param, int threadid);
 	static save_error validate_header(const u8 *header, const char *gamename, u32 signature, void (CLIB_DECL *errormsg)(const char *fmt, ...), const char *error_prefix);
 
 	// internal state
@@ -335,11 +393,15 @@ private:
 	std::unique_ptr<rewinder> m_rewind;               // rewinder
 	bool                      m_reg_allowed;          // are registrations allowed?
 	s32                       m_illegal_regs;         // number of illegal registrations
+	bool                      m_tracking;             // is change tracking enabled?
+	u32                       m_generation;           // current change tracking generation
+	osd_work_queue *          m_chunk_queue;          // queue for packing and unpacking file chunks
 
 	std::vector<std::unique_ptr<state_entry>>    m_entry_list;       // list of registered entries
 	std::vector<std::unique_ptr<ram_state>>      m_ramstate_list;    // list of ram states
 	std::vector<std::unique_ptr<state_callback>> m_presave_list;     // list of pre-save functions
 	std::vector<std::unique_ptr<state_callback>> m_postload_list;    // list of post-load functions
+	std::unordered_map<const void *, std::unique_ptr<save_change_tracker>> m_tracker_map; // change trackers by block base
 };
 
 class ram_state
@@ -368,6 +430,24 @@ class rewinder
 	bool           m_first_time_note;                 // keep track of notes
 	std::vector<std::unique_ptr<ram_state>> m_state_list; // rewinder's own ram states
 
+	// packed states: periodic keyframes, with the states in between stored as
+	// run-length coded differences from the state before them
+	struct packed_state
+	{
+		std::vector<u8> m_data;                       // run-length coded XOR against the previous state, or against zero for keyframes
+		bool            m_keyframe;                   // true if this state doesn't depend on the one before it
+	};
+
+	u32            m_keyframe_interval;               // states per keyframe, or 0 to keep full states
+	std::vector<packed_state> m_packed_list;          // packed states, oldest first
+	std::vector<u8> m_reference;                      // unpacked copy of the state at the current index
+	std::vector<u8> m_capture;                        // freshly captured state waiting to be packed
+	u32            m_reference_token;                 // change tracking checkpoint the reference matches, or 0
+	u32            m_capture_token;                   // change tracking checkpoint the capture buffer matches, or 0
+	std::vector<u8> m_packing;                        // output of the pending pack
+	osd_work_queue *m_pack_queue;                     // queue for packing states off the emulation thread
+	osd_work_item * m_pack_item;                      // pending pack, if any
+
 	// load/save management
 	enum class rewind_operation
 	{
@@ -382,11 +462,21 @@ class rewinder
 	};
 
 	bool check_size();
-	bool current_index_is_last() { return m_current_index == m_state_list.size() - 1; }
+	bool current_index_is_last() { return m_current_index == state_count() - 1; }
+	s32 state_count() const { return m_keyframe_interval ? m_packed_list.size() : m_state_list.size(); }
 	void report_error(save_error type, rewind_operation operation);
 
+	// packed state helpers
+	bool capture_packed();
+	bool step_packed();
+	void finish_packing();
+	void check_packed_size();
+	void unpack(s32 index, std::vector<u8> &state);
+	static void *pack_callback(void *param, int threadid);
+
 public:
 	rewinder(save_manager &save);
+	~rewinder();
 	bool enabled() { return m_enabled; }
 	void clamp_capacity();
 	void invalidate();
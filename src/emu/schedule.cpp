@@ -48,6 +48,9 @@ inline emu_timer::emu_timer() noexcept :
 	m_scheduler(nullptr),
 	m_next(nullptr),
 	m_prev(nullptr),
+	m_heap_index(NOT_QUEUED),
+	m_sequence(0),
+	m_queued_expire(attotime::never),
 	m_param(0),
 	m_enabled(false),
 	m_temporary(false),
@@ -83,6 +86,7 @@ inline emu_timer &emu_timer::init(
 	m_scheduler = &machine.scheduler();
 	m_next = nullptr;
 	m_prev = nullptr;
+	m_heap_index = NOT_QUEUED;
 	m_callback = std::move(callback);
 	m_param = param;
 	m_temporary = temporary;
@@ -204,7 +208,7 @@ void emu_timer::register_save(save_manager &manager)
 	// determine our instance number - timers are indexed based on the callback function name
 	int index = 0;
 	std::string name = m_callback.name() ? m_callback.name() : "unnamed";
-	for (const emu_timer *curtimer = m_scheduler->first_timer(); curtimer; curtimer = curtimer->m_next)
+	for (const emu_timer *curtimer : m_scheduler->m_timer_heap)
 	{
 		if (!curtimer->m_temporary)
 		{
@@ -252,6 +256,21 @@ inline void emu_timer::schedule_next_period() noexcept
 }
 
 
+//-------------------------------------------------
+//  queued_before - return true if this timer is
+//  due before another one in the active heap;
+//  ties go to the one inserted first, which is
+//  the order a sorted list would keep them in
+//-------------------------------------------------
+
+inline bool emu_timer::queued_before(const emu_timer &that) const noexcept
+{
+	if (m_queued_expire != that.m_queued_expire)
+		return m_queued_expire < that.m_queued_expire;
+	return m_sequence < that.m_sequence;
+}
+
+
 //-------------------------------------------------
 //  dump - dump internal state to a single output
 //  line in the error log
@@ -283,7 +302,7 @@ device_scheduler::device_scheduler(running_machine &machine) :
 	m_executing_device(nullptr),
 	m_execute_list(nullptr),
 	m_basetime(attotime::zero),
-	m_timer_list(nullptr),
+	m_timer_sequence(0),
 	m_inactive_timers(nullptr),
 	m_callback_timer(nullptr),
 	m_callback_timer_modified(false),
@@ -291,13 +310,15 @@ device_scheduler::device_scheduler(running_machine &machine) :
 	m_suspend_changes_pending(true),
 	m_quantum_minimum(ATTOSECONDS_IN_NSEC(1) / 1000)
 {
-	// append a single never-expiring timer so there is always one in the list
+	// append a single never-expiring timer so there is always one in the heap
 	// need to subvert it because it would naturally be inserted in the inactive list
-	m_timer_list = &timer_list_remove(m_timer_allocator.alloc()->init(machine, timer_expired_delegate(), attotime::never, 0, true));
+	emu_timer &never = timer_list_remove(m_timer_allocator.alloc()->init(machine, timer_expired_delegate(), attotime::never, 0, true));
+	never.m_sequence = m_timer_sequence++;
+	never.m_queued_expire = attotime::never;
+	m_timer_heap.insert(never);
 
-	assert(m_timer_list);
-	assert(!m_timer_list->m_prev);
-	assert(!m_timer_list->m_next);
+	assert(!never.m_prev);
+	assert(!never.m_next);
 	assert(!m_inactive_timers);
 
 	// register global states
@@ -316,8 +337,8 @@ device_scheduler::~device_scheduler()
 	// remove all timers
 	while (m_inactive_timers)
 		m_timer_allocator.reclaim(timer_list_remove(*m_inactive_timers));
-	while (m_timer_list)
-		m_timer_allocator.reclaim(timer_list_remove(*m_timer_list));
+	while (!m_timer_heap.empty())
+		m_timer_allocator.reclaim(timer_list_remove(*m_timer_heap.back()));
 }
 
 
@@ -345,7 +366,7 @@ attotime device_scheduler::time() const noexcept
 bool device_scheduler::can_save() const
 {
 	// if any live temporary timers exit, fail
-	for (emu_timer *timer = m_timer_list; timer; timer = timer->m_next)
+	for (emu_timer *timer : m_timer_heap)
 	{
 		if (timer->m_temporary && !timer->expire().is_never())
 		{
@@ -402,14 +423,14 @@ void device_scheduler::timeslice()
 		m_quantum_allocator.reclaim(m_quantum_list.detach_head());
 
 	// loop until we hit the next timer
-	while (m_basetime < m_timer_list->m_expire)
+	while (m_basetime < first_timer()->m_expire)
 	{
 		// by default, assume our target is the end of the next quantum
 		attotime target(m_basetime + attotime(0, m_quantum_list.first()->m_actual));
 
 		// however, if the next timer is going to fire before then, override
-		if (m_timer_list->m_expire < target)
-			target = m_timer_list->m_expire;
+		if (first_timer()->m_expire < target)
+			target = first_timer()->m_expire;
 
 		LOG("------------------\n");
 		LOG("cpu_timeslice: target = %s\n", target.as_string(PRECISION));
@@ -695,9 +716,11 @@ void device_scheduler::postload()
 		timer_list_remove(timer).m_next = private_list;
 		private_list = &timer;
 	}
-	while (m_timer_list->m_next)
+	// the heap is still ordered by the expiry times from before the load, so
+	// this takes the active timers off in the same order the old list held them
+	while (m_timer_heap.size() > 1)
 	{
-		emu_timer &timer = *m_timer_list;
+		emu_timer &timer = *first_timer();
 
 		if (timer.m_temporary)
 		{
@@ -715,9 +738,9 @@ void device_scheduler::postload()
 	}
 
 	// special dummy timer
-	assert(!m_timer_list->m_enabled);
-	assert(m_timer_list->m_temporary);
-	assert(m_timer_list->m_expire.is_never());
+	assert(!first_timer()->m_enabled);
+	assert(first_timer()->m_temporary);
+	assert(first_timer()->m_expire.is_never());
 
 	// now re-insert them; this effectively re-sorts them by time
 	while (private_list)
@@ -836,7 +859,7 @@ void device_scheduler::rebuild_execute_list()
 
 //-------------------------------------------------
 //  timer_list_insert - insert a new timer into
-//  the list at the appropriate location
+//  the heap or the inactive list as appropriate
 //-------------------------------------------------
 
 inline emu_timer &device_scheduler::timer_list_insert(emu_timer &timer)
@@ -844,35 +867,10 @@ inline emu_timer &device_scheduler::timer_list_insert(emu_timer &timer)
 	// disabled timers never expire
 	if (!timer.m_expire.is_never() && timer.m_enabled)
 	{
-		// loop over the timer list
-		emu_timer *prevtimer = nullptr;
-		for (emu_timer *curtimer = m_timer_list; curtimer; prevtimer = curtimer, curtimer = curtimer->m_next)
-		{
-			// if the current list entry expires after us, we should be inserted before it
-			if (curtimer->m_expire > timer.m_expire)
-			{
-				// link the new guy in before the current list entry
-				timer.m_prev = prevtimer;
-				timer.m_next = curtimer;
-
-				if (prevtimer)
-					prevtimer->m_next = &timer;
-				else
-					m_timer_list = &timer;
-
-				curtimer->m_prev = &timer;
-				return timer;
-			}
-		}
-
-		// need to insert after the last one
-		if (prevtimer)
-			prevtimer->m_next = &timer;
-		else
-			m_timer_list = &timer;
-
-		timer.m_prev = prevtimer;
-		timer.m_next = nullptr;
+		// the sequence number puts us after any timers already waiting for the same time
+		timer.m_sequence = m_timer_sequence++;
+		timer.m_queued_expire = timer.m_expire;
+		m_timer_heap.insert(timer);
 	}
 	else
 	{
@@ -891,19 +889,21 @@ inline emu_timer &device_scheduler::timer_list_insert(emu_timer &timer)
 
 //-------------------------------------------------
 //  timer_list_remove - remove a timer from the
-//  linked list
+//  heap or the inactive list
 //-------------------------------------------------
 
 inline emu_timer &device_scheduler::timer_list_remove(emu_timer &timer)
 {
-	// remove it from the list
-	if (timer.m_prev)
+	if (timer.m_heap_index != emu_timer::NOT_QUEUED)
 	{
-		timer.m_prev->m_next = timer.m_next;
+		m_timer_heap.remove(timer);
+		return timer;
 	}
-	else if (&timer == m_timer_list)
+
+	// remove it from the inactive list
+	if (timer.m_prev)
 	{
-		m_timer_list = timer.m_next;
+		timer.m_prev->m_next = timer.m_next;
 	}
 	else
 	{
@@ -924,13 +924,13 @@ inline emu_timer &device_scheduler::timer_list_remove(emu_timer &timer)
 
 inline void device_scheduler::execute_timers()
 {
-	LOG("execute_timers: new=%s head->expire=%s\n", m_basetime.as_string(PRECISION), m_timer_list->m_expire.as_string(PRECISION));
+	LOG("execute_timers: new=%s head->expire=%s\n", m_basetime.as_string(PRECISION), first_timer()->m_expire.as_string(PRECISION));
 
 	// now process any timers that are overdue
-	while (m_timer_list->m_expire <= m_basetime)
+	while (first_timer()->m_expire <= m_basetime)
 	{
 		// if this is a one-shot timer, disable it now
-		emu_timer &timer = *m_timer_list;
+		emu_timer &timer = *first_timer();
 		bool was_enabled = timer.m_enabled;
 		if (timer.m_period.is_zero() || timer.m_period.is_never())
 			timer.m_enabled = false;
@@ -983,7 +983,7 @@ void device_scheduler::dump_timers() const
 {
 	machine().logerror("=============================================\n");
 	machine().logerror("Timer Dump: Time = %15s\n", time().as_string(PRECISION));
-	for (emu_timer *timer = m_timer_list; timer; timer = timer->m_next)
+	for (emu_timer *timer : m_timer_heap)
 		timer->dump();
 	for (emu_timer *timer = m_inactive_timers; timer; timer = timer->m_next)
 		timer->dump();
@@ -57,6 +57,8 @@ public:
 	attotime period() const noexcept { return m_period; }
 
 private:
+	static constexpr u32 NOT_QUEUED = ~u32(0);
+
 	// construction/destruction
 	emu_timer() noexcept;
 	~emu_timer();
@@ -72,12 +74,19 @@ private:
 	// internal helpers
 	void register_save(save_manager &manager) ATTR_COLD;
 	void schedule_next_period() noexcept;
+	bool queued_before(const emu_timer &that) const noexcept;
+
+	// orders timers in the active heap
+	struct queue_order { bool operator()(const emu_timer &a, const emu_timer &b) const noexcept { return a.queued_before(b); } };
 	void dump() const;
 
 	// internal state
 	device_scheduler *  m_scheduler;    // reference to the owning machine
-	emu_timer *         m_next;         // next timer in order in the list
-	emu_timer *         m_prev;         // previous timer in order in the list
+	emu_timer *         m_next;         // next timer in the inactive list
+	emu_timer *         m_prev;         // previous timer in the inactive list
+	u32                 m_heap_index;   // position in the active timer heap, or NOT_QUEUED
+	u64                 m_sequence;     // insertion order, to break ties between equal expiry times
+	attotime            m_queued_expire; // expiry time the active timer heap is ordered by
 	timer_expired_delegate m_callback;  // callback function
 	s32                 m_param;        // integer parameter
 	bool                m_enabled;      // is the timer enabled?
@@ -107,7 +116,7 @@ public:
 	// getters
 	running_machine &machine() const noexcept { return m_machine; }
 	attotime time() const noexcept;
-	emu_timer *first_timer() const noexcept { return m_timer_list; }
+	emu_timer *first_timer() const noexcept { return m_timer_heap.front(); }
 	device_execute_interface *currently_executing() const noexcept { return m_executing_device; }
 	bool can_save() const;
 
@@ -153,8 +162,9 @@ private:
 	device_execute_interface *  m_execute_list;             // list of devices to be executed
 	attotime                    m_basetime;                 // global basetime; everything moves forward from here
 
-	// list of active timers
-	emu_timer *                 m_timer_list;               // head of the active list
+	// active timers live in a binary heap ordered by expiry time, then by insertion order
+	util::intrusive_heap<emu_timer, &emu_timer::m_heap_index, emu_timer::queue_order> m_timer_heap; // heap of active timers
+	u64                         m_timer_sequence;           // next timer insertion sequence number
 	emu_timer *                 m_inactive_timers;          // head of the inactive timer list
 	fixed_allocator<emu_timer>  m_timer_allocator;          // allocator for timers
 
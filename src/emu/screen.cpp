@@ -518,6 +518,49 @@ void screen_device::svg_renderer::rebuild_cache()
 	}
 }
 
+//**************************************************************************
+//  SCREEN BITMAP
+//**************************************************************************
+
+//-------------------------------------------------
+//  changed_area - return the smallest rectangle
+//  within bounds holding every pixel that differs
+//  from another bitmap
+//-------------------------------------------------
+
+rectangle screen_bitmap::changed_area(const screen_bitmap &prev, const rectangle &bounds) const
+{
+	// anything we can't compare directly is assumed to have changed everywhere
+	if (!valid() || !prev.valid() || m_format != prev.m_format || !cliprect().contains(bounds) || !prev.cliprect().contains(bounds))
+		return bounds;
+
+	int const pixbytes = bpp() / 8;
+	int const rowbytes = bounds.width() * pixbytes;
+	rectangle changed(bounds.right() + 1, bounds.left() - 1, bounds.bottom() + 1, bounds.top() - 1);
+	for (s32 y = bounds.top(); y <= bounds.bottom(); y++)
+	{
+		u8 const *const cur = reinterpret_cast<u8 const *>(live().raw_pixptr(y, bounds.left()));
+		u8 const *const old = reinterpret_cast<u8 const *>(prev.live().raw_pixptr(y, bounds.left()));
+		if (!memcmp(cur, old, rowbytes))
+			continue;
+
+		// widen the horizontal extent only as far as this row needs
+		changed.min_y = std::min(changed.min_y, y);
+		changed.max_y = y;
+		int left = 0;
+		while (left < changed.min_x - bounds.left() && !memcmp(cur + left * pixbytes, old + left * pixbytes, pixbytes))
+			left++;
+		int right = bounds.width() - 1;
+		while (right > changed.max_x - bounds.left() && !memcmp(cur + right * pixbytes, old + right * pixbytes, pixbytes))
+			right--;
+		changed.min_x = std::min(changed.min_x, bounds.left() + left);
+		changed.max_x = std::max(changed.max_x, bounds.left() + right);
+	}
+	return changed;
+}
+
+
+
 //**************************************************************************
 //  SCREEN DEVICE
 //**************************************************************************
@@ -554,6 +597,8 @@ screen_device::screen_device(const machine_config &mconfig, const char *tag, dev
 	, m_curbitmap(0)
 	, m_curtexture(0)
 	, m_changed(true)
+	, m_content_id(0)
+	, m_content_seq(0)
 	, m_last_partial_scan(0)
 	, m_partial_scan_hpos(0)
 	, m_color(rgb_t(0xff, 0xff, 0xff, 0xff))
@@ -825,6 +870,7 @@ void screen_device::device_start()
 	m_texture[0]->set_id(u64(m_unique_id) << 57);
 	m_texture[1] = machine().render().texture_alloc();
 	m_texture[1]->set_id((u64(m_unique_id) << 57) | 1);
+	m_content_id = machine().render().alloc_content_id();
 
 	// configure the default cliparea
 	render_container::user_settings settings = m_container->get_user_settings();
@@ -1754,7 +1800,13 @@ bool screen_device::update_quads()
 				{
 					create_composited_bitmap();
 				}
+
+				// compare against the frame being replaced so renderers can skip what didn't change
+				rectangle dirty = m_visarea;
+				if (m_curtexture != m_curbitmap)
+					dirty = m_bitmap[m_curbitmap].changed_area(m_bitmap[m_curtexture], m_visarea);
 				m_texture[m_curbitmap]->set_bitmap(m_bitmap[m_curbitmap], m_visarea, m_bitmap[m_curbitmap].texformat());
+				m_texture[m_curbitmap]->set_contents(m_content_id, ++m_content_seq, dirty);
 				m_curtexture = m_curbitmap;
 				m_curbitmap = 1 - m_curbitmap;
 			}
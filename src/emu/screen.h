@@ -141,6 +141,9 @@ public:
 		m_rgb32.reset();
 	}
 
+	// dirty tracking
+	rectangle changed_area(const screen_bitmap &prev, const rectangle &bounds) const;
+
 private:
 	// internal state
 	bitmap_format       m_format;
@@ -485,6 +488,8 @@ private:
 	u8                  m_curbitmap;                // current bitmap index
 	u8                  m_curtexture;               // current texture index
 	bool                m_changed;                  // has this bitmap changed?
+	u64                 m_content_id;               // contents identifier shared by both textures
+	u32                 m_content_seq;              // contents sequence number
 	s32                 m_last_partial_scan;        // scanline of last partial update
 	s32                 m_partial_scan_hpos;        // horizontal pixel last rendered on this partial scanline
 	bitmap_argb32       m_screen_overlay_bitmap;    // screen overlay bitmap
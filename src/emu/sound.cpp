@@ -19,6 +19,9 @@
 
 #include "osdepend.h"
 
+#include <algorithm>
+#include <unordered_map>
+
 
 //**************************************************************************
 //  DEBUGGING
@@ -669,6 +672,7 @@ void sound_stream::set_input(int index, sound_stream *input_stream, int output_i
 	// wire it up
 	m_input[index].set_source((input_stream != nullptr) ? &input_stream->m_output[output_index] : nullptr);
 	m_input[index].set_gain(gain);
+	m_device.machine().sound().invalidate_stream_schedule();
 
 	// update sample rates now that we know the input
 	sample_rate_changed();
@@ -1091,7 +1095,10 @@ sound_manager::sound_manager(running_machine &machine) :
 	m_attenuation(0),
 	m_unique_id(0),
 	m_wavfile(),
-	m_first_reset(true)
+	m_first_reset(true),
+	m_stream_threads(machine.options().sound_threads()),
+	m_stream_queue(nullptr),
+	m_stream_schedule_valid(false)
 {
 	// get filename for WAV file or AVI file if specified
 	const char *wavfile = machine.options().wav_write();
@@ -1101,6 +1108,13 @@ sound_manager::sound_manager(running_machine &machine) :
 	if (m_nosound_mode && wavfile[0] == 0 && avifile[0] == 0)
 		machine.m_sample_rate = 11025;
 
+#ifdef MAME_PROFILER
+	// the profiler keeps a single stack of timers, so stream updates have to stay on this thread
+	m_stream_threads = 1;
+#endif
+	if (m_stream_threads > 1)
+		m_stream_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+
 	// count the mixers
 #if VERBOSE
 	mixer_interface_enumerator iter(machine.root_device());
@@ -1135,6 +1149,8 @@ sound_manager::sound_manager(running_machine &machine) :
 
 sound_manager::~sound_manager()
 {
+	if (m_stream_queue)
+		osd_work_queue_free(m_stream_queue);
 }
 
 
@@ -1152,6 +1168,7 @@ sound_stream *sound_manager::stream_alloc(device_t &device, u32 inputs, u32 outp
 			output_base += stream->output_count();
 
 	m_stream_list.push_back(std::make_unique<sound_stream>(device, inputs, outputs, output_base, sample_rate, callback, flags));
+	invalidate_stream_schedule();
 	return m_stream_list.back().get();
 }
 
@@ -1480,6 +1497,177 @@ stream_buffer::sample_t sound_manager::adjust_toward_compressor_scale(stream_buf
 }
 
 
+//-------------------------------------------------
+//  build_stream_schedule - split the streams
+//  feeding the speakers into groups that share
+//  no streams and no devices, so that each group
+//  can be brought up to date on its own thread
+//-------------------------------------------------
+
+void sound_manager::build_stream_schedule()
+{
+	m_stream_schedule_valid = true;
+	m_stream_groups.clear();
+
+	// the speaker streams themselves are always mixed serially
+	std::vector<sound_stream *> sinks;
+	for (speaker_device &speaker : m_speakers)
+	{
+		int dummy;
+		sound_stream *const stream = speaker.output_to_stream_output(0, dummy);
+		if (stream)
+			sinks.push_back(stream);
+	}
+
+	// union-find over every stream reachable from a speaker
+	std::unordered_map<sound_stream *, sound_stream *> parent;
+	auto const find =
+			[&parent] (sound_stream *stream)
+			{
+				while (parent[stream] != stream)
+					stream = parent[stream] = parent[parent[stream]];
+				return stream;
+			};
+	auto const merge = [&find, &parent] (sound_stream *a, sound_stream *b) { parent[find(a)] = find(b); };
+
+	// streams owned by the same device are joined as well, since their callbacks
+	// may share chip state; resamplers only touch their own source
+	std::unordered_map<device_t *, sound_stream *> device_streams;
+	std::vector<sound_stream *> pending;
+	auto const visit =
+			[&] (sound_stream &stream, bool resampler)
+			{
+				if (std::find(sinks.begin(), sinks.end(), &stream) != sinks.end())
+					return false;
+				if (parent.emplace(&stream, &stream).second)
+				{
+					pending.push_back(&stream);
+					if (!resampler)
+					{
+						auto const found = device_streams.emplace(&stream.device(), &stream);
+						if (!found.second)
+							merge(&stream, found.first->second);
+					}
+				}
+				return true;
+			};
+	auto const visit_input =
+			[&] (sound_stream_input &input)
+			{
+				if (!visit(input.source().stream(), false))
+					return false;
+				if (input.m_resampler_source)
+				{
+					visit(input.m_resampler_source->stream(), true);
+					merge(&input.m_resampler_source->stream(), &input.source().stream());
+				}
+				return true;
+			};
+
+	// walk the graph from the speaker inputs down; if a speaker feeds another
+	// speaker, leave the whole update to the serial path
+	std::vector<sound_stream_input *> feeds;
+	for (sound_stream *sink : sinks)
+		for (sound_stream_input &input : sink->m_input)
+			if (input.valid())
+			{
+				if (!visit_input(input))
+					return;
+				feeds.push_back(&input);
+			}
+	while (!pending.empty())
+	{
+		sound_stream &stream = *pending.back();
+		pending.pop_back();
+		for (sound_stream_input &input : stream.m_input)
+			if (input.valid())
+			{
+				if (!visit_input(input))
+					return;
+				merge(&stream, &input.source().stream());
+			}
+	}
+
+	// count the streams in each independent component, in order of first use
+	std::vector<std::pair<sound_stream *, u32> > components;
+	for (sound_stream_input *input : feeds)
+	{
+		sound_stream *const root = find(&input->source().stream());
+		if (std::find_if(components.begin(), components.end(), [root] (auto const &c) { return c.first == root; }) == components.end())
+			components.emplace_back(root, 0);
+	}
+	for (auto &node : parent)
+	{
+		sound_stream *const root = find(node.first);
+		std::find_if(components.begin(), components.end(), [root] (auto const &c) { return c.first == root; })->second++;
+	}
+	if (components.size() < 2)
+		return;
+
+	// hand out components to groups, largest first to the least loaded group
+	std::stable_sort(components.begin(), components.end(), [] (auto const &a, auto const &b) { return a.second > b.second; });
+	m_stream_groups.resize(std::min<size_t>(m_stream_threads, components.size()));
+	std::vector<u32> load(m_stream_groups.size(), 0);
+	std::unordered_map<sound_stream *, size_t> assignment;
+	for (auto const &component : components)
+	{
+		size_t const group = std::min_element(load.begin(), load.end()) - load.begin();
+		load[group] += component.second;
+		assignment[component.first] = group;
+	}
+
+	// keep the speaker inputs in the order the serial mix would pull them
+	for (sound_stream_input *input : feeds)
+		m_stream_groups[assignment[find(&input->source().stream())]].feeds.push_back(input);
+}
+
+
+//-------------------------------------------------
+//  update_streams_concurrently - bring every
+//  group of independent streams up to the given
+//  time on the work queue
+//-------------------------------------------------
+
+void sound_manager::update_streams_concurrently(attotime endtime)
+{
+	if (!m_stream_schedule_valid)
+		build_stream_schedule();
+	if (m_stream_groups.empty())
+		return;
+
+	for (stream_update_group &group : m_stream_groups)
+		group.endtime = endtime;
+	osd_work_item_queue_multiple(m_stream_queue, &sound_manager::update_stream_group, m_stream_groups.size(), &m_stream_groups[0], sizeof(m_stream_groups[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+
+	// streams mustn't be touched again until every group is up to date
+	while (!osd_work_queue_wait(m_stream_queue, osd_ticks_per_second()))
+	{
+	}
+}
+
+
+//-------------------------------------------------
+//  update_stream_group - work item callback that
+//  pulls each speaker input in a group over the
+//  same range the speaker's own update will ask
+//  for, so the results are identical to a serial
+//  update
+//-------------------------------------------------
+
+void *sound_manager::update_stream_group(void *param, int threadid)
+{
+	stream_update_group &group = *reinterpret_cast<stream_update_group *>(param);
+	for (sound_stream_input *input : group.feeds)
+	{
+		sound_stream &sink = input->owner();
+		attotime const start = sink.sample_time();
+		if (start < group.endtime && sink.m_sample_rate >= SAMPLE_RATE_MINIMUM)
+			input->update(start, group.endtime);
+	}
+	return nullptr;
+}
+
+
 //-------------------------------------------------
 //  update - mix everything down to its final form
 //  and send it to the OSD layer
@@ -1506,6 +1694,11 @@ void sound_manager::update(int param)
 	std::fill_n(&m_leftmix[0], m_samples_this_update, 0);
 	std::fill_n(&m_rightmix[0], m_samples_this_update, 0);
 
+	// bring independent branches of the graph up to date concurrently; the
+	// speakers then find everything they depend on already generated
+	if (m_stream_queue)
+		update_streams_concurrently(endtime);
+
 	// force all the speaker streams to generate the proper number of samples
 	for (speaker_device &speaker : m_speakers)
 		speaker.mix(&m_leftmix[0], &m_rightmix[0], m_last_update, endtime, m_samples_this_update, (m_muted & MUTE_REASON_SYSTEM));
@@ -526,6 +526,7 @@ private:
 
 class sound_stream_input
 {
+	friend class sound_manager;
 #if (SOUND_DEBUG)
 	friend class sound_stream;
 #endif
@@ -797,7 +798,17 @@ public:
 	// fill the given buffer with 16-bit stereo audio samples
 	void samples(s16 *buffer);
 
+	// note that the stream graph has changed and the concurrent update schedule must be rebuilt
+	void invalidate_stream_schedule() { m_stream_schedule_valid = false; }
+
 private:
+	// a set of independent streams that can be updated on a single thread
+	struct stream_update_group
+	{
+		std::vector<sound_stream_input *> feeds; // speaker inputs fed by this group, in serial update order
+		attotime endtime;                      // time to bring the group up to
+	};
+
 	// set/reset the mute state for the given reason
 	void mute(bool mute, u8 reason);
 
@@ -824,6 +835,11 @@ private:
 	// periodic sound update, called STREAMS_UPDATE_FREQUENCY per second
 	void update(s32 param = 0);
 
+	// concurrent update of independent branches of the stream graph
+	void build_stream_schedule();
+	void update_streams_concurrently(attotime endtime);
+	static void *update_stream_group(void *param, int threadid);
+
 	// internal state
 	running_machine &m_machine;           // reference to the running machine
 	emu_timer *m_update_timer;            // timer that runs the update function
@@ -851,6 +867,12 @@ private:
 	std::vector<std::unique_ptr<sound_stream>> m_stream_list; // list of streams
 	std::map<sound_stream *, u8> m_orphan_stream_list; // list of orphaned streams
 	bool m_first_reset;                   // is this our first reset?
+
+	// concurrent update state
+	int m_stream_threads;                 // maximum number of groups to update concurrently
+	osd_work_queue *m_stream_queue;       // work queue for concurrent stream updates
+	bool m_stream_schedule_valid;         // is the current schedule up to date with the graph?
+	std::vector<stream_update_group> m_stream_groups; // independent groups of streams
 };
 
 
@@ -10,10 +10,26 @@
 
 #include "emu.h"
 #include "tilemap.h"
+#include "tilemapt.ipp"
 
+#include "emuopts.h"
 #include "screen.h"
 
 
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+namespace {
+
+constexpr int MIN_BAND_HEIGHT = 16;             // don't split areas into bands shorter than this
+constexpr int MAX_BANDS = 64;                   // most bands a draw is split into
+
+using scanline = tilemap_scanline<>;
+
+} // anonymous namespace
+
+
 //**************************************************************************
 //  INLINE FUNCTIONS
 //**************************************************************************
@@ -98,236 +114,6 @@ inline bool tilemap_t::gfx_elements_changed()
 }
 
 
-//**************************************************************************
-//  SCANLINE RASTERIZERS
-//**************************************************************************
-
-//-------------------------------------------------
-//  scanline_draw_opaque_null - draw to a nullptr
-//  bitmap, setting priority only
-//-------------------------------------------------
-
-inline void tilemap_t::scanline_draw_opaque_null(int count, u8 *pri, u32 pcode)
-{
-	// skip entirely if not changing priority
-	if (pcode == 0xff00)
-		return;
-
-	// update priority across the scanline
-	for (int i = 0; i < count; i++)
-		pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-}
-
-
-//-------------------------------------------------
-//  scanline_draw_masked_null - draw to a nullptr
-//  bitmap using a mask, setting priority only
-//-------------------------------------------------
-
-inline void tilemap_t::scanline_draw_masked_null(const u8 *maskptr, int mask, int value, int count, u8 *pri, u32 pcode)
-{
-	// skip entirely if not changing priority
-	if (pcode == 0xff00)
-		return;
-
-	// update priority across the scanline, checking the mask
-	for (int i = 0; i < count; i++)
-		if ((maskptr[i] & mask) == value)
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-}
-
-
-
-//-------------------------------------------------
-//  scanline_draw_opaque_ind16 - draw to a 16bpp
-//  indexed bitmap
-//-------------------------------------------------
-
-inline void tilemap_t::scanline_draw_opaque_ind16(u16 *dest, const u16 *source, int count, u8 *pri, u32 pcode)
-{
-	// special case for no palette offset
-	int pal = pcode >> 16;
-	if (pal == 0)
-	{
-		// use memcpy which should be well-optimized for the platform
-		memcpy(dest, source, count * 2);
-
-		// skip the rest if not changing priority
-		if (pcode == 0xff00)
-			return;
-
-		// update priority across the scanline
-		for (int i = 0; i < count; i++)
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-	}
-
-	// priority case
-	else if ((pcode & 0xffff) != 0xff00)
-	{
-		for (int i = 0; i < count; i++)
-		{
-			dest[i] = source[i] + pal;
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-		}
-	}
-
-	// no priority case
-	else
-	{
-		for (int i = 0; i < count; i++)
-			dest[i] = source[i] + pal;
-	}
-}
-
-
-//-------------------------------------------------
-//  scanline_draw_masked_ind16 - draw to a 16bpp
-//  indexed bitmap using a mask
-//-------------------------------------------------
-
-inline void tilemap_t::scanline_draw_masked_ind16(u16 *dest, const u16 *source, const u8 *maskptr, int mask, int value, int count, u8 *pri, u32 pcode)
-{
-	int pal = pcode >> 16;
-
-	// priority case
-	if ((pcode & 0xffff) != 0xff00)
-	{
-		for (int i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-			{
-				dest[i] = source[i] + pal;
-				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-			}
-	}
-
-	// no priority case
-	else
-	{
-		for (int i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-				dest[i] = source[i] + pal;
-	}
-}
-
-
-
-//-------------------------------------------------
-//  scanline_draw_opaque_rgb32 - draw to a 32bpp
-//  RGB bitmap
-//-------------------------------------------------
-
-inline void tilemap_t::scanline_draw_opaque_rgb32(u32 *dest, const u16 *source, int count, const rgb_t *pens, u8 *pri, u32 pcode)
-{
-	const rgb_t *clut = &pens[pcode >> 16];
-
-	// priority case
-	if ((pcode & 0xffff) != 0xff00)
-	{
-		for (int i = 0; i < count; i++)
-		{
-			dest[i] = clut[source[i]];
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-		}
-	}
-
-	// no priority case
-	else
-	{
-		for (int i = 0; i < count; i++)
-			dest[i] = clut[source[i]];
-	}
-}
-
-
-//-------------------------------------------------
-//  scanline_draw_masked_rgb32 - draw to a 32bpp
-//  RGB bitmap using a mask
-//-------------------------------------------------
-
-inline void tilemap_t::scanline_draw_masked_rgb32(u32 *dest, const u16 *source, const u8 *maskptr, int mask, int value, int count, const rgb_t *pens, u8 *pri, u32 pcode)
-{
-	const rgb_t *clut = &pens[pcode >> 16];
-
-	// priority case
-	if ((pcode & 0xffff) != 0xff00)
-	{
-		for (int i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-			{
-				dest[i] = clut[source[i]];
-				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-			}
-	}
-
-	// no priority case
-	else
-	{
-		for (int i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-				dest[i] = clut[source[i]];
-	}
-}
-
-
-//-------------------------------------------------
-//  scanline_draw_opaque_rgb32_alpha - draw to a
-//  32bpp RGB bitmap with alpha blending
-//-------------------------------------------------
-
-inline void tilemap_t::scanline_draw_opaque_rgb32_alpha(u32 *dest, const u16 *source, int count, const rgb_t *pens, u8 *pri, u32 pcode, u8 alpha)
-{
-	const rgb_t *clut = &pens[pcode >> 16];
-
-	// priority case
-	if ((pcode & 0xffff) != 0xff00)
-	{
-		for (int i = 0; i < count; i++)
-		{
-			dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-		}
-	}
-
-	// no priority case
-	else
-	{
-		for (int i = 0; i < count; i++)
-			dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
-	}
-}
-
-
-//-------------------------------------------------
-//  scanline_draw_masked_rgb32_alpha - draw to a
-//  32bpp RGB bitmap using a mask and alpha
-//  blending
-//-------------------------------------------------
-
-inline void tilemap_t::scanline_draw_masked_rgb32_alpha(u32 *dest, const u16 *source, const u8 *maskptr, int mask, int value, int count, const rgb_t *pens, u8 *pri, u32 pcode, u8 alpha)
-{
-	const rgb_t *clut = &pens[pcode >> 16];
-
-	// priority case
-	if ((pcode & 0xffff) != 0xff00)
-	{
-		for (int i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-			{
-				dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
-				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-			}
-	}
-
-	// no priority case
-	else
-	{
-		for (int i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-				dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
-	}
-}
-
-
 //**************************************************************************
 //  TILEMAP CREATION AND CONFIGURATION
 //**************************************************************************
@@ -997,6 +783,14 @@ void tilemap_t::draw_common(screen_device &screen, _BitmapClass &dest, const rec
 	if (!m_enable)
 		return;
 
+	// hand off to the manager if we might be drawing in bands
+	if (m_manager->m_bands > 1)
+	{
+		tilemap_layer const layer{ *this, flags, priority, priority_mask };
+		m_manager->draw_layers(screen, dest, cliprect, &layer, 1);
+		return;
+	}
+
 g_profiler.start(PROFILER_TILEMAP_DRAW);
 	// configure the blit parameters based on the input parameters
 	blit_parameters blit;
@@ -1007,6 +801,21 @@ g_profiler.start(PROFILER_TILEMAP_DRAW);
 	// flush the dirty state to all tiles as appropriate
 	realize_all_dirty_tiles();
 
+	draw_band(screen, dest, blit);
+g_profiler.stop();
+}
+
+
+//-------------------------------------------------
+//  for_each_instance - call func with the
+//  destination position and cliprect of each
+//  instance of the tilemap drawn within the
+//  cliprect, handling scrolling and wraparound
+//-------------------------------------------------
+
+template<typename InstanceFunc>
+void tilemap_t::for_each_instance(screen_device &screen, const rectangle &cliprect, InstanceFunc &&func)
+{
 	// flip the tilemap around the center of the visible area
 	rectangle const visarea = screen.visible_area();
 	u32 const xextent = visarea.right() + visarea.left() + 1; // x0 + x1 + 1 for calculating horizontal centre as (x0 + x1 + 1) >> 1
@@ -1018,15 +827,16 @@ g_profiler.start(PROFILER_TILEMAP_DRAW);
 		// iterate to handle wraparound
 		int scrollx = effective_rowscroll(0, xextent);
 		int scrolly = effective_colscroll(0, yextent);
-		for (int ypos = scrolly - m_height; ypos <= blit.cliprect.bottom(); ypos += m_height)
-			for (int xpos = scrollx - m_width; xpos <= blit.cliprect.right(); xpos += m_width)
-				draw_instance(screen, dest, blit, xpos, ypos);
+		for (int ypos = scrolly - m_height; ypos <= cliprect.bottom(); ypos += m_height)
+			for (int xpos = scrollx - m_width; xpos <= cliprect.right(); xpos += m_width)
+				func(cliprect, xpos, ypos);
 	}
 
 	// scrolling rows + vertical scroll
 	else if (m_scrollcols == 1)
 	{
-		const rectangle original_cliprect = blit.cliprect;
+		rectangle const &original_cliprect = cliprect;
+		rectangle clip = cliprect;
 
 		// iterate over Y to handle wraparound
 		int rowheight = m_height / m_scrollrows;
@@ -1051,12 +861,12 @@ g_profiler.start(PROFILER_TILEMAP_DRAW);
 					continue;
 
 				// update the cliprect just for this set of rows
-				blit.cliprect.sety(currow * rowheight + ypos, nextrow * rowheight - 1 + ypos);
-				blit.cliprect &= original_cliprect;
+				clip.sety(currow * rowheight + ypos, nextrow * rowheight - 1 + ypos);
+				clip &= original_cliprect;
 
 				// iterate over X to handle wraparound
 				for (int xpos = scrollx - m_width; xpos <= original_cliprect.right(); xpos += m_width)
-					draw_instance(screen, dest, blit, xpos, ypos);
+					func(clip, xpos, ypos);
 			}
 		}
 	}
@@ -1064,7 +874,8 @@ g_profiler.start(PROFILER_TILEMAP_DRAW);
 	// scrolling columns + horizontal scroll
 	else if (m_scrollrows == 1)
 	{
-		const rectangle original_cliprect = blit.cliprect;
+		rectangle const &original_cliprect = cliprect;
+		rectangle clip = cliprect;
 
 		// iterate over columns in the tilemap
 		int scrollx = effective_rowscroll(0, xextent);
@@ -1086,16 +897,80 @@ g_profiler.start(PROFILER_TILEMAP_DRAW);
 			for (int xpos = scrollx - m_width; xpos <= original_cliprect.right(); xpos += m_width)
 			{
 				// update the cliprect just for this set of columns
-				blit.cliprect.setx(curcol * colwidth + xpos, nextcol * colwidth - 1 + xpos);
-				blit.cliprect &= original_cliprect;
+				clip.setx(curcol * colwidth + xpos, nextcol * colwidth - 1 + xpos);
+				clip &= original_cliprect;
 
 				// iterate over Y to handle wraparound
 				for (int ypos = scrolly - m_height; ypos <= original_cliprect.bottom(); ypos += m_height)
-					draw_instance(screen, dest, blit, xpos, ypos);
+					func(clip, xpos, ypos);
 			}
 		}
 	}
-g_profiler.stop();
+}
+
+
+//-------------------------------------------------
+//  draw_band - draw the tilemap within the blit
+//  cliprect; only touches pixels and tiles in
+//  the cliprect's rows, so separate bands can be
+//  drawn concurrently once those tiles are clean
+//-------------------------------------------------
+
+template<class _BitmapClass>
+void tilemap_t::draw_band(screen_device &screen, _BitmapClass &dest, const blit_parameters &band)
+{
+	blit_parameters blit = band;
+	for_each_instance(screen, band.cliprect,
+			[this, &screen, &dest, &blit] (const rectangle &cliprect, int xpos, int ypos)
+			{
+				blit.cliprect = cliprect;
+				draw_instance(screen, dest, blit, xpos, ypos);
+			});
+}
+
+
+//-------------------------------------------------
+//  realize_covered_tiles - bring up to date the
+//  dirty tiles that drawing within the cliprect
+//  would use, taking row and column scroll into
+//  account, without touching any others
+//-------------------------------------------------
+
+void tilemap_t::realize_covered_tiles(screen_device &screen, const rectangle &cliprect)
+{
+	// if the graphics changed, we need to mark everything dirty
+	if (gfx_elements_changed())
+		mark_all_dirty();
+
+	// if everything is clean, do nothing
+	if (m_all_tiles_clean)
+		return;
+
+	// flush the dirty state to all tiles as appropriate
+	realize_all_dirty_tiles();
+
+	// update the same tiles draw_instance would look at
+	for_each_instance(screen, cliprect,
+			[this] (const rectangle &clip, int xpos, int ypos)
+			{
+				// clip to the tilemap; x2/y2 are exclusive
+				int const x1 = (std::max)(xpos, clip.left()) - xpos;
+				int const x2 = (std::min)(xpos + int(m_width), clip.right() + 1) - xpos;
+				int const y1 = (std::max)(ypos, clip.top()) - ypos;
+				int const y2 = (std::min)(ypos + int(m_height), clip.bottom() + 1) - ypos;
+				if (x1 >= x2 || y1 >= y2)
+					return;
+
+				int const mincol = x1 / m_tilewidth;
+				int const maxcol = (x2 - 1) / m_tilewidth;
+				for (int row = y1 / m_tileheight; row <= (y2 - 1) / m_tileheight; row++)
+					for (int column = mincol; column <= maxcol; column++)
+					{
+						logical_index const logindex = row * m_cols + column;
+						if (m_tileflags[logindex] == TILE_FLAG_DIRTY)
+							tile_update(logindex, column, row);
+					}
+			});
 }
 
 void tilemap_t::draw(screen_device &screen, bitmap_ind16 &dest, const rectangle &cliprect, u32 flags, u8 priority, u8 priority_mask)
@@ -1268,13 +1143,13 @@ void tilemap_t::draw_instance(screen_device &screen, _BitmapClass &dest, const b
 					for (int cury = y; cury < nexty; cury++)
 					{
 						if (dest_baseaddr == nullptr)
-							scanline_draw_opaque_null(x_end - x_start, pmap0, blit.tilemap_priority_code);
+							scanline::opaque_null(x_end - x_start, pmap0, blit.tilemap_priority_code);
 						else if (sizeof(*dest0) == 2)
-							scanline_draw_opaque_ind16(reinterpret_cast<u16 *>(dest0), source0, x_end - x_start, pmap0, blit.tilemap_priority_code);
+							scanline::opaque_ind16(reinterpret_cast<u16 *>(dest0), source0, x_end - x_start, pmap0, blit.tilemap_priority_code);
 						else if (sizeof(*dest0) == 4 && blit.alpha >= 0xff)
-							scanline_draw_opaque_rgb32(reinterpret_cast<u32 *>(dest0), source0, x_end - x_start, clut, pmap0, blit.tilemap_priority_code);
+							scanline::opaque_rgb32(reinterpret_cast<u32 *>(dest0), source0, x_end - x_start, clut, pmap0, blit.tilemap_priority_code);
 						else if (sizeof(*dest0) == 4)
-							scanline_draw_opaque_rgb32_alpha(reinterpret_cast<u32 *>(dest0), source0, x_end - x_start, clut, pmap0, blit.tilemap_priority_code, blit.alpha);
+							scanline::opaque_rgb32_alpha(reinterpret_cast<u32 *>(dest0), source0, x_end - x_start, clut, pmap0, blit.tilemap_priority_code, blit.alpha);
 
 						dest0 += dest_rowpixels;
 						source0 += m_pixmap.rowpixels();
@@ -1289,13 +1164,13 @@ void tilemap_t::draw_instance(screen_device &screen, _BitmapClass &dest, const b
 					for (int cury = y; cury < nexty; cury++)
 					{
 						if (dest_baseaddr == nullptr)
-							scanline_draw_masked_null(mask0, blit.mask, blit.value, x_end - x_start, pmap0, blit.tilemap_priority_code);
+							scanline::masked_null(mask0, blit.mask, blit.value, x_end - x_start, pmap0, blit.tilemap_priority_code);
 						else if (sizeof(*dest0) == 2)
-							scanline_draw_masked_ind16(reinterpret_cast<u16 *>(dest0), source0, mask0, blit.mask, blit.value, x_end - x_start, pmap0, blit.tilemap_priority_code);
+							scanline::masked_ind16(reinterpret_cast<u16 *>(dest0), source0, mask0, blit.mask, blit.value, x_end - x_start, pmap0, blit.tilemap_priority_code);
 						else if (sizeof(*dest0) == 4 && blit.alpha >= 0xff)
-							scanline_draw_masked_rgb32(reinterpret_cast<u32 *>(dest0), source0, mask0, blit.mask, blit.value, x_end - x_start, clut, pmap0, blit.tilemap_priority_code);
+							scanline::masked_rgb32(reinterpret_cast<u32 *>(dest0), source0, mask0, blit.mask, blit.value, x_end - x_start, clut, pmap0, blit.tilemap_priority_code);
 						else if (sizeof(*dest0) == 4)
-							scanline_draw_masked_rgb32_alpha(reinterpret_cast<u32 *>(dest0), source0, mask0, blit.mask, blit.value, x_end - x_start, clut, pmap0, blit.tilemap_priority_code, blit.alpha);
+							scanline::masked_rgb32_alpha(reinterpret_cast<u32 *>(dest0), source0, mask0, blit.mask, blit.value, x_end - x_start, clut, pmap0, blit.tilemap_priority_code, blit.alpha);
 
 						dest0 += dest_rowpixels;
 						source0 += m_pixmap.rowpixels();
@@ -1576,8 +1451,12 @@ void tilemap_t::get_info_debug(u32 col, u32 row, u8 &gfxnum, u32 &code, u32 &col
 
 tilemap_manager::tilemap_manager(running_machine &machine)
 	: m_machine(machine),
-		m_instance(0)
+		m_instance(0),
+		m_work_queue(nullptr),
+		m_bands(std::clamp(machine.options().tilemap_threads(), 1, MAX_BANDS))
 {
+	if (m_bands > 1)
+		m_work_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
 }
 
 
@@ -1600,6 +1479,9 @@ tilemap_manager::~tilemap_manager()
 				break;
 			}
 	}
+
+	if (m_work_queue)
+		osd_work_queue_free(m_work_queue);
 }
 
 
@@ -1623,6 +1505,101 @@ tilemap_t &tilemap_manager::create(device_gfx_interface &decoder, tilemap_get_in
 }
 
 
+//-------------------------------------------------
+//  draw - draw a list of layers in order; the
+//  result is the same as calling draw() on each
+//  of them in turn
+//-------------------------------------------------
+
+void tilemap_manager::draw(screen_device &screen, bitmap_ind16 &dest, const rectangle &cliprect, std::initializer_list<tilemap_layer> layers)
+{ draw_layers(screen, dest, cliprect, layers.begin(), layers.size()); }
+
+void tilemap_manager::draw(screen_device &screen, bitmap_rgb32 &dest, const rectangle &cliprect, std::initializer_list<tilemap_layer> layers)
+{ draw_layers(screen, dest, cliprect, layers.begin(), layers.size()); }
+
+
+//-------------------------------------------------
+//  draw_layers - split the cliprect into
+//  horizontal bands drawn concurrently, with
+//  each band drawing all the layers in order;
+//  each pixel sees the same operations in the
+//  same order as when drawing on a single
+//  thread, so the result is identical
+//-------------------------------------------------
+
+template<class _BitmapClass>
+void tilemap_manager::draw_layers(screen_device &screen, _BitmapClass &dest, const rectangle &cliprect, const tilemap_layer *layers, size_t count)
+{
+g_profiler.start(PROFILER_TILEMAP_DRAW);
+	// bring every tile the layers will draw up to date first, so bands
+	// never update tiles
+	m_band_layers.clear();
+	for (size_t index = 0; index < count; index++)
+	{
+		tilemap_t &tmap = layers[index].tilemap;
+		if (!tmap.enabled())
+			continue;
+
+		band_layer &layer = m_band_layers.emplace_back();
+		layer.tilemap = &tmap;
+		tmap.configure_blit_parameters(layer.blit, screen.priority(), cliprect, layers[index].flags, layers[index].priority, layers[index].priority_mask);
+		assert(dest.cliprect().contains(cliprect));
+		assert(screen.cliprect().contains(cliprect) || layer.blit.tilemap_priority_code == 0xff00);
+		tmap.realize_covered_tiles(screen, cliprect);
+	}
+
+	// don't bother splitting small areas
+	int const bands = std::min(m_bands, cliprect.height() / MIN_BAND_HEIGHT);
+	if (!m_band_layers.empty() && (bands > 1) && m_work_queue)
+	{
+		// divide the rows evenly between the bands
+		band_data<_BitmapClass> band[MAX_BANDS];
+		for (int index = 0; index < bands; index++)
+		{
+			band[index].screen = &screen;
+			band[index].dest = &dest;
+			band[index].layers = &m_band_layers;
+			band[index].top = cliprect.top() + cliprect.height() * index / bands;
+			band[index].bottom = cliprect.top() + cliprect.height() * (index + 1) / bands - 1;
+		}
+
+		// queue all but the first band, and draw that one ourselves while we wait
+		osd_work_item_queue_multiple(m_work_queue, draw_band_callback<_BitmapClass>, bands - 1, &band[1], sizeof(band[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		draw_band_callback<_BitmapClass>(&band[0], 0);
+
+		// the bands live on this stack frame, so don't leave until they're all done
+		while (!osd_work_queue_wait(m_work_queue, osd_ticks_per_second()))
+		{
+		}
+	}
+	else
+	{
+		for (band_layer const &layer : m_band_layers)
+			layer.tilemap->draw_band(screen, dest, layer.blit);
+	}
+g_profiler.stop();
+}
+
+
+//-------------------------------------------------
+//  draw_band_callback - work item callback for
+//  drawing all the layers within a single band
+//-------------------------------------------------
+
+template<class _BitmapClass>
+void *tilemap_manager::draw_band_callback(void *param, int threadid)
+{
+	band_data<_BitmapClass> const &band = *reinterpret_cast<band_data<_BitmapClass> const *>(param);
+	for (band_layer const &layer : *band.layers)
+	{
+		tilemap_t::blit_parameters blit = layer.blit;
+		blit.cliprect.sety(std::max(blit.cliprect.top(), band.top), std::min(blit.cliprect.bottom(), band.bottom));
+		layer.tilemap->draw_band(*band.screen, *band.dest, blit);
+	}
+	return nullptr;
+}
+
+
 //-------------------------------------------------
 //  set_flip_all - set a global flip for all the
 //  tilemaps
@@ -287,6 +287,15 @@
     * If you want to render with alpha blending, you can call
         tilemap_t::draw() with the TILEMAP_DRAW_ALPHA flag.
 
+    * If you draw several tilemaps one after another, you can pass them
+        all to tilemap_manager::draw() as a list of tilemap_layer entries
+        instead. With the tilemapthreads option above 1, the cliprect
+        is split into horizontal bands that are drawn concurrently, each
+        band drawing every layer in list order, so the destination and
+        priority bitmaps end up exactly as if the layers had been drawn
+        one at a time. tilemap_t::draw() uses the same bands for a single
+        layer.
+
     * To configure more complex pen-to-layer mapping, use the
         tilemap_t::map_pens_to_layer() call. This call takes a group
         number so that you can configure 1 of the 256 groups
@@ -304,6 +313,8 @@
 #pragma once
 
 #include "memarray.h"
+
+#include <initializer_list>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -531,16 +542,6 @@ private:
 	s32 effective_colscroll(int index, u32 screen_height);
 	bool gfx_elements_changed();
 
-	// inline scanline rasterizers
-	void scanline_draw_opaque_null(int count, u8 *pri, u32 pcode);
-	void scanline_draw_masked_null(const u8 *maskptr, int mask, int value, int count, u8 *pri, u32 pcode);
-	void scanline_draw_opaque_ind16(u16 *dest, const u16 *source, int count, u8 *pri, u32 pcode);
-	void scanline_draw_masked_ind16(u16 *dest, const u16 *source, const u8 *maskptr, int mask, int value, int count, u8 *pri, u32 pcode);
-	void scanline_draw_opaque_rgb32(u32 *dest, const u16 *source, int count, const rgb_t *pens, u8 *pri, u32 pcode);
-	void scanline_draw_masked_rgb32(u32 *dest, const u16 *source, const u8 *maskptr, int mask, int value, int count, const rgb_t *pens, u8 *pri, u32 pcode);
-	void scanline_draw_opaque_rgb32_alpha(u32 *dest, const u16 *source, int count, const rgb_t *pens, u8 *pri, u32 pcode, u8 alpha);
-	void scanline_draw_masked_rgb32_alpha(u32 *dest, const u16 *source, const u8 *maskptr, int mask, int value, int count, const rgb_t *pens, u8 *pri, u32 pcode, u8 alpha);
-
 	// internal helpers
 	void postload();
 	void mappings_create();
@@ -550,10 +551,13 @@ private:
 	// internal drawing
 	void pixmap_update();
 	void tile_update(logical_index logindex, u32 col, u32 row);
+	void realize_covered_tiles(screen_device &screen, const rectangle &cliprect);
 	u8 tile_draw(const u8 *pendata, u32 x0, u32 y0, u32 palette_base, u8 category, u8 group, u8 flags, u8 pen_mask);
 	u8 tile_apply_bitmask(const u8 *maskdata, u32 x0, u32 y0, u8 category, u8 flags);
 	void configure_blit_parameters(blit_parameters &blit, bitmap_ind8 &priority_bitmap, const rectangle &cliprect, u32 flags, u8 priority, u8 priority_mask);
 	template<class _BitmapClass> void draw_common(screen_device &screen, _BitmapClass &dest, const rectangle &cliprect, u32 flags, u8 priority, u8 priority_mask);
+	template<class _BitmapClass> void draw_band(screen_device &screen, _BitmapClass &dest, const blit_parameters &blit);
+	template<typename InstanceFunc> void for_each_instance(screen_device &screen, const rectangle &cliprect, InstanceFunc &&func);
 	template<class _BitmapClass> void draw_roz_common(screen_device &screen, _BitmapClass &dest, const rectangle &cliprect, u32 startx, u32 starty, int incxx, int incxy, int incyx, int incyy, bool wraparound, u32 flags, u8 priority, u8 priority_mask);
 	template<class _BitmapClass> void draw_instance(screen_device &screen, _BitmapClass &dest, const blit_parameters &blit, int xpos, int ypos);
 	template<class _BitmapClass> void draw_roz_core(screen_device &screen, _BitmapClass &destbitmap, const blit_parameters &blit, u32 startx, u32 starty, int incxx, int incxy, int incyx, int incyy, bool wraparound);
@@ -611,6 +615,18 @@ private:
 };
 
 
+// ======================> tilemap_layer
+
+// one layer in a list drawn by tilemap_manager::draw()
+struct tilemap_layer
+{
+	tilemap_t &     tilemap;
+	u32             flags = TILEMAP_DRAW_ALL_CATEGORIES;
+	u8              priority = 0;
+	u8              priority_mask = 0xff;
+};
+
+
 // ======================> tilemap_manager
 
 // tilemap manager
@@ -642,7 +658,32 @@ public:
 	void mark_all_dirty();
 	void set_flip_all(u32 attributes);
 
+	// drawing several layers in order
+	void draw(screen_device &screen, bitmap_ind16 &dest, const rectangle &cliprect, std::initializer_list<tilemap_layer> layers);
+	void draw(screen_device &screen, bitmap_rgb32 &dest, const rectangle &cliprect, std::initializer_list<tilemap_layer> layers);
+
 private:
+	// a layer ready to be drawn in bands
+	struct band_layer
+	{
+		tilemap_t *                         tilemap;
+		tilemap_t::blit_parameters          blit;
+	};
+
+	// a band of rows drawn on its own work item
+	template<class _BitmapClass> struct band_data
+	{
+		screen_device *                     screen;
+		_BitmapClass *                      dest;
+		const std::vector<band_layer> *     layers;
+		s32                                 top;
+		s32                                 bottom;
+	};
+
+	// drawing helpers
+	template<class _BitmapClass> void draw_layers(screen_device &screen, _BitmapClass &dest, const rectangle &cliprect, const tilemap_layer *layers, size_t count);
+	template<class _BitmapClass> static void *draw_band_callback(void *param, int threadid);
+
 	// tilemap creation
 	tilemap_t &create(device_gfx_interface &decoder, tilemap_get_info_delegate tile_get_info, tilemap_mapper_delegate mapper, u16 tilewidth, u16 tileheight, u32 cols, u32 rows, tilemap_t *allocated);
 	tilemap_t &create(device_gfx_interface &decoder, tilemap_get_info_delegate tile_get_info, tilemap_standard_mapper mapper, u16 tilewidth, u16 tileheight, u32 cols, u32 rows, tilemap_t *allocated);
@@ -654,6 +695,9 @@ private:
 	running_machine &       m_machine;
 	simple_list<tilemap_t>  m_tilemap_list;
 	int                     m_instance;
+	osd_work_queue *        m_work_queue;           // work queue for drawing in bands
+	int                     m_bands;                // maximum number of bands to draw concurrently
+	std::vector<band_layer> m_band_layers;          // layers being drawn in bands
 };
 
 
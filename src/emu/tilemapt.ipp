@@ -0,0 +1,522 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    tilemapt.ipp
+
+    Scanline rasterizers for the generic tilemap system.
+
+***************************************************************************/
+
+#ifndef MAME_EMU_TILEMAPT_IPP
+#define MAME_EMU_TILEMAPT_IPP
+
+#pragma once
+
+#include <cstring>
+
+// use SSE2 kernels where it can be assumed, as rgbutil.h does
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define MAME_TILEMAP_SSE2
+#include <emmintrin.h>
+
+// palette lookups can also use AVX2 gathers, compiled for AVX2 whatever the
+// build targets and only used once host_has_avx2() says they can be
+#if defined(__GNUC__) || defined(_MSC_VER)
+#define MAME_TILEMAP_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+
+//**************************************************************************
+//  SCANLINE RASTERIZERS
+//**************************************************************************
+
+// The rasterizers take a priority code of the form pal << 16 | mask << 8 | code;
+// a low word of 0xff00 means the priority bitmap is left untouched.  The scalar
+// loops are the reference for the vector kernels and are used when Vectorize is
+// false or SSE2 can't be assumed.  Palette lookups into RGB32 bitmaps use AVX2
+// gathers when the host CPU supports them.
+
+template <bool Vectorize = true>
+class tilemap_scanline
+{
+#if defined(MAME_TILEMAP_SSE2)
+	static constexpr bool VectorKernels = Vectorize;
+#else
+	static constexpr bool VectorKernels = false;
+#endif
+
+public:
+	//-------------------------------------------------
+	//  opaque_null - draw to a nullptr bitmap,
+	//  setting priority only
+	//-------------------------------------------------
+
+	static void opaque_null(int count, u8 *pri, u32 pcode)
+	{
+		// skip entirely if not changing priority
+		if (pcode == 0xff00)
+			return;
+
+		// update priority across the scanline
+		int i = 0;
+		if constexpr (VectorKernels)
+			i = priority_opaque(count, pri, pcode);
+		for ( ; i < count; i++)
+			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
+	}
+
+
+	//-------------------------------------------------
+	//  masked_null - draw to a nullptr bitmap using
+	//  a mask, setting priority only
+	//-------------------------------------------------
+
+	static void masked_null(const u8 *maskptr, int mask, int value, int count, u8 *pri, u32 pcode)
+	{
+		// skip entirely if not changing priority
+		if (pcode == 0xff00)
+			return;
+
+		// update priority across the scanline, checking the mask
+		int i = 0;
+		if constexpr (VectorKernels)
+		{
+			if (!mask_reachable(mask, value))
+				return;
+			i = priority_masked(maskptr, mask, value, count, pri, pcode);
+		}
+		for ( ; i < count; i++)
+			if ((maskptr[i] & mask) == value)
+				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
+	}
+
+
+	//-------------------------------------------------
+	//  opaque_ind16 - draw to a 16bpp indexed bitmap
+	//-------------------------------------------------
+
+	static void opaque_ind16(u16 *dest, const u16 *source, int count, u8 *pri, u32 pcode)
+	{
+		// special case for no palette offset
+		int pal = pcode >> 16;
+		if (pal == 0)
+		{
+			// use memcpy which should be well-optimized for the platform
+			memcpy(dest, source, count * 2);
+
+			// skip the rest if not changing priority
+			if (pcode == 0xff00)
+				return;
+
+			// update priority across the scanline
+			int i = 0;
+			if constexpr (VectorKernels)
+				i = priority_opaque(count, pri, pcode);
+			for ( ; i < count; i++)
+				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
+		}
+
+		// priority case
+		else if ((pcode & 0xffff) != 0xff00)
+		{
+			int i = 0;
+#if defined(MAME_TILEMAP_SSE2)
+			if constexpr (VectorKernels)
+			{
+				__m128i const palette = _mm_set1_epi16(pal);
+				__m128i const pmask = _mm_set1_epi8(pcode >> 8);
+				__m128i const pval = _mm_set1_epi8(pcode);
+				for ( ; (i + 16) <= count; i += 16)
+				{
+					__m128i const src0 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(&source[i]));
+					__m128i const src1 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(&source[i + 8]));
+					_mm_storeu_si128(reinterpret_cast<__m128i *>(&dest[i]), _mm_add_epi16(src0, palette));
+					_mm_storeu_si128(reinterpret_cast<__m128i *>(&dest[i + 8]), _mm_add_epi16(src1, palette));
+					__m128i const prival = _mm_loadu_si128(reinterpret_cast<__m128i const *>(&pri[i]));
+					_mm_storeu_si128(reinterpret_cast<__m128i *>(&pri[i]), update_priority(prival, pmask, pval));
+				}
+			}
+#endif
+			for ( ; i < count; i++)
+			{
+				dest[i] = source[i] + pal;
+				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
+			}
+		}
+
+		// no priority case
+		else
+		{
+			int i = 0;
+#if defined(MAME_TILEMAP_SSE2)
+			if constexpr (VectorKernels)
+			{
+				__m128i const palette = _mm_set1_epi16(pal);
+				for ( ; (i + 8) <= count; i += 8)
+				{
+					__m128i const src = _mm_loadu_si128(reinterpret_cast<__m128i const *>(&source[i]));
+					_mm_storeu_si128(reinterpret_cast<__m128i *>(&dest[i]), _mm_add_epi16(src, palette));
+				}
+			}
+#endif
+			for ( ; i < count; i++)
+				dest[i] = source[i] + pal;
+		}
+	}
+
+
+	//-------------------------------------------------
+	//  masked_ind16 - draw to a 16bpp indexed bitmap
+	//  using a mask
+	//-------------------------------------------------
+
+	static void masked_ind16(u16 *dest, const u16 *source, const u8 *maskptr, int mask, int value, int count, u8 *pri, u32 pcode)
+	{
+		int pal = pcode >> 16;
+		int i = 0;
+#if defined(MAME_TILEMAP_SSE2)
+		if constexpr (VectorKernels)
+		{
+			if (!mask_reachable(mask, value))
+				return;
+
+			bool const update = (pcode & 0xffff) != 0xff00;
+			__m128i const palette = _mm_set1_epi16(pal);
+			__m128i const maskvec = _mm_set1_epi8(mask);
+			__m128i const valuevec = _mm_set1_epi8(value);
+			__m128i const pmask = _mm_set1_epi8(pcode >> 8);
+			__m128i const pval = _mm_set1_epi8(pcode);
+			for ( ; (i + 16) <= count; i += 16)
+			{
+				__m128i const select = select_pixels(&maskptr[i], maskvec, valuevec);
+				__m128i const dst0 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(&dest[i]));
+				__m128i const dst1 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(&dest[i + 8]));
+				__m128i const src0 = _mm_add_epi16(_mm_loadu_si128(reinterpret_cast<__m128i const *>(&source[i])), palette);
+				__m128i const src1 = _mm_add_epi16(_mm_loadu_si128(reinterpret_cast<__m128i const *>(&source[i + 8])), palette);
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(&dest[i]), blend(_mm_unpacklo_epi8(select, select), src0, dst0));
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(&dest[i + 8]), blend(_mm_unpackhi_epi8(select, select), src1, dst1));
+				if (update)
+				{
+					__m128i const prival = _mm_loadu_si128(reinterpret_cast<__m128i const *>(&pri[i]));
+					_mm_storeu_si128(reinterpret_cast<__m128i *>(&pri[i]), blend(select, update_priority(prival, pmask, pval), prival));
+				}
+			}
+		}
+#endif
+
+		// priority case
+		if ((pcode & 0xffff) != 0xff00)
+		{
+			for ( ; i < count; i++)
+				if ((maskptr[i] & mask) == value)
+				{
+					dest[i] = source[i] + pal;
+					pri[i] = (pri[i] & (pcode >> 8)) | pcode;
+				}
+		}
+
+		// no priority case
+		else
+		{
+			for ( ; i < count; i++)
+				if ((maskptr[i] & mask) == value)
+					dest[i] = source[i] + pal;
+		}
+	}
+
+
+	//-------------------------------------------------
+	//  opaque_rgb32 - draw to a 32bpp RGB bitmap
+	//-------------------------------------------------
+
+	static void opaque_rgb32(u32 *dest, const u16 *source, int count, const rgb_t *pens, u8 *pri, u32 pcode)
+	{
+		const rgb_t *clut = &pens[pcode >> 16];
+
+		// the palette lookup is a gather, so without AVX2 the vector kernels
+		// only take over the priority update
+		if constexpr (VectorKernels)
+		{
+			for (int i = lookup_opaque(dest, source, count, clut); i < count; i++)
+				dest[i] = clut[source[i]];
+			if ((pcode & 0xffff) != 0xff00)
+				for (int i = priority_opaque(count, pri, pcode); i < count; i++)
+					pri[i] = (pri[i] & (pcode >> 8)) | pcode;
+		}
+
+		// priority case
+		else if ((pcode & 0xffff) != 0xff00)
+		{
+			for (int i = 0; i < count; i++)
+			{
+				dest[i] = clut[source[i]];
+				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
+			}
+		}
+
+		// no priority case
+		else
+		{
+			for (int i = 0; i < count; i++)
+				dest[i] = clut[source[i]];
+		}
+	}
+
+
+	//-------------------------------------------------
+	//  masked_rgb32 - draw to a 32bpp RGB bitmap
+	//  using a mask
+	//-------------------------------------------------
+
+	static void masked_rgb32(u32 *dest, const u16 *source, const u8 *maskptr, int mask, int value, int count, const rgb_t *pens, u8 *pri, u32 pcode)
+	{
+		const rgb_t *clut = &pens[pcode >> 16];
+		int i = 0;
+#if defined(MAME_TILEMAP_AVX2)
+		if constexpr (VectorKernels)
+		{
+			// gather just the selected pixels, then update priority separately
+			if (host_has_avx2())
+			{
+				if (!mask_reachable(mask, value))
+					return;
+				for (i = lookup_masked_avx2(dest, source, maskptr, mask, value, count, clut); i < count; i++)
+					if ((maskptr[i] & mask) == value)
+						dest[i] = clut[source[i]];
+				if ((pcode & 0xffff) != 0xff00)
+					for (i = priority_masked(maskptr, mask, value, count, pri, pcode); i < count; i++)
+						if ((maskptr[i] & mask) == value)
+							pri[i] = (pri[i] & (pcode >> 8)) | pcode;
+				return;
+			}
+		}
+#endif
+#if defined(MAME_TILEMAP_SSE2)
+		if constexpr (VectorKernels)
+		{
+			if (!mask_reachable(mask, value))
+				return;
+
+			// look up every pixel and select the results without branching
+			bool const update = (pcode & 0xffff) != 0xff00;
+			__m128i const maskvec = _mm_set1_epi8(mask);
+			__m128i const valuevec = _mm_set1_epi8(value);
+			__m128i const pmask = _mm_set1_epi8(pcode >> 8);
+			__m128i const pval = _mm_set1_epi8(pcode);
+			for ( ; (i + 16) <= count; i += 16)
+			{
+				__m128i const select = select_pixels(&maskptr[i], maskvec, valuevec);
+				__m128i const select16[2] = { _mm_unpacklo_epi8(select, select), _mm_unpackhi_epi8(select, select) };
+				for (int j = 0; j < 4; j++)
+				{
+					u16 const *const src = &source[i + (j * 4)];
+					__m128i *const dst = reinterpret_cast<__m128i *>(&dest[i + (j * 4)]);
+					__m128i const select32 = (j & 1) ? _mm_unpackhi_epi16(select16[j >> 1], select16[j >> 1]) : _mm_unpacklo_epi16(select16[j >> 1], select16[j >> 1]);
+					__m128i const color = _mm_setr_epi32(clut[src[0]], clut[src[1]], clut[src[2]], clut[src[3]]);
+					_mm_storeu_si128(dst, blend(select32, color, _mm_loadu_si128(dst)));
+				}
+				if (update)
+				{
+					__m128i const prival = _mm_loadu_si128(reinterpret_cast<__m128i const *>(&pri[i]));
+					_mm_storeu_si128(reinterpret_cast<__m128i *>(&pri[i]), blend(select, update_priority(prival, pmask, pval), prival));
+				}
+			}
+		}
+#endif
+
+		// priority case
+		if ((pcode & 0xffff) != 0xff00)
+		{
+			for ( ; i < count; i++)
+				if ((maskptr[i] & mask) == value)
+				{
+					dest[i] = clut[source[i]];
+					pri[i] = (pri[i] & (pcode >> 8)) | pcode;
+				}
+		}
+
+		// no priority case
+		else
+		{
+			for ( ; i < count; i++)
+				if ((maskptr[i] & mask) == value)
+					dest[i] = clut[source[i]];
+		}
+	}
+
+
+	//-------------------------------------------------
+	//  opaque_rgb32_alpha - draw to a 32bpp RGB
+	//  bitmap with alpha blending
+	//-------------------------------------------------
+
+	static void opaque_rgb32_alpha(u32 *dest, const u16 *source, int count, const rgb_t *pens, u8 *pri, u32 pcode, u8 alpha)
+	{
+		const rgb_t *clut = &pens[pcode >> 16];
+
+		// blending stays scalar; the vector kernels only take over the priority update
+		if constexpr (VectorKernels)
+		{
+			for (int i = 0; i < count; i++)
+				dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
+			if ((pcode & 0xffff) != 0xff00)
+				for (int i = priority_opaque(count, pri, pcode); i < count; i++)
+					pri[i] = (pri[i] & (pcode >> 8)) | pcode;
+		}
+
+		// priority case
+		else if ((pcode & 0xffff) != 0xff00)
+		{
+			for (int i = 0; i < count; i++)
+			{
+				dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
+				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
+			}
+		}
+
+		// no priority case
+		else
+		{
+			for (int i = 0; i < count; i++)
+				dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
+		}
+	}
+
+
+	//-------------------------------------------------
+	//  masked_rgb32_alpha - draw to a 32bpp RGB
+	//  bitmap using a mask and alpha blending
+	//-------------------------------------------------
+
+	static void masked_rgb32_alpha(u32 *dest, const u16 *source, const u8 *maskptr, int mask, int value, int count, const rgb_t *pens, u8 *pri, u32 pcode, u8 alpha)
+	{
+		const rgb_t *clut = &pens[pcode >> 16];
+
+		// blending stays scalar; the vector kernels only take over the priority update
+		if constexpr (VectorKernels)
+		{
+			if (!mask_reachable(mask, value))
+				return;
+			for (int i = 0; i < count; i++)
+				if ((maskptr[i] & mask) == value)
+					dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
+			if ((pcode & 0xffff) != 0xff00)
+				for (int i = priority_masked(maskptr, mask, value, count, pri, pcode); i < count; i++)
+					if ((maskptr[i] & mask) == value)
+						pri[i] = (pri[i] & (pcode >> 8)) | pcode;
+		}
+
+		// priority case
+		else if ((pcode & 0xffff) != 0xff00)
+		{
+			for (int i = 0; i < count; i++)
+				if ((maskptr[i] & mask) == value)
+				{
+					dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
+					pri[i] = (pri[i] & (pcode >> 8)) | pcode;
+				}
+		}
+
+		// no priority case
+		else
+		{
+			for (int i = 0; i < count; i++)
+				if ((maskptr[i] & mask) == value)
+					dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
+		}
+	}
+
+private:
+	// the mask bytes are compared 8 bits at a time, so a value with bits outside
+	// the mask can't match any pixel
+	static constexpr bool mask_reachable(int mask, int value) { return (value & ~(mask & 0xff)) == 0; }
+
+#if defined(MAME_TILEMAP_SSE2)
+	static __m128i blend(__m128i select, __m128i a, __m128i b) { return _mm_or_si128(_mm_and_si128(select, a), _mm_andnot_si128(select, b)); }
+	static __m128i update_priority(__m128i pri, __m128i pmask, __m128i pval) { return _mm_or_si128(_mm_and_si128(pri, pmask), pval); }
+
+	static __m128i select_pixels(const u8 *maskptr, __m128i mask, __m128i value)
+	{
+		__m128i const flags = _mm_loadu_si128(reinterpret_cast<__m128i const *>(maskptr));
+		return _mm_cmpeq_epi8(_mm_and_si128(flags, mask), value);
+	}
+
+	// update priority 16 pixels at a time, returning the number handled
+	static int priority_opaque(int count, u8 *pri, u32 pcode)
+	{
+		__m128i const pmask = _mm_set1_epi8(pcode >> 8);
+		__m128i const pval = _mm_set1_epi8(pcode);
+		int i = 0;
+		for ( ; (i + 16) <= count; i += 16)
+		{
+			__m128i *const dst = reinterpret_cast<__m128i *>(&pri[i]);
+			_mm_storeu_si128(dst, update_priority(_mm_loadu_si128(dst), pmask, pval));
+		}
+		return i;
+	}
+
+	static int priority_masked(const u8 *maskptr, int mask, int value, int count, u8 *pri, u32 pcode)
+	{
+		__m128i const maskvec = _mm_set1_epi8(mask);
+		__m128i const valuevec = _mm_set1_epi8(value);
+		__m128i const pmask = _mm_set1_epi8(pcode >> 8);
+		__m128i const pval = _mm_set1_epi8(pcode);
+		int i = 0;
+		for ( ; (i + 16) <= count; i += 16)
+		{
+			__m128i *const dst = reinterpret_cast<__m128i *>(&pri[i]);
+			__m128i const prival = _mm_loadu_si128(dst);
+			_mm_storeu_si128(dst, blend(select_pixels(&maskptr[i], maskvec, valuevec), update_priority(prival, pmask, pval), prival));
+		}
+		return i;
+	}
+#else
+	static int priority_opaque(int count, u8 *pri, u32 pcode) { return 0; }
+	static int priority_masked(const u8 *maskptr, int mask, int value, int count, u8 *pri, u32 pcode) { return 0; }
+#endif
+
+#if defined(MAME_TILEMAP_AVX2)
+	// look up palette entries 8 pixels at a time, returning the number handled
+	static int lookup_opaque(u32 *dest, const u16 *source, int count, const rgb_t *clut)
+	{
+		return host_has_avx2() ? lookup_opaque_avx2(dest, source, count, clut) : 0;
+	}
+
+	ATTR_TARGET_AVX2 static int lookup_opaque_avx2(u32 *dest, const u16 *source, int count, const rgb_t *clut)
+	{
+		int const *const base = reinterpret_cast<int const *>(clut);
+		int i = 0;
+		for ( ; (i + 8) <= count; i += 8)
+		{
+			__m256i const index = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const *>(&source[i])));
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(&dest[i]), _mm256_i32gather_epi32(base, index, 4));
+		}
+		return i;
+	}
+
+	// the same, leaving pixels whose mask flags don't match untouched
+	ATTR_TARGET_AVX2 static int lookup_masked_avx2(u32 *dest, const u16 *source, const u8 *maskptr, int mask, int value, int count, const rgb_t *clut)
+	{
+		int const *const base = reinterpret_cast<int const *>(clut);
+		__m256i const maskvec = _mm256_set1_epi32(mask & 0xff);
+		__m256i const valuevec = _mm256_set1_epi32(value);
+		int i = 0;
+		for ( ; (i + 8) <= count; i += 8)
+		{
+			__m256i const flags = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<__m128i const *>(&maskptr[i])));
+			__m256i const select = _mm256_cmpeq_epi32(_mm256_and_si256(flags, maskvec), valuevec);
+			__m256i const index = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const *>(&source[i])));
+			__m256i *const dst = reinterpret_cast<__m256i *>(&dest[i]);
+			_mm256_storeu_si256(dst, _mm256_mask_i32gather_epi32(_mm256_loadu_si256(dst), base, index, select, 4));
+		}
+		return i;
+	}
+#else
+	static int lookup_opaque(u32 *dest, const u16 *source, int count, const rgb_t *clut) { return 0; }
+#endif
+};
+
+#endif // MAME_EMU_TILEMAPT_IPP
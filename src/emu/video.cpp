@@ -107,6 +107,11 @@ video_manager::video_manager(running_machine &machine)
 	, m_snap_native(true)
 	, m_snap_width(0)
 	, m_snap_height(0)
+	, m_snap_queue(nullptr)
+	, m_snap_bands(machine.options().render_threads())
+	, m_snap_sequence(0)
+	, m_snap_drawn_bilinear(false)
+	, m_snap_serial(0)
 {
 	// request a callback upon exiting
 	machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(&video_manager::exit, this));
@@ -118,6 +123,10 @@ video_manager::video_manager(running_machine &machine)
 	const unsigned screen_count(screen_device_enumerator(machine.root_device()).count());
 	const bool no_screens(!screen_count);
 
+	// snapshots and movies are rendered in software, so split them up if requested
+	if (m_snap_bands > 1)
+		m_snap_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+
 	// create a render target for snapshots
 	const char *viewname = machine.options().snap_view();
 	m_snap_native = !no_screens && !strcmp(viewname, "native");
@@ -498,6 +507,11 @@ void video_manager::exit()
 	// free the snapshot target
 	machine().render().target_free(m_snap_target);
 	m_snap_bitmap.reset();
+	if (m_snap_queue)
+	{
+		osd_work_queue_free(m_snap_queue);
+		m_snap_queue = nullptr;
+	}
 
 	// print a final result if we have at least 2 seconds' worth of data
 	if (!emulator_info::standalone() && m_overall_emutime.seconds() >= 1)
@@ -1049,15 +1063,36 @@ void video_manager::create_snapshot_bitmap(screen_device *screen)
 	compute_snapshot_size(width, height);
 	m_snap_target->set_bounds(width, height);
 	if (width != m_snap_bitmap.width() || height != m_snap_bitmap.height())
+	{
 		m_snap_bitmap.resize(width, height);
+		m_snap_sequence = 0;
+	}
 
-	// render the screen there
+	// render the screen there, redrawing only what changed if the bitmap holds the previous list
 	render_primitive_list &primlist = m_snap_target->get_primitives();
 	primlist.acquire_lock();
-	if (machine().options().snap_bilinear())
-		snap_renderer_bilinear::draw_primitives(primlist, &m_snap_bitmap.pix(0), width, height, m_snap_bitmap.rowpixels());
+	bool const bilinear = machine().options().snap_bilinear();
+	bool const partial = (m_snap_sequence != 0) && (primlist.previous_sequence() == m_snap_sequence) && (bilinear == m_snap_drawn_bilinear);
+	if (partial)
+	{
+		m_snap_dirty = primlist.dirty();
+		m_snap_dirty &= m_snap_bitmap.cliprect();
+		if (bilinear)
+			snap_renderer_bilinear::draw_dirty_primitives(primlist, &m_snap_bitmap.pix(0), width, height, m_snap_bitmap.rowpixels(), m_snap_queue, m_snap_bands);
+		else
+			snap_renderer::draw_dirty_primitives(primlist, &m_snap_bitmap.pix(0), width, height, m_snap_bitmap.rowpixels(), m_snap_queue, m_snap_bands);
+	}
 	else
-		snap_renderer::draw_primitives(primlist, &m_snap_bitmap.pix(0), width, height, m_snap_bitmap.rowpixels());
+	{
+		m_snap_dirty = m_snap_bitmap.cliprect();
+		if (bilinear)
+			snap_renderer_bilinear::draw_primitives(primlist, &m_snap_bitmap.pix(0), width, height, m_snap_bitmap.rowpixels(), m_snap_queue, m_snap_bands);
+		else
+			snap_renderer::draw_primitives(primlist, &m_snap_bitmap.pix(0), width, height, m_snap_bitmap.rowpixels(), m_snap_queue, m_snap_bands);
+	}
+	m_snap_sequence = primlist.sequence();
+	m_snap_drawn_bilinear = bilinear;
+	m_snap_serial++;
 	primlist.release_lock();
 }
 
@@ -1251,8 +1286,10 @@ void video_manager::record_frame()
 		// create the bitmap
 		create_snapshot_bitmap(recording->screen());
 
-		// and append the frame
-		if (!recording->append_video_frame(m_snap_bitmap, curtime))
+		// and append the frame; the redrawn area only counts if nothing else drew in between
+		rectangle const dirty = (recording->snapshot_serial() + 1 == m_snap_serial) ? m_snap_dirty : m_snap_bitmap.cliprect();
+		recording->set_snapshot_serial(m_snap_serial);
+		if (!recording->append_video_frame(m_snap_bitmap, dirty, curtime))
 		{
 			error = true;
 			break;
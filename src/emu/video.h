@@ -163,6 +163,12 @@ private:
 	bool                m_snap_native;              // are we using native per-screen layouts?
 	s32                 m_snap_width;               // width of snapshots (0 == auto)
 	s32                 m_snap_height;              // height of snapshots (0 == auto)
+	osd_work_queue *    m_snap_queue;               // work queue for rendering snapshots in bands
+	int                 m_snap_bands;               // number of bands to render snapshots in
+	u64                 m_snap_sequence;            // primitive list last drawn into the snapshot bitmap
+	bool                m_snap_drawn_bilinear;      // whether that list was drawn with bilinear filtering
+	u64                 m_snap_serial;              // number of times the snapshot bitmap has been drawn
+	rectangle           m_snap_dirty;               // area of the snapshot bitmap changed by the last draw
 
 	// movie recordings
 	std::vector<movie_recording::ptr> m_movie_recordings;
@@ -0,0 +1,176 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    rgbavx.h
+
+    AVX2 optimized RGB batch utilities, processing eight pixels at a time.
+
+    WARNING: This code assumes AVX2 capability.  Only include it where
+    AVX2 code generation is enabled and only run it once the CPU is known
+    to support AVX2; rgbspan.cpp does both.
+
+    Each 256-bit register holds two pixels in the same channel order as
+    the SSE rgbaint_t, so results match it exactly.
+
+***************************************************************************/
+
+#ifndef MAME_EMU_VIDEO_RGBAVX_H
+#define MAME_EMU_VIDEO_RGBAVX_H
+
+#pragma once
+
+#include <immintrin.h>
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+class rgbaint_avx2_batch_t
+{
+public:
+	static constexpr int PIXELS = 8;
+
+	rgbaint_avx2_batch_t() { }
+	explicit rgbaint_avx2_batch_t(const u32 *rgba) { load(rgba); }
+
+	// load and store packed pixels; stores clamp each channel to 0-255
+	void load(const u32 *rgba)
+	{
+		for (int i = 0; i < REGS; i++)
+			m_value[i] = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)&rgba[i * 2]));
+	}
+
+	void store(u32 *rgba) const
+	{
+		// packing works within 128-bit lanes, leaving pixels in the order 0 2 4 6 1 3 5 7
+		__m256i const lo = _mm256_packs_epi32(m_value[0], m_value[1]);
+		__m256i const hi = _mm256_packs_epi32(m_value[2], m_value[3]);
+		__m256i const packed = _mm256_packus_epi16(lo, hi);
+		_mm256_storeu_si256((__m256i *)rgba, _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7)));
+	}
+
+	// access to individual pixels
+	rgbaint_t get(int index) const
+	{
+		return rgbaint_t((index & 1) ? _mm256_extracti128_si256(m_value[index >> 1], 1) : _mm256_castsi256_si128(m_value[index >> 1]));
+	}
+
+	void set(int index, const rgbaint_t& pixel)
+	{
+		__m128i const value = _mm_set_epi32(pixel.get_a32(), pixel.get_r32(), pixel.get_g32(), pixel.get_b32());
+		m_value[index >> 1] = (index & 1) ? _mm256_inserti128_si256(m_value[index >> 1], value, 1) : _mm256_inserti128_si256(m_value[index >> 1], value, 0);
+	}
+
+	void set_all(const s32& val) { for (__m256i &value : m_value) value = _mm256_set1_epi32(val); }
+	void zero() { for (__m256i &value : m_value) value = _mm256_setzero_si256(); }
+
+	void add(const rgbaint_avx2_batch_t& other) { for (int i = 0; i < REGS; i++) m_value[i] = _mm256_add_epi32(m_value[i], other.m_value[i]); }
+	void sub(const rgbaint_avx2_batch_t& other) { for (int i = 0; i < REGS; i++) m_value[i] = _mm256_sub_epi32(m_value[i], other.m_value[i]); }
+	void mul(const rgbaint_avx2_batch_t& other) { for (int i = 0; i < REGS; i++) m_value[i] = _mm256_mullo_epi32(m_value[i], other.m_value[i]); }
+	void mul_imm(const s32 imm) { for (__m256i &value : m_value) value = _mm256_mullo_epi32(value, _mm256_set1_epi32(imm)); }
+
+	void shl_imm(const u8 shift) { for (__m256i &value : m_value) value = _mm256_slli_epi32(value, shift); }
+	void shr_imm(const u8 shift) { for (__m256i &value : m_value) value = _mm256_srli_epi32(value, shift); }
+	void sra_imm(const u8 shift) { for (__m256i &value : m_value) value = _mm256_srai_epi32(value, shift); }
+
+	void or_reg(const rgbaint_avx2_batch_t& other) { for (int i = 0; i < REGS; i++) m_value[i] = _mm256_or_si256(m_value[i], other.m_value[i]); }
+	void and_reg(const rgbaint_avx2_batch_t& other) { for (int i = 0; i < REGS; i++) m_value[i] = _mm256_and_si256(m_value[i], other.m_value[i]); }
+	void and_imm(s32 value) { for (__m256i &reg : m_value) reg = _mm256_and_si256(reg, _mm256_set1_epi32(value)); }
+
+	void clamp_to_uint8()
+	{
+		for (__m256i &value : m_value)
+			value = _mm256_min_epi32(_mm256_max_epi32(value, _mm256_setzero_si256()), _mm256_set1_epi32(0xff));
+	}
+
+	// blend with a common factor, or a factor per pixel
+	void blend(const rgbaint_avx2_batch_t& other, u8 factor)
+	{
+		__m256i const scale1 = _mm256_set1_epi32(factor);
+		__m256i const scale2 = _mm256_sub_epi32(_mm256_set1_epi32(0x100), scale1);
+		for (int i = 0; i < REGS; i++)
+			m_value[i] = blend(m_value[i], other.m_value[i], scale1, scale2);
+	}
+
+	void blend(const rgbaint_avx2_batch_t& other, const u8 *factors)
+	{
+		__m256i const allfactors = load_factors(factors);
+		__m256i index = first_pixel_index();
+		for (int i = 0; i < REGS; i++, index = next_pixel_index(index))
+		{
+			__m256i const scale1 = _mm256_permutevar8x32_epi32(allfactors, index);
+			__m256i const scale2 = _mm256_sub_epi32(_mm256_set1_epi32(0x100), scale1);
+			m_value[i] = blend(m_value[i], other.m_value[i], scale1, scale2);
+		}
+	}
+
+	void scale_and_clamp(const rgbaint_avx2_batch_t& scale)
+	{
+		mul(scale);
+		sra_imm(8);
+		clamp_to_uint8();
+	}
+
+	static void bilinear_filter(u32 *dest, const u32 *rgb00, const u32 *rgb01, const u32 *rgb10, const u32 *rgb11, const u8 *u, const u8 *v)
+	{
+		rgbaint_avx2_batch_t result;
+		result.bilinear_filter_rgbaint(rgb00, rgb01, rgb10, rgb11, u, v);
+		result.store(dest);
+	}
+
+	// computes the same intermediate values as the SSE version, so the
+	// results are bit-identical
+	void bilinear_filter_rgbaint(const u32 *rgb00, const u32 *rgb01, const u32 *rgb10, const u32 *rgb11, const u8 *u, const u8 *v)
+	{
+		__m256i const allu = load_factors(u);
+		__m256i const allv = load_factors(v);
+		__m256i const c256 = _mm256_set1_epi32(0x100);
+		__m256i index = first_pixel_index();
+		for (int i = 0; i < REGS; i++, index = next_pixel_index(index))
+		{
+			__m256i const color00 = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)&rgb00[i * 2]));
+			__m256i const color01 = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)&rgb01[i * 2]));
+			__m256i const color10 = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)&rgb10[i * 2]));
+			__m256i const color11 = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)&rgb11[i * 2]));
+			__m256i const scaleu = _mm256_permutevar8x32_epi32(allu, index);
+			__m256i const scalev = _mm256_permutevar8x32_epi32(allv, index);
+
+			// horizontal results fit in 16 bits, so 16-bit multiplies are enough
+			__m256i const invu = _mm256_sub_epi32(c256, scaleu);
+			__m256i top = _mm256_add_epi32(_mm256_mullo_epi16(color01, scaleu), _mm256_mullo_epi16(color00, invu));
+			__m256i bottom = _mm256_add_epi32(_mm256_mullo_epi16(color11, scaleu), _mm256_mullo_epi16(color10, invu));
+
+			// halve them and pair bottom with top so one multiply-add does the vertical step
+			top = _mm256_slli_epi32(_mm256_srli_epi32(top, 1), 16);
+			bottom = _mm256_srli_epi32(bottom, 1);
+			__m256i const scales = _mm256_or_si256(scalev, _mm256_slli_epi32(_mm256_sub_epi32(c256, scalev), 16));
+			m_value[i] = _mm256_srli_epi32(_mm256_madd_epi16(_mm256_or_si256(top, bottom), scales), 15);
+		}
+	}
+
+protected:
+	static constexpr int REGS = PIXELS / 2;
+
+	// widen eight 8-bit factors to 32 bits, one per pixel
+	static __m256i load_factors(const u8 *factors)
+	{
+		return _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)factors));
+	}
+
+	// permute indices replicating the factors for the two pixels held in
+	// each register across their channels, stepped from one register to
+	// the next rather than rebuilt each time
+	static __m256i first_pixel_index() { return _mm256_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1); }
+	static __m256i next_pixel_index(__m256i index) { return _mm256_add_epi32(index, _mm256_set1_epi32(2)); }
+
+	static __m256i blend(__m256i value, __m256i other, __m256i scale1, __m256i scale2)
+	{
+		return _mm256_srai_epi32(_mm256_add_epi32(_mm256_mullo_epi32(value, scale1), _mm256_mullo_epi32(other, scale2)), 8);
+	}
+
+	__m256i m_value[REGS];
+};
+
+#endif // MAME_EMU_VIDEO_RGBAVX_H
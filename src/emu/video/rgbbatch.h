@@ -0,0 +1,76 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    rgbbatch.h
+
+    General RGB batch utilities, processing eight pixels at a time using
+    the selected rgbaint_t implementation for each one.
+
+***************************************************************************/
+
+#ifndef MAME_EMU_VIDEO_RGBBATCH_H
+#define MAME_EMU_VIDEO_RGBBATCH_H
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+class rgbaint_batch_t
+{
+public:
+	static constexpr int PIXELS = 8;
+
+	rgbaint_batch_t() { }
+	explicit rgbaint_batch_t(const u32 *rgba) { load(rgba); }
+
+	// load and store packed pixels; stores clamp each channel to 0-255
+	void load(const u32 *rgba) { for (int i = 0; i < PIXELS; i++) m_pixel[i].set(rgba[i]); }
+	void store(u32 *rgba) const { for (int i = 0; i < PIXELS; i++) rgba[i] = m_pixel[i].to_rgba_clamp(); }
+
+	// access to individual pixels
+	rgbaint_t get(int index) const { return m_pixel[index]; }
+	void set(int index, const rgbaint_t& pixel) { m_pixel[index] = pixel; }
+
+	void set_all(const s32& val) { for (rgbaint_t &pixel : m_pixel) pixel.set_all(val); }
+	void zero() { for (rgbaint_t &pixel : m_pixel) pixel.zero(); }
+
+	void add(const rgbaint_batch_t& other) { for (int i = 0; i < PIXELS; i++) m_pixel[i].add(other.m_pixel[i]); }
+	void sub(const rgbaint_batch_t& other) { for (int i = 0; i < PIXELS; i++) m_pixel[i].sub(other.m_pixel[i]); }
+	void mul(const rgbaint_batch_t& other) { for (int i = 0; i < PIXELS; i++) m_pixel[i].mul(other.m_pixel[i]); }
+	void mul_imm(const s32 imm) { for (rgbaint_t &pixel : m_pixel) pixel.mul_imm(imm); }
+
+	void shl_imm(const u8 shift) { for (rgbaint_t &pixel : m_pixel) pixel.shl_imm(shift); }
+	void shr_imm(const u8 shift) { for (rgbaint_t &pixel : m_pixel) pixel.shr_imm(shift); }
+	void sra_imm(const u8 shift) { for (rgbaint_t &pixel : m_pixel) pixel.sra_imm(shift); }
+
+	void or_reg(const rgbaint_batch_t& other) { for (int i = 0; i < PIXELS; i++) m_pixel[i].or_reg(other.m_pixel[i]); }
+	void and_reg(const rgbaint_batch_t& other) { for (int i = 0; i < PIXELS; i++) m_pixel[i].and_reg(other.m_pixel[i]); }
+	void and_imm(s32 value) { for (rgbaint_t &pixel : m_pixel) pixel.and_imm(value); }
+
+	void clamp_to_uint8() { for (rgbaint_t &pixel : m_pixel) pixel.clamp_to_uint8(); }
+
+	// blend with a common factor, or a factor per pixel
+	void blend(const rgbaint_batch_t& other, u8 factor) { for (int i = 0; i < PIXELS; i++) m_pixel[i].blend(other.m_pixel[i], factor); }
+	void blend(const rgbaint_batch_t& other, const u8 *factors) { for (int i = 0; i < PIXELS; i++) m_pixel[i].blend(other.m_pixel[i], factors[i]); }
+
+	void scale_and_clamp(const rgbaint_batch_t& scale) { for (int i = 0; i < PIXELS; i++) m_pixel[i].scale_and_clamp(scale.m_pixel[i]); }
+
+	static void bilinear_filter(u32 *dest, const u32 *rgb00, const u32 *rgb01, const u32 *rgb10, const u32 *rgb11, const u8 *u, const u8 *v)
+	{
+		for (int i = 0; i < PIXELS; i++)
+			dest[i] = rgbaint_t::bilinear_filter(rgb00[i], rgb01[i], rgb10[i], rgb11[i], u[i], v[i]);
+	}
+
+	void bilinear_filter_rgbaint(const u32 *rgb00, const u32 *rgb01, const u32 *rgb10, const u32 *rgb11, const u8 *u, const u8 *v)
+	{
+		for (int i = 0; i < PIXELS; i++)
+			m_pixel[i].bilinear_filter_rgbaint(rgb00[i], rgb01[i], rgb10[i], rgb11[i], u[i], v[i]);
+	}
+
+protected:
+	rgbaint_t m_pixel[PIXELS];
+};
+
+#endif // MAME_EMU_VIDEO_RGBBATCH_H
@@ -0,0 +1,107 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    rgbspan.cpp
+
+    Operations on spans of packed pixels, eight pixels at a time, using
+    the fastest implementation the host CPU supports.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "rgbspan.h"
+
+#include "rgbutil.h"
+
+// the AVX2 batch builds on the SSE rgbaint_t
+#if defined(MAME_EMU_VIDEO_RGBSSE_H) && (defined(__GNUC__) || defined(_MSC_VER))
+#define MAME_RGB_SPAN_AVX2
+#include <immintrin.h>
+#endif
+
+
+namespace {
+
+#include "rgbspan.ipp"
+
+} // anonymous namespace
+
+
+#if defined(MAME_RGB_SPAN_AVX2)
+
+// compile the AVX2 copy of the kernels for AVX2 whatever the build
+// targets; it's only called once host_has_avx2() says it can be.  This
+// covers the included headers as well, which ATTR_TARGET_AVX2 can't
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+#include "rgbavx.h"
+
+namespace avx2 {
+
+#include "rgbspan.ipp"
+
+const rgb_span_functions functions =
+{
+	&rgb_span_kernels<rgbaint_avx2_batch_t>::bilinear_filter,
+	&rgb_span_kernels<rgbaint_avx2_batch_t>::bilinear_blend,
+	&rgb_span_kernels<rgbaint_avx2_batch_t>::blend,
+	&rgb_span_kernels<rgbaint_avx2_batch_t>::blend_factors,
+	&rgb_span_kernels<rgbaint_avx2_batch_t>::scale_and_clamp
+};
+
+} // namespace avx2
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // MAME_RGB_SPAN_AVX2
+
+
+/***************************************************************************
+    GLOBAL VARIABLES
+***************************************************************************/
+
+const rgb_span_functions rgb_span_generic =
+{
+	&rgb_span_kernels<rgbaint_batch_t>::bilinear_filter,
+	&rgb_span_kernels<rgbaint_batch_t>::bilinear_blend,
+	&rgb_span_kernels<rgbaint_batch_t>::blend,
+	&rgb_span_kernels<rgbaint_batch_t>::blend_factors,
+	&rgb_span_kernels<rgbaint_batch_t>::scale_and_clamp
+};
+
+
+//-------------------------------------------------
+//  rgb_span_avx2 - return the AVX2 span
+//  functions if the host CPU can run them
+//-------------------------------------------------
+
+const rgb_span_functions *rgb_span_avx2()
+{
+#if defined(MAME_RGB_SPAN_AVX2)
+	if (host_has_avx2())
+		return &avx2::functions;
+#endif
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  rgb_span - return the fastest span functions
+//  for the host CPU, decided on first use
+//-------------------------------------------------
+
+const rgb_span_functions &rgb_span()
+{
+	static const rgb_span_functions &selected = rgb_span_avx2() ? *rgb_span_avx2() : rgb_span_generic;
+	return selected;
+}
@@ -0,0 +1,57 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    rgbspan.h
+
+    Operations on spans of packed pixels, eight pixels at a time, using
+    the fastest implementation the host CPU supports.
+
+***************************************************************************/
+
+#ifndef MAME_EMU_VIDEO_RGBSPAN_H
+#define MAME_EMU_VIDEO_RGBSPAN_H
+
+#pragma once
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+// ======================> rgb_span_functions
+
+// Each function processes count pixels, which needn't be a multiple of
+// eight.  Results are the same as applying the rgbaint_t operations one
+// pixel at a time, whichever implementation is used.
+struct rgb_span_functions
+{
+	// dest = bilinear filter of the four texels around each pixel
+	void (*bilinear_filter)(u32 *dest, const u32 *rgb00, const u32 *rgb01, const u32 *rgb10, const u32 *rgb11, const u8 *u, const u8 *v, int count);
+
+	// dest = the filtered texels blended over dest with a common factor
+	void (*bilinear_blend)(u32 *dest, const u32 *rgb00, const u32 *rgb01, const u32 *rgb10, const u32 *rgb11, const u8 *u, const u8 *v, u8 factor, int count);
+
+	// dest = src blended over dest with a common factor, or a factor per pixel
+	void (*blend)(u32 *dest, const u32 *src, u8 factor, int count);
+	void (*blend_factors)(u32 *dest, const u32 *src, const u8 *factors, int count);
+
+	// dest = src scaled by scale / 256 and clamped
+	void (*scale_and_clamp)(u32 *dest, const u32 *src, const u32 *scale, int count);
+};
+
+
+/***************************************************************************
+    FUNCTION PROTOTYPES
+***************************************************************************/
+
+// built from rgbaint_batch_t, so available everywhere
+extern const rgb_span_functions rgb_span_generic;
+
+// the AVX2 implementation, or nullptr if it isn't built or the CPU lacks AVX2
+const rgb_span_functions *rgb_span_avx2();
+
+// the fastest of the above, chosen the first time it's asked for
+const rgb_span_functions &rgb_span();
+
+#endif // MAME_EMU_VIDEO_RGBSPAN_H
@@ -0,0 +1,96 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    rgbspan.ipp
+
+    Span operations templated on the RGB batch type.  Included by
+    rgbspan.cpp once for each batch type, inside a namespace of its own,
+    so each copy is compiled for the instruction set its batch type needs.
+
+***************************************************************************/
+
+template <typename Batch>
+struct rgb_span_kernels
+{
+	static constexpr int PIXELS = Batch::PIXELS;
+
+	static void bilinear_filter(u32 *dest, const u32 *rgb00, const u32 *rgb01, const u32 *rgb10, const u32 *rgb11, const u8 *u, const u8 *v, int count)
+	{
+		int x = 0;
+		for ( ; x + PIXELS <= count; x += PIXELS)
+			Batch::bilinear_filter(&dest[x], &rgb00[x], &rgb01[x], &rgb10[x], &rgb11[x], &u[x], &v[x]);
+		for ( ; x < count; x++)
+			dest[x] = rgbaint_t::bilinear_filter(rgb00[x], rgb01[x], rgb10[x], rgb11[x], u[x], v[x]);
+	}
+
+	static void bilinear_blend(u32 *dest, const u32 *rgb00, const u32 *rgb01, const u32 *rgb10, const u32 *rgb11, const u8 *u, const u8 *v, u8 factor, int count)
+	{
+		int x = 0;
+		for ( ; x + PIXELS <= count; x += PIXELS)
+		{
+			Batch src;
+			src.bilinear_filter_rgbaint(&rgb00[x], &rgb01[x], &rgb10[x], &rgb11[x], &u[x], &v[x]);
+			src.blend(Batch(&dest[x]), factor);
+			src.store(&dest[x]);
+		}
+		for ( ; x < count; x++)
+		{
+			rgbaint_t src;
+			src.bilinear_filter_rgbaint(rgb00[x], rgb01[x], rgb10[x], rgb11[x], u[x], v[x]);
+			src.blend(rgbaint_t(dest[x]), factor);
+			dest[x] = src.to_rgba_clamp();
+		}
+	}
+
+	static void blend(u32 *dest, const u32 *src, u8 factor, int count)
+	{
+		int x = 0;
+		for ( ; x + PIXELS <= count; x += PIXELS)
+		{
+			Batch color(&src[x]);
+			color.blend(Batch(&dest[x]), factor);
+			color.store(&dest[x]);
+		}
+		for ( ; x < count; x++)
+		{
+			rgbaint_t color(src[x]);
+			color.blend(rgbaint_t(dest[x]), factor);
+			dest[x] = color.to_rgba_clamp();
+		}
+	}
+
+	static void blend_factors(u32 *dest, const u32 *src, const u8 *factors, int count)
+	{
+		int x = 0;
+		for ( ; x + PIXELS <= count; x += PIXELS)
+		{
+			Batch color(&src[x]);
+			color.blend(Batch(&dest[x]), &factors[x]);
+			color.store(&dest[x]);
+		}
+		for ( ; x < count; x++)
+		{
+			rgbaint_t color(src[x]);
+			color.blend(rgbaint_t(dest[x]), factors[x]);
+			dest[x] = color.to_rgba_clamp();
+		}
+	}
+
+	static void scale_and_clamp(u32 *dest, const u32 *src, const u32 *scale, int count)
+	{
+		int x = 0;
+		for ( ; x + PIXELS <= count; x += PIXELS)
+		{
+			Batch color(&src[x]);
+			color.scale_and_clamp(Batch(&scale[x]));
+			color.store(&dest[x]);
+		}
+		for ( ; x < count; x++)
+		{
+			rgbaint_t color(src[x]);
+			color.scale_and_clamp(rgbaint_t(scale[x]));
+			dest[x] = color.to_rgba_clamp();
+		}
+	}
+};
@@ -29,4 +29,6 @@
 
 #endif
 
+#include "rgbbatch.h"
+
 #endif // MAME_EMU_VIDEO_RGBUTIL_H
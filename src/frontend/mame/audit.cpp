@@ -20,9 +20,13 @@
 #include "softlist_dev.h"
 
 #include "chd.h"
+#include "corestr.h"
+#include "hashing.h"
 #include "path.h"
+#include "unzip.h"
 
 #include <algorithm>
+#include <cstdlib>
 
 //#define VERBOSE 1
 #define LOG_OUTPUT_FUNC osd_printf_verbose
@@ -170,6 +174,7 @@ public:
 media_auditor::media_auditor(const driver_enumerator &enumerator)
 	: m_enumerator(enumerator)
 	, m_validation(AUDIT_VALIDATE_FULL)
+	, m_cache(nullptr)
 {
 }
 
@@ -187,6 +192,11 @@ media_auditor::summary media_auditor::audit_media(const char *validation)
 	// store validation for later
 	m_validation = validation;
 
+	// if nothing this set depends on has changed, reuse the last result
+	summary cached_summary;
+	if (m_cache && m_cache->find_summary(m_enumerator.driver().name, validation, cached_summary))
+		return cached_summary;
+
 	// first walk the parent chain for required ROMs
 	parent_rom_vector parentroms;
 	for (auto drvindex = m_enumerator.find(m_enumerator.driver().parent); 0 <= drvindex; drvindex = m_enumerator.find(m_enumerator.driver(drvindex).parent))
@@ -214,6 +224,7 @@ media_auditor::summary media_auditor::audit_media(const char *validation)
 
 	// iterate over devices and regions
 	std::vector<std::string> searchpath;
+	std::vector<std::string> locations;
 	for (device_t &device : device_enumerator(m_enumerator.config()->root_device()))
 	{
 		searchpath.clear();
@@ -227,6 +238,7 @@ media_auditor::summary media_auditor::audit_media(const char *validation)
 				{
 					LOG("Audit media for device %s(%s)\n", device.shortname(), device.tag());
 					searchpath = device.searchpath();
+					locations.emplace_back(audit_cache::location_key(searchpath));
 				}
 
 				// look for a matching parent or device ROM
@@ -283,11 +295,16 @@ media_auditor::summary media_auditor::audit_media(const char *validation)
 	if ((found == shared_found) && required && ((required != shared_required) || !parent_found))
 	{
 		m_record_list.clear();
+		if (m_cache)
+			m_cache->add_summary(m_enumerator.driver().name, m_validation, NOTFOUND, locations);
 		return NOTFOUND;
 	}
 
 	// return a summary
-	return summarize(m_enumerator.driver().name);
+	summary const result(summarize(m_enumerator.driver().name));
+	if (m_cache)
+		m_cache->add_summary(m_enumerator.driver().name, m_validation, result, locations);
+	return result;
 }
 
 
@@ -685,6 +702,20 @@ media_auditor::audit_record &media_auditor::audit_one_rom(const std::vector<std:
 	// allocate and append a new record
 	audit_record &record = *m_record_list.emplace(m_record_list.end(), *rom, media_type::ROM);
 
+	// use the cached result if the archives haven't changed
+	std::string const location(m_cache ? audit_cache::location_key(searchpath) : std::string());
+	if (m_cache)
+	{
+		util::hash_collection hashes;
+		uint64_t length;
+		if (m_cache->find_file(location, record, m_validation, hashes, length))
+		{
+			record.set_actual(std::move(hashes), length);
+			compute_status(record, rom, record.actual_length() != 0);
+			return record;
+		}
+	}
+
 	// see if we have a CRC and extract it if so
 	uint32_t crc = 0;
 	bool const has_crc = record.expected_hashes().crc(crc);
@@ -703,6 +734,8 @@ media_auditor::audit_record &media_auditor::audit_one_rom(const std::vector<std:
 	// if it worked, get the actual length and hashes, then stop
 	if (!filerr)
 		record.set_actual(file.hashes(m_validation), file.size());
+	if (m_cache)
+		m_cache->add_file(location, record, m_validation);
 
 	// compute the final status
 	compute_status(record, rom, record.actual_length() != 0);
@@ -805,3 +838,463 @@ media_auditor::audit_record::audit_record(const char *name, media_type type)
 	, m_shared_device(nullptr)
 {
 }
+
+
+
+//**************************************************************************
+//  AUDIT CACHE
+//**************************************************************************
+
+//-------------------------------------------------
+//  audit_cache - constructor
+//-------------------------------------------------
+
+audit_cache::audit_cache(emu_options &options)
+	: m_cfg_directory(options.cfg_directory())
+	, m_media_path(options.media_path())
+	, m_dirty(false)
+{
+	load();
+}
+
+
+//-------------------------------------------------
+//  ~audit_cache - destructor
+//-------------------------------------------------
+
+audit_cache::~audit_cache()
+{
+	save();
+}
+
+
+//-------------------------------------------------
+//  invalidate - forget location fingerprints so
+//  files added, replaced or removed since the
+//  last audit pass are noticed
+//-------------------------------------------------
+
+void audit_cache::invalidate()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_fingerprints.clear();
+}
+
+
+//-------------------------------------------------
+//  find_summary - get the cached summary for a
+//  set if none of its locations have changed and
+//  it was checked at least as thoroughly
+//-------------------------------------------------
+
+bool audit_cache::find_summary(const char *name, const char *validation, media_auditor::summary &summary)
+{
+	set_result result;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto const found(m_sets.find(name));
+		if (m_sets.end() == found)
+			return false;
+		result = found->second;
+	}
+
+	// a summary from a CRC-only audit says nothing about SHA1 hashes
+	for (char const *ch = validation; *ch; ch++)
+	{
+		if (std::string::npos == result.validation.find(*ch))
+			return false;
+	}
+
+	for (auto const &loc : result.locations)
+	{
+		if (current_fingerprint(loc.first) != loc.second)
+			return false;
+	}
+	summary = result.summary;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  add_summary - remember the summary for a set
+//-------------------------------------------------
+
+void audit_cache::add_summary(const char *name, const char *validation, media_auditor::summary summary, const std::vector<std::string> &locations)
+{
+	// sets with problems need their records for reporting, so only the per-file results are kept
+	if ((media_auditor::CORRECT != summary) && (media_auditor::NONE_NEEDED != summary) && (media_auditor::NOTFOUND != summary))
+		return;
+
+	set_result result;
+	result.summary = summary;
+	result.validation = validation;
+	for (std::string const &key : locations)
+		result.locations.emplace_back(key, current_fingerprint(key));
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_sets[name] = std::move(result);
+	m_dirty = true;
+}
+
+
+//-------------------------------------------------
+//  find_file - get the cached hashes for a file
+//-------------------------------------------------
+
+bool audit_cache::find_file(const std::string &location, const media_auditor::audit_record &record, const char *validation, util::hash_collection &hashes, uint64_t &length)
+{
+	std::string const key(file_key(record, validation));
+	current_fingerprint(location);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto const &files(validated_location(location).files);
+	auto const found(files.find(key));
+	if (files.end() == found)
+		return false;
+
+	hashes.reset();
+	if (found->second.found)
+		hashes.from_internal_string(found->second.hashes);
+	length = found->second.length;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  add_file - remember the hashes for a file
+//-------------------------------------------------
+
+void audit_cache::add_file(const std::string &location, const media_auditor::audit_record &record, const char *validation)
+{
+	std::string const key(file_key(record, validation));
+	current_fingerprint(location);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	file_result &result(validated_location(location).files[key]);
+	result.found = record.actual_length() != 0;
+	result.length = record.actual_length();
+	result.hashes = record.actual_hashes().internal_string();
+	m_dirty = true;
+}
+
+
+//-------------------------------------------------
+//  location_key - make a key for a search path
+//-------------------------------------------------
+
+std::string audit_cache::location_key(const std::vector<std::string> &searchpath)
+{
+	std::string result;
+	for (std::string const &path : searchpath)
+	{
+		if (!result.empty())
+			result.append(1, ';');
+		result.append(path);
+	}
+	return result;
+}
+
+
+//-------------------------------------------------
+//  load - read the cache file
+//-------------------------------------------------
+
+void audit_cache::load()
+{
+	emu_file file(m_cfg_directory, OPEN_FLAG_READ);
+	if (file.open(FILENAME))
+		return;
+
+	// discard the cache if it was written by a different build
+	char buffer[16384];
+	if (!file.gets(buffer, std::size(buffer)) || (strtrimrightspace(buffer) != util::string_format("# %s", emulator_info::get_bare_build_version())))
+		return;
+
+	location *current(nullptr);
+	while (file.gets(buffer, std::size(buffer)))
+	{
+		// split the line into tab-separated fields
+		std::string const line(strtrimrightspace(buffer));
+		std::vector<std::string_view> fields;
+		for (std::string_view rest(line); !rest.empty(); )
+		{
+			auto const tab(rest.find('\t'));
+			fields.emplace_back(rest.substr(0, tab));
+			rest = (std::string_view::npos == tab) ? std::string_view() : rest.substr(tab + 1);
+		}
+		if (fields.empty())
+			continue;
+
+		if ((fields[0] == "L") && (3 == fields.size()))
+		{
+			// L <location> <fingerprint>
+			current = &m_locations[std::string(fields[1])];
+			current->fingerprint = fields[2];
+		}
+		else if ((fields[0] == "F") && (7 == fields.size()) && current)
+		{
+			// F <name> <expected> <validation> <found> <length> <actual>
+			std::string key(fields[1]);
+			key.append(1, '\t').append(fields[2]).append(1, '\t').append(fields[3]);
+			file_result &result(current->files[std::move(key)]);
+			result.found = fields[4] == "1";
+			result.length = std::strtoull(std::string(fields[5]).c_str(), nullptr, 10);
+			if (fields[6] != "-")
+				result.hashes = fields[6];
+		}
+		else if ((fields[0] == "S") && (4 <= fields.size()) && !(fields.size() & 1))
+		{
+			// S <name> <summary> <validation> [<location> <fingerprint>]...
+			set_result &result(m_sets[std::string(fields[1])]);
+			result.summary = media_auditor::summary(std::atoi(std::string(fields[2]).c_str()));
+			result.validation = fields[3];
+			for (std::size_t i = 4; fields.size() > i; i += 2)
+				result.locations.emplace_back(fields[i], fields[i + 1]);
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  save - write the cache file if it changed
+//-------------------------------------------------
+
+void audit_cache::save()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (!m_dirty)
+		return;
+
+	emu_file file(m_cfg_directory, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file.open(FILENAME))
+		return;
+
+	file.printf("# %s\n", emulator_info::get_bare_build_version());
+	for (auto const &loc : m_locations)
+	{
+		file.printf("L\t%s\t%s\n", loc.first, loc.second.fingerprint);
+		for (auto const &entry : loc.second.files)
+		{
+			// files that weren't found have no hashes, and an empty last field would be trimmed away on loading
+			file.printf("F\t%s\t%d\t%u\t%s\n", entry.first, entry.second.found ? 1 : 0, entry.second.length, entry.second.hashes.empty() ? "-" : entry.second.hashes.c_str());
+		}
+	}
+	for (auto const &set : m_sets)
+	{
+		file.printf("S\t%s\t%d\t%s", set.first, int(set.second.summary), set.second.validation);
+		for (auto const &loc : set.second.locations)
+			file.printf("\t%s\t%s", loc.first, loc.second);
+		file.puts("\n");
+	}
+	file.close();
+	m_dirty = false;
+}
+
+
+//-------------------------------------------------
+//  current_fingerprint - get the fingerprint of a
+//  location, computing it once per audit pass
+//-------------------------------------------------
+
+const std::string &audit_cache::current_fingerprint(const std::string &key)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto const found(m_fingerprints.find(key));
+		if (m_fingerprints.end() != found)
+			return found->second;
+	}
+
+	// do the directory sweep without holding the lock - another thread may beat us to it, but the result is the same
+	std::string fingerprint(compute_fingerprint(key));
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_fingerprints.emplace(key, std::move(fingerprint)).first->second;
+}
+
+
+//-------------------------------------------------
+//  compute_fingerprint - hash the size and
+//  modification time of everything the search
+//  path could find
+//-------------------------------------------------
+
+std::string audit_cache::compute_fingerprint(const std::string &key) const
+{
+	util::sha1_creator sha1;
+	auto const append =
+			[&sha1] (std::string const &path, uint64_t size, std::chrono::system_clock::time_point modified)
+			{
+				std::string const stamp(util::string_format("%s|%u|%d;", path, size, modified.time_since_epoch().count()));
+				sha1.append(stamp.c_str(), stamp.length());
+			};
+
+	path_iterator media(m_media_path);
+	std::string dir;
+	while (media.next(dir))
+	{
+		path_iterator search(key);
+		std::string name;
+		while (search.next(name))
+		{
+			std::string base(dir);
+			util::path_append(base, name);
+
+			// archives
+			for (char const *const ext : { ".zip", ".7z" })
+			{
+				std::string const path(base + ext);
+				auto const entry(osd_stat(path));
+				if (entry && (osd::directory::entry::entry_type::FILE == entry->type))
+					append(path, entry->size, entry->last_modified);
+			}
+
+			// loose files
+			osd::directory::ptr const directory(osd::directory::open(base));
+			if (directory)
+			{
+				for (osd::directory::entry const *entry = directory->read(); entry; entry = directory->read())
+				{
+					if (osd::directory::entry::entry_type::FILE == entry->type)
+						append(util::string_format("%s/%s", base, entry->name), entry->size, entry->last_modified);
+				}
+			}
+		}
+	}
+	return sha1.finish().as_string();
+}
+
+
+//-------------------------------------------------
+//  validated_location - get a location, clearing
+//  its files if it has changed (lock must be held)
+//-------------------------------------------------
+
+audit_cache::location &audit_cache::validated_location(const std::string &key)
+{
+	location &result(m_locations[key]);
+	std::string const &fingerprint(m_fingerprints[key]);
+	if (result.fingerprint != fingerprint)
+	{
+		result.fingerprint = fingerprint;
+		result.files.clear();
+		m_dirty = true;
+	}
+	return result;
+}
+
+
+//-------------------------------------------------
+//  file_key - make a key identifying a file and
+//  the hashes requested for it
+//-------------------------------------------------
+
+std::string audit_cache::file_key(const media_auditor::audit_record &record, const char *validation)
+{
+	return util::string_format("%s\t%s\t%s", record.name(), record.expected_hashes().internal_string(), validation);
+}
+
+
+
+//**************************************************************************
+//  PARALLEL AUDITING
+//**************************************************************************
+
+struct parallel_media_auditor::audit_job
+{
+	emu_options *                       options;
+	audit_cache *                       cache;
+	std::size_t                         drvindex;
+	const char *                        validation;
+	std::unique_ptr<driver_enumerator>  enumerator;
+	std::unique_ptr<media_auditor>      auditor;
+	media_auditor::summary              summary;
+};
+
+
+//-------------------------------------------------
+//  parallel_media_auditor - constructor
+//-------------------------------------------------
+
+parallel_media_auditor::parallel_media_auditor(emu_options &options, audit_cache *cache)
+	: m_options(options)
+	, m_cache(cache)
+	, m_queue(osd_work_queue_alloc(WORK_QUEUE_FLAG_IO | WORK_QUEUE_FLAG_MULTI))
+{
+}
+
+
+//-------------------------------------------------
+//  ~parallel_media_auditor - destructor
+//-------------------------------------------------
+
+parallel_media_auditor::~parallel_media_auditor()
+{
+	if (m_queue)
+		osd_work_queue_free(m_queue);
+
+	// release archives held open by the workers
+	util::archive_file::cache_clear();
+}
+
+
+//-------------------------------------------------
+//  audit_media - audit a list of systems,
+//  reporting results in list order
+//-------------------------------------------------
+
+bool parallel_media_auditor::audit_media(const std::vector<std::size_t> &drivers, report_func &&report, const char *validation)
+{
+	// pick up changes made since the last pass
+	if (m_cache)
+		m_cache->invalidate();
+
+	std::vector<audit_job> jobs;
+	jobs.reserve((std::min)(drivers.size(), BATCH_SIZE));
+	for (std::size_t start = 0; drivers.size() > start; start += BATCH_SIZE)
+	{
+		// set up a batch of jobs
+		std::size_t const count((std::min)(drivers.size() - start, BATCH_SIZE));
+		jobs.clear();
+		for (std::size_t i = 0; count > i; i++)
+			jobs.emplace_back(audit_job{ &m_options, m_cache, drivers[start + i], validation, nullptr, nullptr, media_auditor::NOTFOUND });
+
+		// audit them all, falling back to the calling thread if there's no queue
+		if (m_queue)
+		{
+			osd_work_item_queue_multiple(m_queue, &audit_callback, int32_t(count), &jobs[0], sizeof(audit_job), WORK_ITEM_FLAG_AUTO_RELEASE);
+			while (!osd_work_queue_wait(m_queue, osd_ticks_per_second()))
+			{
+			}
+		}
+		else
+		{
+			for (audit_job &job : jobs)
+				audit_callback(&job, 0);
+		}
+
+		// report in order so output is identical to a serial audit
+		for (audit_job &job : jobs)
+		{
+			if (!report(job.drvindex, *job.auditor, job.summary))
+				return false;
+		}
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  audit_callback - audit a single system on a
+//  worker thread
+//-------------------------------------------------
+
+void *parallel_media_auditor::audit_callback(void *param, int threadid)
+{
+	audit_job &job(*reinterpret_cast<audit_job *>(param));
+	job.enumerator = std::make_unique<driver_enumerator>(*job.options, driver_list::driver(job.drvindex));
+	job.enumerator->next();
+	job.auditor = std::make_unique<media_auditor>(*job.enumerator);
+	job.auditor->set_cache(job.cache);
+	job.summary = job.auditor->audit_media(job.validation);
+	return nullptr;
+}
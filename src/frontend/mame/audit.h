@@ -12,9 +12,15 @@
 
 #pragma once
 
+#include <functional>
 #include <iosfwd>
 #include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 
 
@@ -34,6 +40,7 @@
 
 
 // forward declarations
+class audit_cache;
 class driver_enumerator;
 class software_list_device;
 
@@ -153,6 +160,9 @@ public:
 	// getters
 	const record_list &records() const { return m_record_list; }
 
+	// setters
+	void set_cache(audit_cache *cache) { m_cache = cache; }
+
 	// audit operations
 	summary audit_media(const char *validation = AUDIT_VALIDATE_FULL);
 	summary audit_device(device_t &device, const char *validation = AUDIT_VALIDATE_FULL);
@@ -172,6 +182,107 @@ private:
 	record_list                 m_record_list;
 	const driver_enumerator &   m_enumerator;
 	const char *                m_validation;
+	audit_cache *               m_cache;
+};
+
+
+// ======================> audit_cache
+
+// persistent audit results, revalidated against archive sizes and modification times
+class audit_cache
+{
+public:
+	// construction/destruction
+	audit_cache(emu_options &options);
+	~audit_cache();
+
+	// start a new audit pass, so locations are checked for changes again
+	void invalidate();
+
+	// set-level results
+	bool find_summary(const char *name, const char *validation, media_auditor::summary &summary);
+	void add_summary(const char *name, const char *validation, media_auditor::summary summary, const std::vector<std::string> &locations);
+
+	// file-level results
+	bool find_file(const std::string &location, const media_auditor::audit_record &record, const char *validation, util::hash_collection &hashes, uint64_t &length);
+	void add_file(const std::string &location, const media_auditor::audit_record &record, const char *validation);
+
+	// loading/saving
+	void save();
+
+	// helpers
+	static std::string location_key(const std::vector<std::string> &searchpath);
+
+private:
+	struct file_result
+	{
+		bool                    found;
+		uint64_t                length;
+		std::string             hashes;
+	};
+
+	struct location
+	{
+		std::string             fingerprint;
+		std::unordered_map<std::string, file_result> files;
+	};
+
+	struct set_result
+	{
+		media_auditor::summary  summary;
+		std::string             validation;
+		std::vector<std::pair<std::string, std::string> > locations;
+	};
+
+	static constexpr char FILENAME[] = "audit.cache";
+
+	// internal helpers
+	void load();
+	const std::string &current_fingerprint(const std::string &key);
+	std::string compute_fingerprint(const std::string &key) const;
+	location &validated_location(const std::string &key);
+	static std::string file_key(const media_auditor::audit_record &record, const char *validation);
+
+	// internal state
+	std::string const           m_cfg_directory;
+	std::string const           m_media_path;
+	std::mutex                  m_mutex;
+	std::unordered_map<std::string, location> m_locations;
+	std::unordered_map<std::string, set_result> m_sets;
+	std::unordered_map<std::string, std::string> m_fingerprints;   // computed this audit pass
+	bool                        m_dirty;
+};
+
+
+// ======================> parallel_media_auditor
+
+// audits many systems concurrently on a work queue, reporting in order
+class parallel_media_auditor
+{
+public:
+	// called on the calling thread for each system in order; return false to cancel
+	using report_func = std::function<bool (std::size_t drvindex, const media_auditor &auditor, media_auditor::summary summary)>;
+
+	// construction/destruction
+	parallel_media_auditor(emu_options &options, audit_cache *cache = nullptr);
+	~parallel_media_auditor();
+
+	// audit operations
+	bool audit_media(const std::vector<std::size_t> &drivers, report_func &&report, const char *validation = AUDIT_VALIDATE_FULL);
+
+private:
+	struct audit_job;
+
+	// number of systems in flight at once; bounds memory used by machine configurations
+	static constexpr std::size_t BATCH_SIZE = 256;
+
+	// internal helpers
+	static void *audit_callback(void *param, int threadid);
+
+	// internal state
+	emu_options &               m_options;
+	audit_cache *               m_cache;
+	osd_work_queue *            m_queue;
 };
 
 
@@ -945,23 +945,51 @@ void cli_frontend::verifyroms(const std::vector<std::string> &args)
 	driver_enumerator drivlist(m_options);
 	media_auditor auditor(drivlist);
 	util::ovectorstream summary_string;
-	while (drivlist.next())
+	std::unique_ptr<audit_cache> cache(m_options.audit_cache() ? std::make_unique<audit_cache>(m_options) : nullptr);
+	auditor.set_cache(cache.get());
+	if (iswild)
 	{
-		if (included(drivlist.driver().name))
+		// audit matching sets concurrently - results are still reported in list order
+		std::vector<std::size_t> drivers;
+		while (drivlist.next())
+		{
+			if (included(drivlist.driver().name))
+				drivers.emplace_back(drivlist.current());
+		}
+
+		parallel_media_auditor(m_options, cache.get()).audit_media(
+				drivers,
+				[&correct, &incorrect, &notfound, &summary_string] (std::size_t drvindex, media_auditor const &result, media_auditor::summary summary)
+				{
+					auto const clone_of = driver_list::clone(drvindex);
+					print_summary(
+							result, summary, true,
+							"rom", driver_list::driver(drvindex).name, (clone_of >= 0) ? driver_list::driver(clone_of).name : nullptr,
+							correct, incorrect, notfound,
+							summary_string);
+					return true;
+				},
+				AUDIT_VALIDATE_FAST);
+	}
+	else
+	{
+		while (drivlist.next())
 		{
-			// audit the ROMs in this set
-			media_auditor::summary summary = auditor.audit_media(AUDIT_VALIDATE_FAST);
+			if (included(drivlist.driver().name))
+			{
+				// audit the ROMs in this set
+				media_auditor::summary summary = auditor.audit_media(AUDIT_VALIDATE_FAST);
 
-			auto const clone_of = drivlist.clone();
-			print_summary(
-					auditor, summary, true,
-					"rom", drivlist.driver().name, (clone_of >= 0) ? drivlist.driver(clone_of).name : nullptr,
-					correct, incorrect, notfound,
-					summary_string);
+				auto const clone_of = drivlist.clone();
+				print_summary(
+						auditor, summary, true,
+						"rom", drivlist.driver().name, (clone_of >= 0) ? drivlist.driver(clone_of).name : nullptr,
+						correct, incorrect, notfound,
+						summary_string);
 
-			// if it wasn't a wildcard, there can only be one
-			if (!iswild)
+				// if it wasn't a wildcard, there can only be one
 				break;
+			}
 		}
 	}
 
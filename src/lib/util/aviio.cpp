@@ -358,7 +358,7 @@ public:
 	std::uint64_t &saved_indx_offset() { return m_saved_indx_offset; }
 
 	// RGB helpers
-	avi_file::error rgb32_compress_to_rgb(const bitmap_rgb32 &bitmap, std::uint8_t *data, std::uint32_t numbytes) const;
+	avi_file::error rgb32_compress_to_rgb(const bitmap_rgb32 &bitmap, std::uint8_t *data, std::uint32_t numbytes, int firstrow = 0, int lastrow = -1) const;
 
 	// YUY helpers
 	avi_file::error yuv_decompress_to_yuy16(const std::uint8_t *data, std::uint32_t numbytes, bitmap_yuy16 &bitmap) const;
@@ -468,6 +468,7 @@ public:
 
 	virtual error append_video_frame(bitmap_yuy16 &bitmap) override;
 	virtual error append_video_frame(bitmap_rgb32 &bitmap) override;
+	virtual error append_video_frame(bitmap_rgb32 &bitmap, rectangle const &dirty) override;
 	virtual error append_sound_samples(int channel, std::int16_t const *samples, std::uint32_t numsamples, std::uint32_t sampleskip) override;
 
 	error read_movie_data();
@@ -492,6 +493,7 @@ private:
 		, m_soundbuf_samples(0)
 		, m_soundbuf_chunks(0)
 		, m_soundbuf_frames(0)
+		, m_tempbuffer_rgb(false)
 	{
 		std::fill(std::begin(m_soundbuf_chansamples), std::end(m_soundbuf_chansamples), 0);
 	}
@@ -566,6 +568,8 @@ private:
 	std::uint32_t       m_soundbuf_chansamples[MAX_SOUND_CHANNELS]; /* samples in buffer for each channel */
 	std::uint32_t       m_soundbuf_chunks;      /* number of chunks completed so far */
 	std::uint32_t       m_soundbuf_frames;      /* number of frames ahead of the video */
+
+	bool                m_tempbuffer_rgb;       /* temporary buffer holds the last RGB frame written */
 };
 
 
@@ -963,6 +967,9 @@ inline std::uint32_t avi_file_impl::framenum_to_samplenum(std::uint32_t framenum
 
 inline avi_file::error avi_file_impl::expand_tempbuffer(std::uint32_t length)
 {
+	/* whoever asked for the buffer is about to overwrite it */
+	m_tempbuffer_rgb = false;
+
 	/* expand the tempbuffer to hold the data if necessary */
 	if (length > m_tempbuffer.size())
 	{
@@ -979,7 +986,7 @@ inline avi_file::error avi_file_impl::expand_tempbuffer(std::uint32_t length)
 -------------------------------------------------*/
 
 /**
- * @fn  static avi_error rgb32_compress_to_rgb(avi_stream *stream, const bitmap_rgb32 &bitmap, std::uint8_t *data, std::uint32_t numbytes)
+ * @fn  static avi_error rgb32_compress_to_rgb(avi_stream *stream, const bitmap_rgb32 &bitmap, std::uint8_t *data, std::uint32_t numbytes, int firstrow, int lastrow)
  *
  * @brief   RGB 32 compress to RGB.
  *
@@ -987,19 +994,24 @@ inline avi_file::error avi_file_impl::expand_tempbuffer(std::uint32_t length)
  * @param   bitmap          The bitmap.
  * @param [in,out]  data    If non-null, the data.
  * @param   numbytes        The numbytes.
+ * @param   firstrow        The first bitmap row to convert.
+ * @param   lastrow         The last bitmap row to convert, or -1 for all rows; the
+ *                          blank space below the bitmap is only filled in when
+ *                          converting all rows.
  *
  * @return  An avi_error.
  */
 
-avi_file::error avi_stream::rgb32_compress_to_rgb(const bitmap_rgb32 &bitmap, std::uint8_t *data, std::uint32_t numbytes) const
+avi_file::error avi_stream::rgb32_compress_to_rgb(const bitmap_rgb32 &bitmap, std::uint8_t *data, std::uint32_t numbytes, int firstrow, int lastrow) const
 {
 	int const height = (std::min<int>)(m_height, bitmap.height());
 	int const width = (std::min<int>)(m_width, bitmap.width());
+	int const endrow = (lastrow < 0) ? height : (std::min<int>)(height, lastrow + 1);
 	std::uint8_t *const dataend = data + numbytes;
 	int x, y;
 
 	/* compressed video */
-	for (y = 0; y < height; y++)
+	for (y = (std::max<int>)(firstrow, 0); y < endrow; y++)
 	{
 		const std::uint32_t *source = &bitmap.pix(y);
 		std::uint8_t *dest = data + (m_height - 1 - y) * m_width * 3;
@@ -1022,7 +1034,7 @@ avi_file::error avi_stream::rgb32_compress_to_rgb(const bitmap_rgb32 &bitmap, st
 	}
 
 	/* fill in any blank space on the bottom */
-	for ( ; y < m_height; y++)
+	for (y = (lastrow < 0) ? height : m_height; y < m_height; y++)
 	{
 		std::uint8_t *dest = data + (m_height - 1 - y) * m_width * 3;
 		for (x = 0; x < m_width && dest < dataend; x++)
@@ -1978,10 +1990,31 @@ avi_file::error avi_file_impl::append_video_frame(bitmap_yuy16 &bitmap)
  */
 
 avi_file::error avi_file_impl::append_video_frame(bitmap_rgb32 &bitmap)
+{
+	m_tempbuffer_rgb = false;
+	return append_video_frame(bitmap, bitmap.cliprect());
+}
+
+
+/**
+ * @fn  avi_error avi_append_video_frame(avi_file *file, bitmap_rgb32 &bitmap, rectangle const &dirty)
+ *
+ * @brief   Avi append video frame, converting only the rows that changed.
+ *
+ * @param [in,out]  file    If non-null, the file.
+ * @param [in,out]  bitmap  The bitmap.
+ * @param   dirty           The area of the bitmap that differs from the
+ *                          previous RGB32 frame appended.
+ *
+ * @return  An avi_error.
+ */
+
+avi_file::error avi_file_impl::append_video_frame(bitmap_rgb32 &bitmap, rectangle const &dirty)
 {
 	avi_stream *const stream = get_video_stream();
 	error avierr;
 	std::uint32_t maxlength;
+	bool const partial = m_tempbuffer_rgb;
 
 	/* validate our ability to handle the data */
 	if (stream->format() != 0)
@@ -2002,8 +2035,11 @@ avi_file::error avi_file_impl::append_video_frame(bitmap_rgb32 &bitmap)
 	if (avierr != error::NONE)
 		return avierr;
 
-	/* copy the RGB data to the destination */
-	avierr = stream->rgb32_compress_to_rgb(bitmap, &m_tempbuffer[0], maxlength);
+	/* copy the RGB data to the destination; if it still holds the previous frame, only the dirty rows need converting */
+	if (!partial)
+		avierr = stream->rgb32_compress_to_rgb(bitmap, &m_tempbuffer[0], maxlength);
+	else if (!dirty.empty())
+		avierr = stream->rgb32_compress_to_rgb(bitmap, &m_tempbuffer[0], maxlength, dirty.top(), dirty.bottom());
 	if (avierr != error::NONE)
 		return avierr;
 
@@ -2011,6 +2047,7 @@ avi_file::error avi_file_impl::append_video_frame(bitmap_rgb32 &bitmap)
 	avierr = chunk_write(get_chunkid_for_stream(stream), &m_tempbuffer[0], maxlength);
 	if (avierr != error::NONE)
 		return avierr;
+	m_tempbuffer_rgb = true;
 
 	/* set the info for this new chunk */
 	avierr = stream->set_chunk_info(stream->chunks(), m_writeoffs - maxlength - 8, maxlength + 8);
@@ -194,6 +194,7 @@ inline void chd_file::file_read(uint64_t offset, void *dest, uint32_t length)
 		throw std::error_condition(error::NOT_OPEN);
 
 	// seek and read
+	std::lock_guard<std::mutex> lock(m_file_mutex);
 	m_file->seek(offset, SEEK_SET);
 	size_t count;
 	std::error_condition err = m_file->read(dest, length, count);
@@ -216,6 +217,7 @@ inline void chd_file::file_write(uint64_t offset, const void *source, uint32_t l
 		throw std::error_condition(error::NOT_OPEN);
 
 	// seek and write
+	std::lock_guard<std::mutex> lock(m_file_mutex);
 	m_file->seek(offset, SEEK_SET);
 	size_t count;
 	std::error_condition err = m_file->write(source, length, count);
@@ -241,6 +243,7 @@ inline uint64_t chd_file::file_append(const void *source, uint32_t length, uint3
 		throw std::error_condition(error::NOT_OPEN);
 
 	// seek to the end and align if necessary
+	std::lock_guard<std::mutex> lock(m_file_mutex);
 	err = m_file->seek(0, SEEK_END);
 	if (err)
 		throw err;
@@ -312,6 +315,9 @@ inline uint8_t chd_file::bits_for_value(uint64_t value)
  */
 
 chd_file::chd_file()
+	: m_cache_hunks(1)
+	, m_read_ahead_hunks(0)
+	, m_read_ahead_queue(nullptr)
 {
 	// reset state
 	close();
@@ -603,6 +609,47 @@ void chd_file::set_parent_sha1(util::sha1_t parent)
 	file_write(m_parentsha1_offset, rawbuf, sizeof(rawbuf));
 }
 
+/**
+ * @fn  void chd_file::set_cache_hunks(uint32_t hunks)
+ *
+ * @brief   -------------------------------------------------
+ *            set_cache_hunks - set the number of decompressed hunks kept in the LRU cache
+ *          -------------------------------------------------.
+ *
+ * @param   hunks   Number of hunks to cache; at least one hunk is always cached.
+ */
+
+void chd_file::set_cache_hunks(uint32_t hunks)
+{
+	m_cache_hunks = std::max<uint32_t>(hunks, 1);
+	if (m_file)
+	{
+		cache_release();
+		cache_configure();
+	}
+}
+
+/**
+ * @fn  void chd_file::set_read_ahead_hunks(uint32_t hunks)
+ *
+ * @brief   -------------------------------------------------
+ *            set_read_ahead_hunks - set the number of hunks to decompress in the background
+ *            ahead of sequential reads; zero disables read-ahead
+ *          -------------------------------------------------.
+ *
+ * @param   hunks   Number of hunks to read ahead.
+ */
+
+void chd_file::set_read_ahead_hunks(uint32_t hunks)
+{
+	m_read_ahead_hunks = hunks;
+	if (m_file)
+	{
+		cache_release();
+		cache_configure();
+	}
+}
+
 /**
  * @fn  std::error_condition chd_file::create(util::random_read_write::ptr &&file, uint64_t logicalbytes, uint32_t hunkbytes, uint32_t unitbytes, chd_codec_type compression[4])
  *
@@ -816,7 +863,6 @@ std::error_condition chd_file::open(util::random_read_write::ptr &&file, bool wr
 	// open the file
 	m_file = std::move(file);
 	m_parent = parent;
-	m_cachehunk = ~0;
 	return open_common(writeable);
 }
 
@@ -830,6 +876,9 @@ std::error_condition chd_file::open(util::random_read_write::ptr &&file, bool wr
 
 void chd_file::close()
 {
+	// stop any background work before the file goes away
+	cache_release();
+
 	// reset file characteristics
 	m_file.reset();
 	m_allow_reads = false;
@@ -862,11 +911,12 @@ void chd_file::close()
 	// reset compression management
 	for (auto & elem : m_decompressor)
 		elem.reset();
+	memset(m_decompressor_configured, 0, sizeof(m_decompressor_configured));
 	m_compressed.clear();
 
 	// reset caching
-	m_cache.clear();
-	m_cachehunk = ~0;
+	m_last_hunk = ~0;
+	m_sequential = 0;
 }
 
 /**
@@ -1085,15 +1135,15 @@ std::error_condition chd_file::write_hunk(uint32_t hunknum, const void *buffer)
 			be_write(rawmap, rawentry, 4);
 			file_write(m_mapoffset + hunknum * 4, rawmap, 4);
 
-			// update the cached hunk if we just wrote it
-			if (hunknum == m_cachehunk && buffer != &m_cache[0])
-				memcpy(&m_cache[0], buffer, m_hunkbytes);
 		}
 		else
 		{
 			// otherwise, just overwrite
 			file_write(uint64_t(rawentry) * uint64_t(m_hunkbytes), buffer, m_hunkbytes);
 		}
+
+		// update the cached hunk if we just wrote it
+		cache_update(hunknum, buffer);
 		return std::error_condition();
 	}
 	catch (std::error_condition const &err)
@@ -1158,40 +1208,54 @@ std::error_condition chd_file::write_units(uint64_t unitnum, const void *buffer,
 
 std::error_condition chd_file::read_bytes(uint64_t offset, void *buffer, uint32_t bytes)
 {
-	// iterate over hunks
-	uint32_t first_hunk = offset / m_hunkbytes;
-	uint32_t last_hunk = (offset + bytes - 1) / m_hunkbytes;
-	auto *dest = reinterpret_cast<uint8_t *>(buffer);
-	for (uint32_t curhunk = first_hunk; curhunk <= last_hunk; curhunk++)
+	// wrap this for clean reporting
+	try
 	{
-		// determine start/end boundaries
-		uint32_t startoffs = (curhunk == first_hunk) ? (offset % m_hunkbytes) : 0;
-		uint32_t endoffs = (curhunk == last_hunk) ? ((offset + bytes - 1) % m_hunkbytes) : (m_hunkbytes - 1);
-
-		// if it's a full block, just read directly from disk unless it's the cached hunk
-		std::error_condition err;
-		if (startoffs == 0 && endoffs == m_hunkbytes - 1 && curhunk != m_cachehunk)
-			err = read_hunk(curhunk, dest);
+		// punt if no file
+		if (!m_file)
+			throw std::error_condition(error::NOT_OPEN);
 
-		// otherwise, read from the cache
-		else
+		// iterate over hunks
+		uint32_t first_hunk = offset / m_hunkbytes;
+		uint32_t last_hunk = (offset + bytes - 1) / m_hunkbytes;
+		auto *dest = reinterpret_cast<uint8_t *>(buffer);
+		for (uint32_t curhunk = first_hunk; curhunk <= last_hunk; curhunk++)
 		{
-			if (curhunk != m_cachehunk)
+			// determine start/end boundaries
+			uint32_t startoffs = (curhunk == first_hunk) ? (offset % m_hunkbytes) : 0;
+			uint32_t endoffs = (curhunk == last_hunk) ? ((offset + bytes - 1) % m_hunkbytes) : (m_hunkbytes - 1);
+
+			// kick off decompression of upcoming hunks if this looks like a stream
+			read_ahead(curhunk);
+
+			// if it's a full block, just read directly from disk unless it's a cached hunk
+			if (startoffs == 0 && endoffs == m_hunkbytes - 1)
 			{
-				err = read_hunk(curhunk, &m_cache[0]);
-				if (err)
-					return err;
-				m_cachehunk = curhunk;
+				const uint8_t *cached = cache_find(curhunk);
+				if (cached)
+					memcpy(dest, cached, m_hunkbytes);
+				else
+				{
+					std::error_condition err = read_hunk(curhunk, dest);
+					if (err)
+						throw err;
+				}
 			}
-			memcpy(dest, &m_cache[startoffs], endoffs + 1 - startoffs);
-		}
 
-		// handle errors and advance
-		if (err)
-			return err;
-		dest += endoffs + 1 - startoffs;
+			// otherwise, read from the cache
+			else
+				memcpy(dest, cache_load(curhunk) + startoffs, endoffs + 1 - startoffs);
+
+			// advance
+			dest += endoffs + 1 - startoffs;
+		}
+		return std::error_condition();
+	}
+	catch (std::error_condition const &err)
+	{
+		// just return errors
+		return err;
 	}
-	return std::error_condition();
 }
 
 /**
@@ -1211,41 +1275,48 @@ std::error_condition chd_file::read_bytes(uint64_t offset, void *buffer, uint32_
 
 std::error_condition chd_file::write_bytes(uint64_t offset, const void *buffer, uint32_t bytes)
 {
-	// iterate over hunks
-	uint32_t first_hunk = offset / m_hunkbytes;
-	uint32_t last_hunk = (offset + bytes - 1) / m_hunkbytes;
-	const auto *source = reinterpret_cast<const uint8_t *>(buffer);
-	for (uint32_t curhunk = first_hunk; curhunk <= last_hunk; curhunk++)
+	// wrap this for clean reporting
+	try
 	{
-		// determine start/end boundaries
-		uint32_t startoffs = (curhunk == first_hunk) ? (offset % m_hunkbytes) : 0;
-		uint32_t endoffs = (curhunk == last_hunk) ? ((offset + bytes - 1) % m_hunkbytes) : (m_hunkbytes - 1);
-
-		// if it's a full block, just write directly to disk unless it's the cached hunk
-		std::error_condition err;
-		if (startoffs == 0 && endoffs == m_hunkbytes - 1 && curhunk != m_cachehunk)
-			err = write_hunk(curhunk, source);
+		// punt if no file
+		if (!m_file)
+			throw std::error_condition(error::NOT_OPEN);
 
-		// otherwise, write from the cache
-		else
+		// iterate over hunks
+		uint32_t first_hunk = offset / m_hunkbytes;
+		uint32_t last_hunk = (offset + bytes - 1) / m_hunkbytes;
+		const auto *source = reinterpret_cast<const uint8_t *>(buffer);
+		for (uint32_t curhunk = first_hunk; curhunk <= last_hunk; curhunk++)
 		{
-			if (curhunk != m_cachehunk)
+			// determine start/end boundaries
+			uint32_t startoffs = (curhunk == first_hunk) ? (offset % m_hunkbytes) : 0;
+			uint32_t endoffs = (curhunk == last_hunk) ? ((offset + bytes - 1) % m_hunkbytes) : (m_hunkbytes - 1);
+
+			// if it's a full block, just write directly to disk; write_hunk keeps any cached copy current
+			std::error_condition err;
+			if (startoffs == 0 && endoffs == m_hunkbytes - 1)
+				err = write_hunk(curhunk, source);
+
+			// otherwise, merge into the cached hunk and write that
+			else
 			{
-				err = read_hunk(curhunk, &m_cache[0]);
-				if (err)
-					return err;
-				m_cachehunk = curhunk;
+				uint8_t *cached = cache_load(curhunk);
+				memcpy(cached + startoffs, source, endoffs + 1 - startoffs);
+				err = write_hunk(curhunk, cached);
 			}
-			memcpy(&m_cache[startoffs], source, endoffs + 1 - startoffs);
-			err = write_hunk(curhunk, &m_cache[0]);
-		}
 
-		// handle errors and advance
-		if (err)
-			return err;
-		source += endoffs + 1 - startoffs;
+			// handle errors and advance
+			if (err)
+				throw err;
+			source += endoffs + 1 - startoffs;
+		}
+		return std::error_condition();
+	}
+	catch (std::error_condition const &err)
+	{
+		// just return errors
+		return err;
 	}
-	return std::error_condition();
 }
 
 /**
@@ -1644,6 +1715,14 @@ std::error_condition chd_file::codec_configure(chd_codec_type codec, int param,
 			if (m_compression[codecnum] == codec)
 			{
 				m_decompressor[codecnum]->configure(param, config);
+
+				// read-ahead workers can no longer produce the same output for this codec
+				m_decompressor_configured[codecnum] = true;
+				if (!m_read_ahead_items.empty() && m_read_ahead_items[0]->m_decompressor[codecnum])
+				{
+					cache_release();
+					cache_configure();
+				}
 				return std::error_condition();
 			}
 		return std::errc::invalid_argument;
@@ -2483,9 +2562,350 @@ void chd_file::create_open_common()
 	else
 		file_read(m_mapoffset, &m_rawmap[0], m_rawmap.size());
 
-	// allocate the temporary compressed buffer and a buffer for caching
+	// allocate the temporary compressed buffer and set up caching
 	m_compressed.resize(m_hunkbytes);
-	m_cache.resize(m_hunkbytes);
+	cache_configure();
+}
+
+/**
+ * @fn  void chd_file::cache_configure()
+ *
+ * @brief   -------------------------------------------------
+ *            cache_configure - allocate the hunk cache and, for read-only compressed files,
+ *            the read-ahead workers
+ *          -------------------------------------------------.
+ */
+
+void chd_file::cache_configure()
+{
+	// read-ahead is only used on read-only v5 compressed files, where the map can't change underneath the workers
+	uint32_t read_ahead_hunks = m_read_ahead_hunks;
+	if (m_version < 5 || !compressed() || m_allow_writes)
+		read_ahead_hunks = 0;
+
+	// the cache must hold every in-flight hunk plus the current one
+	m_cache = std::make_unique<hunk_cache>(std::max<uint32_t>(m_cache_hunks, read_ahead_hunks ? (read_ahead_hunks + 2) : 1));
+	m_last_hunk = ~0;
+	m_sequential = 0;
+	if (read_ahead_hunks == 0)
+		return;
+
+	// allocate the queue and a pool of items, each with its own decompressors; codecs the caller
+	// has configured (e.g. A/V decoding straight into bitmaps) can't be mirrored, so are skipped
+	m_read_ahead_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	if (!m_read_ahead_queue)
+		return;
+	m_read_ahead_items.resize(read_ahead_hunks);
+	for (auto &item : m_read_ahead_items)
+	{
+		item = std::make_unique<read_ahead_item>();
+		item->m_chd = this;
+		item->m_compressed.resize(m_hunkbytes);
+		for (int decompnum = 0; decompnum < std::size(m_compression); decompnum++)
+			if (m_decompressor[decompnum] && !m_decompressor[decompnum]->lossy() && !m_decompressor_configured[decompnum])
+				item->m_decompressor[decompnum] = chd_codec_list::new_decompressor(m_compression[decompnum], *this);
+	}
+}
+
+/**
+ * @fn  void chd_file::cache_release()
+ *
+ * @brief   -------------------------------------------------
+ *            cache_release - wait for outstanding read-ahead work and free the cache
+ *          -------------------------------------------------.
+ */
+
+void chd_file::cache_release()
+{
+	// let in-flight work finish before its buffers go away
+	if (m_cache)
+	{
+		for (auto &entry : *m_cache)
+			read_ahead_wait(entry.second);
+		m_cache.reset();
+	}
+	m_read_ahead_items.clear();
+	if (m_read_ahead_queue)
+	{
+		osd_work_queue_free(m_read_ahead_queue);
+		m_read_ahead_queue = nullptr;
+	}
+}
+
+/**
+ * @fn  chd_file::cache_entry &chd_file::cache_allocate(uint32_t hunknum)
+ *
+ * @brief   -------------------------------------------------
+ *            cache_allocate - add an entry for the given hunk to the cache, recycling the
+ *            buffer of the least recently used entry if the cache is full
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum The hunknum.
+ *
+ * @return  The new entry; its contents are undefined.
+ */
+
+chd_file::cache_entry &chd_file::cache_allocate(uint32_t hunknum)
+{
+	std::vector<uint8_t> data;
+	if (m_cache->size() >= m_cache->max_size())
+	{
+		auto const oldest = m_cache->begin();
+		read_ahead_wait(oldest->second);
+		data = std::move(oldest->second.m_data);
+		m_cache->erase(oldest);
+	}
+	data.resize(m_hunkbytes);
+
+	cache_entry &entry = (*m_cache)[hunknum];
+	entry.m_data = std::move(data);
+	entry.m_pending = nullptr;
+	return entry;
+}
+
+/**
+ * @fn  uint8_t *chd_file::cache_find(uint32_t hunknum)
+ *
+ * @brief   -------------------------------------------------
+ *            cache_find - return the cached data for a hunk, waiting for read-ahead to
+ *            complete if necessary
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum The hunknum.
+ *
+ * @return  Pointer to the hunk data, or nullptr if it isn't cached.
+ */
+
+uint8_t *chd_file::cache_find(uint32_t hunknum)
+{
+	auto const found = m_cache->find(hunknum);
+	if (found == m_cache->end())
+		return nullptr;
+
+	// if the background decode failed, drop it and let the caller read it directly to report the error
+	if (read_ahead_wait(found->second))
+	{
+		m_cache->erase(found);
+		return nullptr;
+	}
+	return &found->second.m_data[0];
+}
+
+/**
+ * @fn  uint8_t *chd_file::cache_load(uint32_t hunknum)
+ *
+ * @brief   -------------------------------------------------
+ *            cache_load - return the cached data for a hunk, reading it into the cache if
+ *            necessary; on failure throw an error
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum The hunknum.
+ *
+ * @return  Pointer to the hunk data.
+ */
+
+uint8_t *chd_file::cache_load(uint32_t hunknum)
+{
+	uint8_t *data = cache_find(hunknum);
+	if (!data)
+	{
+		cache_entry &entry = cache_allocate(hunknum);
+		std::error_condition err = read_hunk(hunknum, &entry.m_data[0]);
+		if (err)
+		{
+			m_cache->erase(hunknum);
+			throw err;
+		}
+		data = &entry.m_data[0];
+	}
+	return data;
+}
+
+/**
+ * @fn  void chd_file::cache_update(uint32_t hunknum, const void *buffer)
+ *
+ * @brief   -------------------------------------------------
+ *            cache_update - refresh the cached copy of a hunk that has just been written
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum The hunknum.
+ * @param   buffer  The data written.
+ */
+
+void chd_file::cache_update(uint32_t hunknum, const void *buffer)
+{
+	uint8_t *data = cache_find(hunknum);
+	if (data && data != buffer)
+		memcpy(data, buffer, m_hunkbytes);
+}
+
+/**
+ * @fn  std::error_condition chd_file::read_ahead_wait(cache_entry &entry)
+ *
+ * @brief   -------------------------------------------------
+ *            read_ahead_wait - wait for any read-ahead work filling a cache entry and return
+ *            the item to the pool
+ *          -------------------------------------------------.
+ *
+ * @param [in,out]  entry   The cache entry.
+ *
+ * @return  The result of the background decode, or no error if nothing was pending.
+ */
+
+std::error_condition chd_file::read_ahead_wait(cache_entry &entry)
+{
+	read_ahead_item *const item = entry.m_pending;
+	if (!item)
+		return std::error_condition();
+
+	while (!osd_work_item_wait(item->m_osd, osd_ticks_per_second()))
+		;
+	osd_work_item_release(item->m_osd);
+	item->m_osd = nullptr;
+	entry.m_pending = nullptr;
+	return item->m_error;
+}
+
+/**
+ * @fn  bool chd_file::read_ahead_possible(uint32_t hunknum) const
+ *
+ * @brief   -------------------------------------------------
+ *            read_ahead_possible - determine whether a hunk can be decoded by a read-ahead
+ *            worker; only self-contained hunks with lossless codecs qualify
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum The hunknum.
+ *
+ * @return  true if the hunk can be read ahead.
+ */
+
+bool chd_file::read_ahead_possible(uint32_t hunknum) const
+{
+	uint8_t const type = m_rawmap[m_mapentrybytes * hunknum];
+	switch (type)
+	{
+		case COMPRESSION_TYPE_0:
+		case COMPRESSION_TYPE_1:
+		case COMPRESSION_TYPE_2:
+		case COMPRESSION_TYPE_3:
+			return bool(m_read_ahead_items[0]->m_decompressor[type]);
+
+		case COMPRESSION_NONE:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+/**
+ * @fn  void chd_file::read_ahead(uint32_t hunknum)
+ *
+ * @brief   -------------------------------------------------
+ *            read_ahead - note an access to a hunk and, if accesses look sequential, queue
+ *            background decompression of the hunks that follow it
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum The hunk being accessed.
+ */
+
+void chd_file::read_ahead(uint32_t hunknum)
+{
+	// ignore repeated accesses within the same hunk
+	if (hunknum == m_last_hunk)
+		return;
+	m_sequential = (hunknum == m_last_hunk + 1) ? (m_sequential + 1) : 0;
+	m_last_hunk = hunknum;
+	if (!m_read_ahead_queue || m_sequential == 0)
+		return;
+
+	// queue up anything in the window that isn't already cached or in flight
+	auto nextitem = m_read_ahead_items.begin();
+	for (uint32_t ahead = 1; ahead <= m_read_ahead_items.size() && (hunknum + ahead) < m_hunkcount; ahead++)
+	{
+		uint32_t const target = hunknum + ahead;
+		if (m_cache->find(target) != m_cache->end() || !read_ahead_possible(target))
+			continue;
+
+		// find an idle item; if they're all busy, the rest of the window will have to wait
+		while (nextitem != m_read_ahead_items.end() && (*nextitem)->m_osd)
+			++nextitem;
+		if (nextitem == m_read_ahead_items.end())
+			break;
+		read_ahead_item &item = **nextitem;
+
+		// freshen the current hunk so it isn't the one we recycle, then start the work
+		m_cache->find(hunknum);
+		cache_entry &entry = cache_allocate(target);
+		item.m_hunknum = target;
+		item.m_data = &entry.m_data[0];
+		item.m_osd = osd_work_item_queue(m_read_ahead_queue, async_read_ahead_static, &item, 0);
+		if (item.m_osd)
+			entry.m_pending = &item;
+		else
+		{
+			m_cache->erase(target);
+			break;
+		}
+	}
+}
+
+/**
+ * @fn  void *chd_file::async_read_ahead_static(void *param, int threadid)
+ *
+ * @brief   -------------------------------------------------
+ *            async_read_ahead - decompress a hunk on a worker thread
+ *          -------------------------------------------------.
+ *
+ * @param [in,out]  param   If non-null, the parameter.
+ * @param   threadid        The threadid.
+ *
+ * @return  null if it fails, else a void*.
+ */
+
+void *chd_file::async_read_ahead_static(void *param, int threadid)
+{
+	auto *item = reinterpret_cast<read_ahead_item *>(param);
+	item->m_chd->async_read_ahead(*item);
+	return nullptr;
+}
+
+/**
+ * @fn  void chd_file::async_read_ahead(read_ahead_item &item)
+ *
+ * @brief   -------------------------------------------------
+ *            async_read_ahead - decompress a hunk on a worker thread
+ *          -------------------------------------------------.
+ *
+ * @param [in,out]  item    The item.
+ */
+
+void chd_file::async_read_ahead(read_ahead_item &item)
+{
+	try
+	{
+		// the map is read-only while workers exist, so it's safe to look at here
+		uint8_t const *const rawmap = &m_rawmap[m_mapentrybytes * item.m_hunknum];
+		uint32_t const blocklen = be_read(&rawmap[1], 3);
+		uint64_t const blockoffs = be_read(&rawmap[4], 6);
+		util::crc16_t const blockcrc = be_read(&rawmap[10], 2);
+		if (rawmap[0] == COMPRESSION_NONE)
+		{
+			file_read(blockoffs, item.m_data, m_hunkbytes);
+		}
+		else
+		{
+			file_read(blockoffs, &item.m_compressed[0], blocklen);
+			item.m_decompressor[rawmap[0]]->decompress(&item.m_compressed[0], blocklen, item.m_data, m_hunkbytes);
+		}
+		if (util::crc16_creator::simple(item.m_data, m_hunkbytes) != blockcrc)
+			throw std::error_condition(error::DECOMPRESSION_ERROR);
+		item.m_error.clear();
+	}
+	catch (std::error_condition const &err)
+	{
+		item.m_error = err;
+	}
 }
 
 /**
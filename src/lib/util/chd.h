@@ -15,10 +15,13 @@
 #include "chdcodec.h"
 #include "hashing.h"
 #include "ioprocs.h"
+#include "lrucache.h"
 
 #include "osdcore.h"
 
 #include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <system_error>
@@ -314,6 +317,12 @@ public:
 	void set_raw_sha1(util::sha1_t rawdata);
 	void set_parent_sha1(util::sha1_t parent);
 
+	// cache configuration
+	uint32_t cache_hunks() const { return m_cache_hunks; }
+	uint32_t read_ahead_hunks() const { return m_read_ahead_hunks; }
+	void set_cache_hunks(uint32_t hunks);
+	void set_read_ahead_hunks(uint32_t hunks);
+
 	// file create
 	std::error_condition create(std::string_view filename, uint64_t logicalbytes, uint32_t hunkbytes, uint32_t unitbytes, chd_codec_type compression[4]);
 	std::error_condition create(util::random_read_write::ptr &&file, uint64_t logicalbytes, uint32_t hunkbytes, uint32_t unitbytes, chd_codec_type compression[4]);
@@ -355,6 +364,26 @@ public:
 private:
 	struct metadata_entry;
 	struct metadata_hash;
+	struct read_ahead_item;
+
+	// a decompressed hunk held in the cache
+	struct cache_entry
+	{
+		std::vector<uint8_t>    m_data;             // decompressed hunk data
+		read_ahead_item *       m_pending = nullptr;// read-ahead item still filling m_data, if any
+	};
+
+	// state for decompressing one hunk in the background
+	struct read_ahead_item
+	{
+		chd_file *              m_chd = nullptr;    // pointer back to the owning CHD
+		osd_work_item *         m_osd = nullptr;    // OSD work item running on this hunk
+		uint32_t                m_hunknum = 0;      // hunk being decompressed
+		uint8_t *               m_data = nullptr;   // destination cache buffer
+		std::error_condition    m_error;            // result of the operation
+		chd_decompressor::ptr   m_decompressor[4];  // private decompressors for this item
+		std::vector<uint8_t>    m_compressed;       // private buffer for compressed data
+	};
 
 	// inline helpers
 	uint64_t be_read(const uint8_t *base, int numbytes);
@@ -384,9 +413,21 @@ private:
 	void metadata_set_previous_next(uint64_t prevoffset, uint64_t nextoffset);
 	void metadata_update_hash();
 	static int CLIB_DECL metadata_hash_compare(const void *elem1, const void *elem2);
+	void cache_configure();
+	void cache_release();
+	cache_entry &cache_allocate(uint32_t hunknum);
+	uint8_t *cache_find(uint32_t hunknum);
+	uint8_t *cache_load(uint32_t hunknum);
+	void cache_update(uint32_t hunknum, const void *buffer);
+	std::error_condition read_ahead_wait(cache_entry &entry);
+	bool read_ahead_possible(uint32_t hunknum) const;
+	void read_ahead(uint32_t hunknum);
+	static void *async_read_ahead_static(void *param, int threadid);
+	void async_read_ahead(read_ahead_item &item);
 
 	// file characteristics
 	util::random_read_write::ptr m_file;        // handle to the open core file
+	std::mutex              m_file_mutex;       // serializes file access with read-ahead workers
 	bool                    m_allow_reads;      // permit reads from this CHD?
 	bool                    m_allow_writes;     // permit writes to this CHD?
 
@@ -416,11 +457,20 @@ private:
 
 	// compression management
 	chd_decompressor::ptr   m_decompressor[4];  // array of decompression codecs
+	bool                    m_decompressor_configured[4]; // has the caller configured each codec?
 	std::vector<uint8_t>    m_compressed;       // temporary buffer for compressed data
 
 	// caching
-	std::vector<uint8_t>    m_cache;            // single-hunk cache for partial reads/writes
-	uint32_t                m_cachehunk;        // which hunk is in the cache?
+	typedef util::lru_cache_map<uint32_t, cache_entry> hunk_cache;
+	std::unique_ptr<hunk_cache> m_cache;        // LRU cache of decompressed hunks
+	uint32_t                m_cache_hunks;      // requested number of hunks to cache
+	uint32_t                m_last_hunk;        // last hunk accessed via read_bytes
+	uint32_t                m_sequential;       // number of consecutive sequential hunk accesses
+
+	// read-ahead
+	uint32_t                m_read_ahead_hunks; // number of hunks to decompress ahead of sequential reads
+	osd_work_queue *        m_read_ahead_queue; // queue for read-ahead work, or nullptr if inactive
+	std::vector<std::unique_ptr<read_ahead_item> > m_read_ahead_items; // pool of read-ahead items
 };
 
 
@@ -20,6 +20,7 @@
 #include "lzma/C/LzmaEnc.h"
 
 #include <zlib.h>
+#include <zstd.h>
 
 #include <new>
 
@@ -165,6 +166,44 @@ private:
 };
 
 
+// ======================> chd_zstd_compressor
+
+// Zstandard compressor
+class chd_zstd_compressor : public chd_compressor
+{
+public:
+	// construction/destruction
+	chd_zstd_compressor(chd_file &chd, uint32_t hunkbytes, bool lossy);
+	~chd_zstd_compressor();
+
+	// core functionality
+	virtual uint32_t compress(const uint8_t *src, uint32_t srclen, uint8_t *dest) override;
+
+private:
+	// internal state
+	ZSTD_CCtx *             m_context;
+};
+
+
+// ======================> chd_zstd_decompressor
+
+// Zstandard decompressor
+class chd_zstd_decompressor : public chd_decompressor
+{
+public:
+	// construction/destruction
+	chd_zstd_decompressor(chd_file &chd, uint32_t hunkbytes, bool lossy);
+	~chd_zstd_decompressor();
+
+	// core functionality
+	virtual void decompress(const uint8_t *src, uint32_t complen, uint8_t *dest, uint32_t destlen) override;
+
+private:
+	// internal state
+	ZSTD_DCtx *             m_context;
+};
+
+
 // ======================> chd_huffman_compressor
 
 // Huffman compressor
@@ -497,11 +536,13 @@ const codec_entry f_codec_list[] =
 	{ CHD_CODEC_LZMA,       false,  "LZMA",                 &codec_entry::construct_compressor<chd_lzma_compressor>,     &codec_entry::construct_decompressor<chd_lzma_decompressor> },
 	{ CHD_CODEC_HUFFMAN,    false,  "Huffman",              &codec_entry::construct_compressor<chd_huffman_compressor>,  &codec_entry::construct_decompressor<chd_huffman_decompressor> },
 	{ CHD_CODEC_FLAC,       false,  "FLAC",                 &codec_entry::construct_compressor<chd_flac_compressor>,     &codec_entry::construct_decompressor<chd_flac_decompressor> },
+	{ CHD_CODEC_ZSTD,       false,  "Zstandard",            &codec_entry::construct_compressor<chd_zstd_compressor>,     &codec_entry::construct_decompressor<chd_zstd_decompressor> },
 
 	// general codecs with CD frontend
 	{ CHD_CODEC_CD_ZLIB,    false,  "CD Deflate",           &codec_entry::construct_compressor<chd_cd_compressor<chd_zlib_compressor, chd_zlib_compressor> >,        &codec_entry::construct_decompressor<chd_cd_decompressor<chd_zlib_decompressor, chd_zlib_decompressor> > },
 	{ CHD_CODEC_CD_LZMA,    false,  "CD LZMA",              &codec_entry::construct_compressor<chd_cd_compressor<chd_lzma_compressor, chd_zlib_compressor> >,        &codec_entry::construct_decompressor<chd_cd_decompressor<chd_lzma_decompressor, chd_zlib_decompressor> > },
 	{ CHD_CODEC_CD_FLAC,    false,  "CD FLAC",              &codec_entry::construct_compressor<chd_cd_flac_compressor>,                                              &codec_entry::construct_decompressor<chd_cd_flac_decompressor> },
+	{ CHD_CODEC_CD_ZSTD,    false,  "CD Zstandard",         &codec_entry::construct_compressor<chd_cd_compressor<chd_zstd_compressor, chd_zlib_compressor> >,        &codec_entry::construct_decompressor<chd_cd_decompressor<chd_zstd_decompressor, chd_zlib_decompressor> > },
 
 	// A/V codecs
 	{ CHD_CODEC_AVHUFF,     false,  "A/V Huffman",          &codec_entry::construct_compressor<chd_avhuff_compressor>,   &codec_entry::construct_decompressor<chd_avhuff_decompressor> },
@@ -1235,6 +1276,96 @@ void chd_lzma_decompressor::decompress(const uint8_t *src, uint32_t complen, uin
 
 
 
+//**************************************************************************
+//  ZSTANDARD COMPRESSOR
+//**************************************************************************
+
+//-------------------------------------------------
+//  chd_zstd_compressor - constructor
+//-------------------------------------------------
+
+chd_zstd_compressor::chd_zstd_compressor(chd_file &chd, uint32_t hunkbytes, bool lossy)
+	: chd_compressor(chd, hunkbytes, lossy)
+	, m_context(ZSTD_createCCtx())
+{
+	if (!m_context)
+		throw std::bad_alloc();
+}
+
+
+//-------------------------------------------------
+//  ~chd_zstd_compressor - destructor
+//-------------------------------------------------
+
+chd_zstd_compressor::~chd_zstd_compressor()
+{
+	ZSTD_freeCCtx(m_context);
+}
+
+
+//-------------------------------------------------
+//  compress - compress data using the Zstandard
+//  codec
+//-------------------------------------------------
+
+uint32_t chd_zstd_compressor::compress(const uint8_t *src, uint32_t srclen, uint8_t *dest)
+{
+	// compression happens once, so spend the time to get the best ratio; decompression speed
+	// is largely independent of the level
+	size_t const complen = ZSTD_compressCCtx(m_context, dest, srclen, src, srclen, ZSTD_maxCLevel());
+
+	// if we ended up with more data than we started with, return an error
+	if (ZSTD_isError(complen) || complen >= srclen)
+		throw std::error_condition(chd_file::error::COMPRESSION_ERROR);
+
+	// otherwise, return the length
+	return uint32_t(complen);
+}
+
+
+
+//**************************************************************************
+//  ZSTANDARD DECOMPRESSOR
+//**************************************************************************
+
+//-------------------------------------------------
+//  chd_zstd_decompressor - constructor
+//-------------------------------------------------
+
+chd_zstd_decompressor::chd_zstd_decompressor(chd_file &chd, uint32_t hunkbytes, bool lossy)
+	: chd_decompressor(chd, hunkbytes, lossy)
+	, m_context(ZSTD_createDCtx())
+{
+	if (!m_context)
+		throw std::bad_alloc();
+}
+
+
+//-------------------------------------------------
+//  ~chd_zstd_decompressor - destructor
+//-------------------------------------------------
+
+chd_zstd_decompressor::~chd_zstd_decompressor()
+{
+	ZSTD_freeDCtx(m_context);
+}
+
+
+//-------------------------------------------------
+//  decompress - decompress data using the
+//  Zstandard codec
+//-------------------------------------------------
+
+void chd_zstd_decompressor::decompress(const uint8_t *src, uint32_t complen, uint8_t *dest, uint32_t destlen)
+{
+	// the context is reused between hunks, so there's no per-hunk setup cost
+	size_t const result = ZSTD_decompressDCtx(m_context, dest, destlen, src, complen);
+	if (ZSTD_isError(result) || result != destlen)
+		throw std::error_condition(chd_file::error::DECOMPRESSION_ERROR);
+}
+
+
+
 //**************************************************************************
 //  HUFFMAN COMPRESSOR
 //**************************************************************************
@@ -23,6 +23,7 @@
 #include <string_view>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 // ======================> simple_list
 
@@ -526,6 +527,107 @@ private:
 };
 
 
+// a binary min-heap of pointers to objects that record their own position
+// in it, so any object can be removed without searching; Before is a
+// stateless predicate that returns true if its first argument should come
+// out of the heap first
+template <typename T, u32 T::*Index, typename Before>
+class intrusive_heap
+{
+public:
+	// the index of an object that isn't in the heap
+	static constexpr u32 NOT_QUEUED = ~u32(0);
+
+	typedef typename std::vector<T *>::const_iterator const_iterator;
+
+	// getters
+	bool empty() const noexcept { return m_heap.empty(); }
+	std::size_t size() const noexcept { return m_heap.size(); }
+	T *front() const noexcept { return m_heap.front(); }
+	T *back() const noexcept { return m_heap.back(); }
+
+	// iteration is in heap order, not sorted order
+	const_iterator begin() const noexcept { return m_heap.begin(); }
+	const_iterator end() const noexcept { return m_heap.end(); }
+
+	// add an object, which must not already be in the heap
+	void insert(T &item)
+	{
+		item.*Index = m_heap.size();
+		m_heap.push_back(&item);
+		up(item.*Index);
+	}
+
+	// remove an object, which must be in the heap
+	void remove(T &item) noexcept
+	{
+		// move the last entry into its slot and restore the order around it
+		u32 const index = item.*Index;
+		T *const last = m_heap.back();
+		m_heap.pop_back();
+		item.*Index = NOT_QUEUED;
+		if (last != &item)
+		{
+			m_heap[index] = last;
+			last->*Index = index;
+			up(index);
+			down(last->*Index);
+		}
+	}
+
+private:
+	// move an entry towards the root until its parent comes out first
+	void up(u32 index) noexcept
+	{
+		T *const item = m_heap[index];
+		while (index > 0)
+		{
+			u32 const parentindex = (index - 1) / 2;
+			T *const parent = m_heap[parentindex];
+			if (Before()(*parent, *item))
+				break;
+			m_heap[index] = parent;
+			parent->*Index = index;
+			index = parentindex;
+		}
+		m_heap[index] = item;
+		item->*Index = index;
+	}
+
+	// move an entry towards the leaves until it comes out before its children
+	void down(u32 index) noexcept
+	{
+		T *const item = m_heap[index];
+		u32 const count = m_heap.size();
+		while (true)
+		{
+			u32 childindex = index * 2 + 1;
+			if (childindex >= count)
+				break;
+			T *child = m_heap[childindex];
+			if (childindex + 1 < count)
+			{
+				T *const right = m_heap[childindex + 1];
+				if (Before()(*right, *child))
+				{
+					child = right;
+					childindex++;
+				}
+			}
+			if (Before()(*item, *child))
+				break;
+			m_heap[index] = child;
+			child->*Index = index;
+			index = childindex;
+		}
+		m_heap[index] = item;
+		item->*Index = index;
+	}
+
+	std::vector<T *> m_heap;
+};
+
+
 // extract a string_view from an ovectorstream buffer
 template <typename CharT, typename Traits, typename Allocator>
 std::basic_string_view<CharT, Traits> buf_to_string_view(basic_ovectorstream<CharT, Traits, Allocator> &stream)
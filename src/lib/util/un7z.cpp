@@ -165,27 +165,27 @@ public:
 
 	int first_file() noexcept
 	{
-		return search(0, 0, std::string_view(), false, false, false);
+		return search(0, 0, std::string_view(), false, false, false, false);
 	}
 
 	int next_file() noexcept
 	{
-		return (m_curr_file_idx < 0) ? -1 : search(m_curr_file_idx + 1, 0, std::string_view(), false, false, false);
+		return (m_curr_file_idx < 0) ? -1 : search(m_curr_file_idx + 1, 0, std::string_view(), false, false, false, false);
 	}
 
 	int search(std::uint32_t crc) noexcept
 	{
-		return search(0, crc, std::string_view(), true, false, false);
+		return search_crc_index(crc, std::string_view(), false, false);
 	}
 
 	int search(std::string_view filename, bool partialpath) noexcept
 	{
-		return search(0, 0, filename, false, true, partialpath);
+		return search(0, 0, filename, false, true, partialpath, false);
 	}
 
 	int search(std::uint32_t crc, std::string_view filename, bool partialpath) noexcept
 	{
-		return search(0, crc, filename, true, true, partialpath);
+		return search_crc_index(crc, filename, true, partialpath);
 	}
 
 	bool current_is_directory() const noexcept { return m_curr_is_dir; }
@@ -208,7 +208,10 @@ private:
 			std::string_view search_filename,
 			bool matchcrc,
 			bool matchname,
-			bool partialpath) noexcept;
+			bool partialpath,
+			bool single) noexcept;
+	int search_crc_index(std::uint32_t search_crc, std::string_view search_filename, bool matchname, bool partialpath) noexcept;
+	void build_crc_index() noexcept;
 	void make_utf8_name(int index);
 	void set_curr_modified() noexcept;
 
@@ -229,6 +232,9 @@ private:
 	std::vector<char32_t>                   m_uchar_buf;
 	std::vector<char>                       m_utf8_buf;
 
+	std::vector<std::pair<std::uint32_t, int> > m_crc_index;       // (CRC, file index) pairs sorted by CRC
+	bool                                    m_crc_indexed;          // CRC index has been built
+
 	CFileInStream                           m_archive_stream;
 	CLookToRead                             m_look_stream;
 	CSzArEx                                 m_db;
@@ -303,6 +309,8 @@ m7z_file_impl::m7z_file_impl(std::string &&filename) noexcept
 	, m_utf16_buf()
 	, m_uchar_buf()
 	, m_utf8_buf()
+	, m_crc_index()
+	, m_crc_indexed(false)
 	, m_inited(false)
 	, m_block_index(0)
 	, m_out_buffer(nullptr)
@@ -486,7 +494,8 @@ int m7z_file_impl::search(
 		std::string_view search_filename,
 		bool matchcrc,
 		bool matchname,
-		bool partialpath) noexcept
+		bool partialpath,
+		bool single) noexcept
 {
 	try
 	{
@@ -528,6 +537,10 @@ int m7z_file_impl::search(
 
 				return i;
 			}
+
+			// only examining the entry at the starting index
+			if (single)
+				break;
 		}
 	}
 	catch (...)
@@ -538,6 +551,54 @@ int m7z_file_impl::search(
 }
 
 
+int m7z_file_impl::search_crc_index(
+		std::uint32_t search_crc,
+		std::string_view search_filename,
+		bool matchname,
+		bool partialpath) noexcept
+{
+	// avoids converting every file name to UTF-8 when looking up by CRC
+	build_crc_index();
+	if (!m_crc_indexed)
+		return search(0, search_crc, search_filename, true, matchname, partialpath, false);
+
+	// candidates are in archive order, so the first match is the same as a linear scan
+	auto candidate = std::lower_bound(m_crc_index.begin(), m_crc_index.end(), std::make_pair(search_crc, 0));
+	for ( ; (m_crc_index.end() != candidate) && (candidate->first == search_crc); ++candidate)
+	{
+		int const result = search(candidate->second, search_crc, search_filename, true, matchname, partialpath, true);
+		if (0 <= result)
+			return result;
+	}
+	return -1;
+}
+
+
+void m7z_file_impl::build_crc_index() noexcept
+{
+	if (m_crc_indexed)
+		return;
+
+	try
+	{
+		std::vector<std::pair<std::uint32_t, int> > index;
+		index.reserve(m_db.NumFiles);
+		for (UInt32 i = 0; i < m_db.NumFiles; i++)
+		{
+			if (SzBitArray_Check(m_db.CRCs.Defs, i))
+				index.emplace_back(m_db.CRCs.Vals[i], int(i));
+		}
+		std::sort(index.begin(), index.end());
+		m_crc_index = std::move(index);
+		m_crc_indexed = true;
+	}
+	catch (...)
+	{
+		// fall back to linear search if memory is tight
+	}
+}
+
+
 void m7z_file_impl::make_utf8_name(int index)
 {
 	std::size_t len, out_pos;
@@ -177,30 +177,28 @@ public:
 	int first_file() noexcept
 	{
 		m_cd_pos = 0;
-		return search(0, std::string_view(), false, false, false);
+		return search(0, std::string_view(), false, false, false, false);
 	}
 
 	int next_file() noexcept
 	{
-		return search(0, std::string_view(), false, false, false);
+		return search(0, std::string_view(), false, false, false, false);
 	}
 
 	int search(std::uint32_t crc) noexcept
 	{
-		m_cd_pos = 0;
-		return search(crc, std::string_view(), true, false, false);
+		return search_crc_index(crc, std::string_view(), false, false);
 	}
 
 	int search(std::string_view filename, bool partialpath) noexcept
 	{
 		m_cd_pos = 0;
-		return search(0, filename, false, true, partialpath);
+		return search(0, filename, false, true, partialpath, false);
 	}
 
 	int search(std::uint32_t crc, std::string_view filename, bool partialpath) noexcept
 	{
-		m_cd_pos = 0;
-		return search(crc, filename, true, true, partialpath);
+		return search_crc_index(crc, filename, true, partialpath);
 	}
 
 	bool current_is_directory() const noexcept { return m_curr_is_dir; }
@@ -226,7 +224,9 @@ private:
 	zip_file_impl &operator=(const zip_file_impl &) = delete;
 	zip_file_impl &operator=(zip_file_impl &&) = delete;
 
-	int search(std::uint32_t search_crc, std::string_view search_filename, bool matchcrc, bool matchname, bool partialpath) noexcept;
+	int search(std::uint32_t search_crc, std::string_view search_filename, bool matchcrc, bool matchname, bool partialpath, bool single) noexcept;
+	int search_crc_index(std::uint32_t search_crc, std::string_view search_filename, bool matchname, bool partialpath) noexcept;
+	void build_crc_index() noexcept;
 
 	std::error_condition reopen() noexcept
 	{
@@ -343,6 +343,9 @@ private:
 	file_header                 m_header;                   // current file header
 	bool                        m_curr_is_dir = false;      // current file is directory
 
+	std::vector<std::pair<std::uint32_t, std::uint32_t> > m_crc_index; // (CRC, central directory offset) pairs sorted by CRC
+	bool                        m_crc_indexed = false;      // CRC index has been built
+
 	std::array<std::uint8_t, DECOMPRESS_BUFSIZE> m_buffer;  // buffer for decompression
 };
 
@@ -771,7 +774,7 @@ void zip_file_impl::close(ptr &&zip) noexcept
     entry in the ZIP
 -------------------------------------------------*/
 
-int zip_file_impl::search(std::uint32_t search_crc, std::string_view search_filename, bool matchcrc, bool matchname, bool partialpath) noexcept
+int zip_file_impl::search(std::uint32_t search_crc, std::string_view search_filename, bool matchcrc, bool matchname, bool partialpath, bool single) noexcept
 {
 	// if we're at or past the end, we're done
 	while ((m_cd_pos + central_dir_entry_reader::minimum_length()) <= m_ecd.cd_size)
@@ -898,11 +901,79 @@ int zip_file_impl::search(std::uint32_t search_crc, std::string_view search_file
 			if ((!matchcrc || (search_crc == m_header.crc)) && (namematch || partialmatch))
 				return 0;
 		}
+
+		// only examining the entry at the current position
+		if (single)
+			break;
 	}
 	return -1;
 }
 
 
+/*-------------------------------------------------
+    zip_file_search_crc_index - find the first
+    entry matching a CRC using the CRC index
+-------------------------------------------------*/
+
+int zip_file_impl::search_crc_index(std::uint32_t search_crc, std::string_view search_filename, bool matchname, bool partialpath) noexcept
+{
+	// the index stays valid for as long as the archive is cached, so clones share it with their parents
+	build_crc_index();
+	if (!m_crc_indexed)
+	{
+		m_cd_pos = 0;
+		return search(search_crc, search_filename, true, matchname, partialpath, false);
+	}
+
+	// candidates are in central directory order, so the first match is the same as a linear scan
+	auto candidate = std::lower_bound(m_crc_index.begin(), m_crc_index.end(), std::make_pair(search_crc, std::uint32_t(0)));
+	for ( ; (m_crc_index.end() != candidate) && (candidate->first == search_crc); ++candidate)
+	{
+		m_cd_pos = candidate->second;
+		if (!search(search_crc, search_filename, true, matchname, partialpath, true))
+			return 0;
+	}
+
+	// leave the position at the end so a subsequent next_file() finds nothing
+	m_cd_pos = std::uint32_t(m_ecd.cd_size);
+	return -1;
+}
+
+
+/*-------------------------------------------------
+    zip_file_build_crc_index - build a sorted
+    index of CRCs in the central directory
+-------------------------------------------------*/
+
+void zip_file_impl::build_crc_index() noexcept
+{
+	if (m_crc_indexed)
+		return;
+
+	try
+	{
+		std::vector<std::pair<std::uint32_t, std::uint32_t> > index;
+		index.reserve(std::size_t(m_ecd.cd_total_entries));
+		std::uint64_t pos(0);
+		while ((pos + central_dir_entry_reader::minimum_length()) <= m_ecd.cd_size)
+		{
+			central_dir_entry_reader const reader(&m_cd[0] + pos);
+			if (!reader.signature_correct() || ((pos + reader.total_length()) > m_ecd.cd_size))
+				break;
+			index.emplace_back(reader.crc32(), std::uint32_t(pos));
+			pos += reader.total_length();
+		}
+		std::sort(index.begin(), index.end());
+		m_crc_index = std::move(index);
+		m_crc_indexed = true;
+	}
+	catch (...)
+	{
+		// fall back to linear search if memory is tight
+	}
+}
+
+
 /*-------------------------------------------------
     zip_file_decompress - decompress a file
     from a ZIP into the target buffer
@@ -136,6 +136,9 @@ void _1942_state::video_start()
 
 	m_fg_tilemap->set_transparent_pen(0);
 
+	// sprites are 16 pixels wide and only drawn with transpen, so they can use the row kernels
+	m_gfxdecode->gfx(2)->set_predecoded(true);
+
 	m_bg_tilemap->set_scrolldx(128, 128);
 	m_bg_tilemap->set_scrolldy(  6,   6);
 	m_fg_tilemap->set_scrolldx(128, 128);
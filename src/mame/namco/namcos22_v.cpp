@@ -15,6 +15,9 @@ namcos22_renderer::namcos22_renderer(namcos22_state &state)
 	: poly_manager<float, namcos22_object_data, 4>(state.machine()),
 		m_state(state)
 	{
+		// bin work into 64x16 tiles of the 640x480 screen
+		set_tile_binning(64, 16, 640, 480);
+
 		init();
 	}
 
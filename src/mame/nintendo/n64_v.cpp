@@ -3178,6 +3178,10 @@ n64_rdp::n64_rdp(n64_state &state, uint32_t* rdram, uint32_t* dmem) : poly_manag
 
 	m_pending_mode_block = false;
 
+	// spans come from the command list through render_extents, so bin them
+	// into 16-line rows only, covering the largest frame buffer
+	set_tile_binning(0, 16, 640, 480);
+
 	m_start = 0;
 	m_end = 0;
 	m_current = 0;
@@ -645,6 +645,9 @@ public:
 		, m_state(state)
 		, m_destmap(512, 512)
 	{
+		// bin work into 64x16 tiles of the destination bitmap
+		set_tile_binning(64, 16, m_destmap.width(), m_destmap.height());
+
 		m_renderfuncs[0] = &model2_renderer::model2_3d_render_0;
 		m_renderfuncs[1] = &model2_renderer::model2_3d_render_1;
 		m_renderfuncs[2] = &model2_renderer::model2_3d_render_2;
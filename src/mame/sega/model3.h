@@ -86,6 +86,9 @@ public:
 	{
 		m_fb = std::make_unique<bitmap_rgb32>(width, height);
 		m_zb = std::make_unique<bitmap_ind32>(width, height);
+
+		// bin work into 64x16 tiles of the frame buffer
+		set_tile_binning(64, 16, width, height);
 	}
 
 	void draw(bitmap_rgb32 &bitmap, const rectangle &cliprect);
@@ -13,6 +13,9 @@ hng64_poly_renderer::hng64_poly_renderer(hng64_state& state)
 {
 	const int32_t bufferSize = state.m_screen->visible_area().width() * state.m_screen->visible_area().height();
 	m_depthBuffer3d = std::make_unique<float[]>(bufferSize);
+
+	// bin work into 64x16 tiles of the 3D buffers
+	set_tile_binning(64, 16, state.m_screen->visible_area().width(), state.m_screen->visible_area().height());
 }
 
 
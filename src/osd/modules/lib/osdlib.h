@@ -161,6 +161,66 @@ private:
 };
 
 
+/*-----------------------------------------------------------------------------
+    file_mapping: map an entire file into memory copy-on-write
+
+    Notes:
+
+        - Pages are shared with the OS file cache (and hence with other
+          processes mapping the same file) until they're written to
+        - Writes are private to the mapping and never reach the file
+        - The mapping remains valid after the file itself is closed
+-----------------------------------------------------------------------------*/
+
+class file_mapping
+{
+public:
+	file_mapping(file_mapping const &) = delete;
+	file_mapping &operator=(file_mapping const &) = delete;
+
+	file_mapping() { }
+	explicit file_mapping(std::string const &path)
+	{
+		m_memory = do_map(path, m_size);
+	}
+	file_mapping(file_mapping &&that) : m_memory(that.m_memory), m_size(that.m_size)
+	{
+		that.m_memory = nullptr;
+		that.m_size = 0U;
+	}
+	~file_mapping()
+	{
+		if (m_memory)
+			do_unmap(m_memory, m_size);
+	}
+
+	explicit operator bool() const { return bool(m_memory); }
+	void *get() { return m_memory; }
+	std::size_t size() const { return m_size; }
+
+	file_mapping &operator=(file_mapping &&that)
+	{
+		if (&that != this)
+		{
+			if (m_memory)
+				do_unmap(m_memory, m_size);
+			m_memory = that.m_memory;
+			m_size = that.m_size;
+			that.m_memory = nullptr;
+			that.m_size = 0U;
+		}
+		return *this;
+	}
+
+private:
+	static void *do_map(std::string const &path, std::size_t &size);
+	static void do_unmap(void *start, std::size_t size);
+
+	void *m_memory = nullptr;
+	std::size_t m_size = 0U;
+};
+
+
 /*-----------------------------------------------------------------------------
     dynamic_module: load functions from optional shared libraries
 
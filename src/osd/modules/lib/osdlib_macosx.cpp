@@ -13,13 +13,17 @@
 #include "osdlib.h"
 
 #include <csignal>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <iomanip>
+#include <limits>
 #include <memory>
 
 #include <dlfcn.h>
+#include <fcntl.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/sysctl.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -328,6 +332,32 @@ bool virtual_memory_allocation::do_set_access(void *start, std::size_t size, uns
 }
 
 
+void *file_mapping::do_map(std::string const &path, std::size_t &size)
+{
+	int const fd(::open(path.c_str(), O_RDONLY));
+	if (0 > fd)
+		return nullptr;
+	void *result(nullptr);
+	struct stat st;
+	if (!fstat(fd, &st) && (0 < st.st_size) && (std::uintmax_t(st.st_size) <= std::numeric_limits<std::size_t>::max()))
+	{
+		// private writable mapping: pages stay shared until something writes to them
+		result = mmap(nullptr, std::size_t(st.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+		if (result == (void *)-1)
+			result = nullptr;
+		else
+			size = std::size_t(st.st_size);
+	}
+	::close(fd);
+	return result;
+}
+
+void file_mapping::do_unmap(void *start, std::size_t size)
+{
+	munmap(start, size);
+}
+
+
 dynamic_module::ptr dynamic_module::open(std::vector<std::string> &&names)
 {
 	return std::make_unique<dynamic_module_posix_impl>(std::move(names));
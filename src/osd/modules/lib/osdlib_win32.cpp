@@ -18,8 +18,10 @@
 #include "winutil.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
+#include <limits>
 
 #include <windows.h>
 #include <memoryapi.h>
@@ -365,6 +367,36 @@ bool virtual_memory_allocation::do_set_access(void *start, std::size_t size, uns
 }
 
 
+void *file_mapping::do_map(std::string const &path, std::size_t &size)
+{
+	osd::text::tstring const tpath(osd::text::to_tstring(path));
+	HANDLE const file(CreateFile(tpath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr));
+	if (INVALID_HANDLE_VALUE == file)
+		return nullptr;
+	void *result(nullptr);
+	LARGE_INTEGER length;
+	if (GetFileSizeEx(file, &length) && (0 < length.QuadPart) && (std::uint64_t(length.QuadPart) <= std::numeric_limits<SIZE_T>::max()))
+	{
+		// copy-on-write view: pages stay shared until something writes to them
+		HANDLE const mapping(CreateFileMapping(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr));
+		if (mapping)
+		{
+			result = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, SIZE_T(length.QuadPart));
+			if (result)
+				size = SIZE_T(length.QuadPart);
+			CloseHandle(mapping); // the view keeps the mapping object alive
+		}
+	}
+	CloseHandle(file);
+	return result;
+}
+
+void file_mapping::do_unmap(void *start, std::size_t size)
+{
+	UnmapViewOfFile(start);
+}
+
+
 dynamic_module::ptr dynamic_module::open(std::vector<std::string> &&names)
 {
 	return std::make_unique<dynamic_module_win32_impl>(std::move(names));
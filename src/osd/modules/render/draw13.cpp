@@ -689,6 +689,7 @@ texture_info::texture_info(renderer_sdl2 *renderer, const render_texinfo &texsou
 	m_flags = flags;
 	m_texinfo = texsource;
 	m_texinfo.seqid = -1; // force set data
+	m_texinfo.content_id = 0;
 	m_is_rotated = false;
 	m_setup = setup;
 	m_sdl_blendmode = map_blendmode(PRIMFLAG_GET_BLENDMODE(flags));
@@ -949,11 +950,20 @@ texture_info * renderer_sdl2::texture_update(const render_primitive &prim)
 
 	if (texture != nullptr)
 	{
-		if (prim.texture.base != nullptr && texture->texinfo().seqid != prim.texture.seqid)
+		render_texinfo &texinfo = texture->texinfo();
+		if (prim.texture.base != nullptr && texinfo.seqid != prim.texture.seqid)
 		{
-			texture->texinfo().seqid = prim.texture.seqid;
-			// if we found it, but with a different seqid, copy the data
-			texture->set_data(prim.texture, prim.flags);
+			texinfo.seqid = prim.texture.seqid;
+
+			// if we found it, but with a different seqid, copy the data unless it's tracked and unchanged
+			if (!texinfo.same_contents(prim.texture))
+			{
+				texinfo.content_id = prim.texture.content_id;
+				texinfo.content_seq = prim.texture.content_seq;
+				texinfo.palette = prim.texture.palette;
+				texinfo.palette_seq = prim.texture.palette_seq;
+				texture->set_data(prim.texture, prim.flags);
+			}
 		}
 
 	}
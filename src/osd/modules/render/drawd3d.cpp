@@ -603,11 +603,19 @@ void d3d_texture_manager::update_textures()
 			}
 			else
 			{
-				// if there is one, but with a different seqid, copy the data
-				if (texture->get_texinfo().seqid != prim.texture.seqid)
+				// if there is one, but with a different seqid, copy the data unless it's tracked and unchanged
+				render_texinfo &texinfo = texture->get_texinfo();
+				if (texinfo.seqid != prim.texture.seqid)
 				{
-					texture->set_data(&prim.texture, prim.flags);
-					texture->get_texinfo().seqid = prim.texture.seqid;
+					if (!texinfo.same_contents(prim.texture))
+					{
+						texture->set_data(&prim.texture, prim.flags);
+						texinfo.content_id = prim.texture.content_id;
+						texinfo.content_seq = prim.texture.content_seq;
+						texinfo.palette = prim.texture.palette;
+						texinfo.palette_seq = prim.texture.palette_seq;
+					}
+					texinfo.seqid = prim.texture.seqid;
 				}
 			}
 		}
@@ -7,6 +7,7 @@
 //============================================================
 
 #include "emu.h"
+#include "emuopts.h"
 #include "drawgdi.h"
 #include "rendersw.hxx"
 
@@ -16,6 +17,8 @@
 
 renderer_gdi::~renderer_gdi()
 {
+	if (m_work_queue)
+		osd_work_queue_free(m_work_queue);
 }
 
 //============================================================
@@ -34,6 +37,11 @@ int renderer_gdi::create()
 	m_bminfo.bmiHeader.biYPelsPerMeter   = 0;
 	m_bminfo.bmiHeader.biClrUsed         = 0;
 	m_bminfo.bmiHeader.biClrImportant    = 0;
+
+	// split rendering into bands if requested
+	m_render_bands = assert_window()->machine().options().render_threads();
+	if (m_render_bands > 1)
+		m_work_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
 	return 0;
 }
 
@@ -82,12 +90,21 @@ int renderer_gdi::draw(const int update)
 		m_bmsize = pitch * height * 4 * 2;
 		m_bmdata.reset();
 		m_bmdata = std::make_unique<uint8_t []>(m_bmsize);
+		m_last_sequence = 0;
 	}
 
-	// draw the primitives to the bitmap
-	win->m_primlist->acquire_lock();
-	software_renderer<uint32_t, 0,0,0, 16,8,0>::draw_primitives(*win->m_primlist, m_bmdata.get(), width, height, pitch);
-	win->m_primlist->release_lock();
+	// draw the primitives to the bitmap, redrawing only what changed if it still holds the previous list
+	render_primitive_list &primlist = *win->m_primlist;
+	primlist.acquire_lock();
+	bool const valid = (m_last_sequence != 0) && (width == m_last_width) && (height == m_last_height);
+	if (!valid || ((primlist.previous_sequence() != m_last_sequence) && (primlist.sequence() != m_last_sequence)))
+		software_renderer<uint32_t, 0,0,0, 16,8,0>::draw_primitives(primlist, m_bmdata.get(), width, height, pitch, m_work_queue, m_render_bands);
+	else if (primlist.sequence() != m_last_sequence)
+		software_renderer<uint32_t, 0,0,0, 16,8,0>::draw_dirty_primitives(primlist, m_bmdata.get(), width, height, pitch, m_work_queue, m_render_bands);
+	m_last_sequence = primlist.sequence();
+	m_last_width = width;
+	m_last_height = height;
+	primlist.release_lock();
 
 	// fill in bitmap-specific info
 	m_bminfo.bmiHeader.biWidth = pitch;
@@ -32,6 +32,11 @@ public:
 		: osd_renderer(window, FLAG_NONE)
 		, m_bmdata(nullptr)
 		, m_bmsize(0)
+		, m_work_queue(nullptr)
+		, m_render_bands(1)
+		, m_last_sequence(0)
+		, m_last_width(0)
+		, m_last_height(0)
 	{
 	}
 	virtual ~renderer_gdi();
@@ -50,6 +55,11 @@ private:
 	BITMAPINFO                  m_bminfo;
 	std::unique_ptr<uint8_t []> m_bmdata;
 	size_t                      m_bmsize;
+	osd_work_queue *            m_work_queue;
+	int                         m_render_bands;
+	uint64_t                    m_last_sequence;
+	int                         m_last_width;
+	int                         m_last_height;
 };
 
 #endif // MAME_OSD_MODULES_RENDER_DRAWGDI_H
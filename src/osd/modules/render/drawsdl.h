@@ -34,6 +34,8 @@ public:
 		, m_last_vofs(0)
 		, m_blit_dim(0, 0)
 		, m_last_dim(0, 0)
+		, m_work_queue(nullptr)
+		, m_render_bands(1)
 	{
 	}
 	virtual ~renderer_sdl1();
@@ -71,6 +73,10 @@ private:
 	int                 m_last_vofs;
 	osd_dim             m_blit_dim;
 	osd_dim             m_last_dim;
+
+	// banded software rendering
+	osd_work_queue *    m_work_queue;
+	int                 m_render_bands;
 };
 
 struct sdl_scale_mode
@@ -10,12 +10,14 @@
 static DWORD WINAPI AuditThreadProc(LPVOID hDlg);
 static int MameUIVerifySampleSet(int game);
 static int MameUIVerifyRomSetFull(int game);
-static void ProcessNextRom(void);
+static int ReportRomSet(int game, const media_auditor &auditor, media_auditor::summary summary, bool refresh);
+static void ProcessRomResult(int retval);
 static void DetailsPrintf(const char *fmt, ...);
 static const char * StatusString(int iStatus);
 static bool RomSetFound(int index);
 static void RetrievePaths(void);
 static const char * RetrieveCHDName(int romset);
+static audit_cache * GetAuditCache(void);
 
 /***************************************************************************
     Internal variables
@@ -36,6 +38,7 @@ static HBRUSH hBrush = NULL;
 static HDC hDC = NULL;
 static HANDLE hThread = NULL;
 static HFONT hFont = NULL;
+static std::unique_ptr<audit_cache> cache;
 
 /***************************************************************************
     External functions
@@ -81,7 +84,16 @@ int MameUIVerifyRomSet(int game, bool refresh)
 	driver_enumerator enumerator(MameUIGlobal(), driver_list::driver(game));
 	enumerator.next();
 	media_auditor auditor(enumerator);
+	audit_cache *const auditcache = GetAuditCache();
+	if (auditcache)
+		auditcache->invalidate();
+	auditor.set_cache(auditcache);
 	media_auditor::summary summary = auditor.audit_media(AUDIT_VALIDATE_FAST);
+	return ReportRomSet(game, auditor, summary, refresh);
+}
+
+static int ReportRomSet(int game, const media_auditor &auditor, media_auditor::summary summary, bool refresh)
+{
 	util::ovectorstream buffer;
 	buffer.clear();
 	buffer.seekp(0);
@@ -133,9 +145,36 @@ int MameUIVerifySampleSet(int game)
 
 static DWORD WINAPI AuditThreadProc(LPVOID hDlg)
 {
-	while (rom_index != -1)
+	// sets that obviously aren't present are reported straight away, the rest are audited in parallel
+	std::vector<std::size_t> drivers;
+
+	for (int game = 0; game < driver_list::total() && rom_index != -1; game++)
 	{
-		ProcessNextRom();
+		if (driver_list::driver(game).name[0] == '_') // skip __empty driver
+			rom_index++;
+		else if (!RomSetFound(game))
+		{
+			SetRomAuditResults(game, media_auditor::NOTFOUND);
+			ProcessRomResult(media_auditor::NOTFOUND);
+		}
+		else
+			drivers.push_back(game);
+	}
+
+	if (rom_index != -1)
+	{
+		parallel_media_auditor auditor(MameUIGlobal(), GetAuditCache());
+		auditor.audit_media(
+				drivers,
+				[] (std::size_t game, const media_auditor &result, media_auditor::summary summary)
+				{
+					if (rom_index == -1)
+						return false;
+
+					ProcessRomResult(ReportRomSet(game, result, summary, false));
+					return rom_index != -1;
+				},
+				AUDIT_VALIDATE_FAST);
 	}
 
 	ExitThread(1);
@@ -374,18 +413,10 @@ intptr_t CALLBACK GameAuditDialogProc(HWND hDlg, UINT uMsg, WPARAM wParam, LPARA
 	return false;
 }
 
-static void ProcessNextRom(void)
+static void ProcessRomResult(int retval)
 {
 	char buffer[200];
 
-	if (driver_list::driver(rom_index).name[0] == '_') // skip __empty driver
-	{
-		rom_index++;
-		return;
-	}
-
-	int retval = MameUIVerifyRomSet(rom_index, false);
-
 	switch (retval)
 	{
 		case media_auditor::BEST_AVAILABLE: /* correct, incorrect or separate count? */
@@ -420,6 +451,9 @@ static void ProcessNextRom(void)
 		DetailsPrintf("Audit completed.\n");
 		winui_set_window_text_utf8(GetDlgItem(hAudit, IDCANCEL), "Close");
 		rom_index = -1;
+
+		if (cache)
+			cache->save();
 	}
 }
 
@@ -641,3 +675,13 @@ static const char * RetrieveCHDName(int romset)
 
 	return name;
 }
+
+static audit_cache * GetAuditCache(void)
+{
+	// results are kept for the whole session and written out after each full audit;
+	// locations are re-checked for changes at the start of each audit
+	if (!cache && MameUIGlobal().audit_cache())
+		cache = std::make_unique<audit_cache>(MameUIGlobal());
+
+	return cache.get();
+}
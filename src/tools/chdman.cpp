@@ -54,6 +54,9 @@ const uint32_t IDE_SECTOR_SIZE = 512;
 // temporary input buffer size
 const uint32_t TEMP_BUFFER_SIZE = 32 * 1024 * 1024;
 
+// number of hunks to decompress in parallel ahead of sequential reads
+const uint32_t READ_AHEAD_HUNKS = 64;
+
 // modes
 const int MODE_NORMAL = 0;
 const int MODE_CUEBIN = 1;
@@ -615,7 +618,7 @@ static const option_description s_options[] =
 	{ OPTION_INPUT_LENGTH_FRAMES,   "if",   true, " <length>: effective length of input in frames" },
 	{ OPTION_HUNK_SIZE,             "hs",   true, " <bytes>: size of each hunk, in bytes" },
 	{ OPTION_UNIT_SIZE,             "us",   true, " <bytes>: size of each unit, in bytes" },
-	{ OPTION_COMPRESSION,           "c",    true, " <none|type1[,type2[,...]]>: which compression codecs to use (up to 4)" },
+	{ OPTION_COMPRESSION,           "c",    true, " <none|type1[,type2[,...]]>: which compression codecs to use (up to 4; zstd/cdzs decode fastest)" },
 	{ OPTION_IDENT,                 "id",   true, " <filename>: name of ident file to provide CHS information" },
 	{ OPTION_CHS,                   "chs",  true, " <cylinders,heads,sectors>: specifies CHS values directly" },
 	{ OPTION_SECTOR_SIZE,           "ss",   true, " <bytes>: size of each hard disk sector" },
@@ -1064,6 +1067,22 @@ static void parse_input_chd_parameters(const parameters_map &params, chd_file &i
 }
 
 
+//-------------------------------------------------
+//  configure_read_ahead - decompress hunks of the
+//  input CHDs in parallel ahead of a sequential
+//  read; data is still delivered in order
+//-------------------------------------------------
+
+static void configure_read_ahead(chd_file &input_chd, chd_file &input_parent_chd)
+{
+	for (chd_file *chd : { &input_chd, &input_parent_chd })
+	{
+		chd->set_cache_hunks(READ_AHEAD_HUNKS + 2);
+		chd->set_read_ahead_hunks(READ_AHEAD_HUNKS);
+	}
+}
+
+
 //-------------------------------------------------
 //  parse_input_start_end - parse input start/end
 //  parameters in a standard way
@@ -1604,6 +1623,9 @@ static void do_verify(parameters_map &params)
 	if (raw_sha1 == util::sha1_t::null)
 		report_error(0, "No verification to be done; CHD has no checksum");
 
+	// decode on all cores; hashing stays in order on this thread
+	configure_read_ahead(input_chd, input_parent_chd);
+
 	// create an array to read into
 	std::vector<uint8_t> buffer((TEMP_BUFFER_SIZE / input_chd.hunk_bytes()) * input_chd.hunk_bytes());
 
@@ -2362,7 +2384,8 @@ static void do_extract_raw(parameters_map &params)
 		if (filerr)
 			report_error(1, "Unable to open file (%s): %s", *output_file_str->second, filerr.message());
 
-		// copy all data
+		// copy all data, decoding on all cores
+		configure_read_ahead(input_chd, input_parent_chd);
 		std::vector<uint8_t> buffer((TEMP_BUFFER_SIZE / input_chd.hunk_bytes()) * input_chd.hunk_bytes());
 		for (uint64_t offset = input_start; offset < input_end; )
 		{
@@ -2412,6 +2435,7 @@ static void do_extract_cd(parameters_map &params)
 	chd_file input_parent_chd;
 	chd_file input_chd;
 	parse_input_chd_parameters(params, input_chd, input_parent_chd);
+	configure_read_ahead(input_chd, input_parent_chd);
 
 	// further process input file
 	cdrom_file *cdrom = new cdrom_file(&input_chd);
@@ -2633,6 +2657,44 @@ static void do_extract_cd(parameters_map &params)
 }
 
 
+//-------------------------------------------------
+//  unpack_av_frame - unpack a raw A/V hunk, as
+//  produced by the A/V codec when it has no
+//  output configuration, into a bitmap and
+//  native-endian audio buffers
+//-------------------------------------------------
+
+static bool unpack_av_frame(const uint8_t *source, bitmap_yuy16 &video, std::vector<int16_t> *audio, uint32_t maxsamples, uint32_t &actsamples)
+{
+	// validate the header
+	if (source[0] != 'c' || source[1] != 'h' || source[2] != 'a' || source[3] != 'v')
+		return false;
+	uint32_t metasize = source[4];
+	uint32_t channels = source[5];
+	uint32_t samples = (source[6] << 8) + source[7];
+	uint32_t width = (source[8] << 8) + source[9];
+	uint32_t height = (source[10] << 8) + source[11];
+	if (channels > 16 || samples > maxsamples || width > video.width() || height > video.height())
+		return false;
+	source += 12 + metasize;
+
+	// audio is stored as big-endian planes
+	for (int chnum = 0; chnum < channels; chnum++)
+		for (int sampnum = 0; sampnum < samples; sampnum++, source += 2)
+			audio[chnum][sampnum] = int16_t((source[0] << 8) | source[1]);
+	actsamples = samples;
+
+	// video is big-endian YUY2
+	for (int y = 0; y < height; y++)
+	{
+		uint16_t *dest = &video.pix(y);
+		for (int x = 0; x < width; x++, source += 2)
+			dest[x] = (source[0] << 8) | source[1];
+	}
+	return true;
+}
+
+
 //-------------------------------------------------
 //  do_extract_ld - extract an AVI file from a
 //  CHD image
@@ -2720,19 +2782,14 @@ static void do_extract_ld(parameters_map &params)
 		if (avierr != avi_file::error::NONE)
 			report_error(1, "Unable to open file (%s)", *output_file_str->second);
 
-		// create the codec configuration
-		avhuff_decoder::config avconfig;
+		// frames are decoded to raw A/V data on all cores and unpacked here in order
+		configure_read_ahead(input_chd, input_parent_chd);
+		std::vector<uint8_t> rawframe(input_chd.hunk_bytes());
 		bitmap_yuy16 avvideo;
 		std::vector<int16_t> audio_data[16];
 		uint32_t actsamples;
-		avconfig.video = &avvideo;
-		avconfig.maxsamples = max_samples_per_frame;
-		avconfig.actsamples = &actsamples;
-		for (int chnum = 0; chnum < std::size(audio_data); chnum++)
-		{
-			audio_data[chnum].resize(std::max(1U,max_samples_per_frame));
-			avconfig.audio[chnum] = &audio_data[chnum][0];
-		}
+		for (auto &chdata : audio_data)
+			chdata.resize(std::max(1U,max_samples_per_frame));
 
 		// iterate over frames
 		bitmap_yuy16 fullbitmap(width, height * interlace_factor);
@@ -2742,21 +2799,22 @@ static void do_extract_ld(parameters_map &params)
 
 			// set up the fake bitmap for this frame
 			avvideo.wrap(&fullbitmap.pix(framenum % interlace_factor), fullbitmap.width(), fullbitmap.height() / interlace_factor, fullbitmap.rowpixels() * interlace_factor);
-			input_chd.codec_configure(CHD_CODEC_AVHUFF, AVHUFF_CODEC_DECOMPRESS_CONFIG, &avconfig);
 
-			// read the hunk into the buffers
-			std::error_condition err = input_chd.read_hunk(framenum, nullptr);
+			// read the hunk and unpack it into the buffers
+			std::error_condition err = input_chd.read_bytes(framenum * input_chd.hunk_bytes(), &rawframe[0], input_chd.hunk_bytes());
 			if (err)
 			{
 				uint64_t filepos = ~uint64_t(0);
 				input_chd.file().tell(filepos);
 				report_error(1, "Error reading hunk %d at offset %d from CHD file (%s): %s\n", framenum, filepos, *params.find(OPTION_INPUT)->second, err.message());
 			}
+			if (!unpack_av_frame(&rawframe[0], avvideo, audio_data, max_samples_per_frame, actsamples))
+				report_error(1, "Invalid A/V data in hunk %d of CHD file (%s)\n", framenum, *params.find(OPTION_INPUT)->second);
 
 			// write audio
 			for (int chnum = 0; chnum < channels; chnum++)
 			{
-				avi_file::error avierr = output_file->append_sound_samples(chnum, avconfig.audio[chnum], actsamples, 0);
+				avi_file::error avierr = output_file->append_sound_samples(chnum, &audio_data[chnum][0], actsamples, 0);
 				if (avierr != avi_file::error::NONE)
 					report_error(1, "Error writing samples for hunk %d to file (%s): %s\n", framenum, *output_file_str->second, avi_file::error_string(avierr));
 			}
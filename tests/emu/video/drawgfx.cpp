@@ -0,0 +1,230 @@
+#include "catch.hpp"
+
+#include "emu.h"
+#include "drawgfxt.ipp"
+
+#include <vector>
+
+
+//-------------------------------------------------
+//  row buffers - one set is drawn with the scalar
+//  loops and one with the vector kernels
+//-------------------------------------------------
+
+#undef rand
+inline u32 random_u32() { return rand() ^ (rand() << 15); }
+
+namespace {
+
+struct row_buffers
+{
+	row_buffers(int count)
+		: ind16(count)
+		, rgb32(count)
+	{
+		for (u16 &pix : ind16)
+			pix = random_u32();
+		for (u32 &pix : rgb32)
+			pix = random_u32() ^ (random_u32() << 16);
+	}
+
+	bool operator==(row_buffers const &that) const { return (ind16 == that.ind16) && (rgb32 == that.rgb32); }
+
+	std::vector<u16> ind16;
+	std::vector<u32> rgb32;
+};
+
+} // anonymous namespace
+
+
+TEST_CASE("drawgfx row kernels match scalar pixel ops", "[emu][video]")
+{
+	std::vector<pen_t> pens(0x100);
+	for (pen_t &pen : pens)
+		pen = random_u32() ^ (random_u32() << 16);
+
+	// odd lengths and offsets exercise the scalar tails and unaligned
+	// accesses, and offsets 0 and 3 give aligned loads forwards and flipped;
+	// runs of transparent and opaque pens exercise the skip and store paths
+	// as well as the blends
+	int const count = 141;
+	std::vector<u8> source(count + 3);
+	for (int x = 0; x < source.size(); x++)
+		source[x] = ((x / 16) % 3 == 0) ? 0x0f : ((x / 16) % 3 == 1) ? (0x10 | (random_u32() & 0x0f)) : (random_u32() & 0x1f);
+
+	for (u32 trans_pen : { 0x0f, 0x13, 0x00, 0xff })
+	{
+		for (int offset = 0; offset < 4; offset++)
+		{
+			for (bool flipx : { false, true })
+			{
+				// flipped rows are read backwards from the last pixel
+				u8 const *const src = flipx ? &source[offset + count - 1] : &source[offset];
+				row_buffers const initial(count);
+				row_buffers reference(initial), vectorized(initial);
+
+				drawgfx_scanline<false>::opaque_ind16(&reference.ind16[0], src, count, flipx, 0x1230);
+				drawgfx_scanline<true>::opaque_ind16(&vectorized.ind16[0], src, count, flipx, 0x1230);
+				REQUIRE(reference == vectorized);
+
+				drawgfx_scanline<false>::transpen_ind16(&reference.ind16[0], src, count, flipx, 0xfff0, trans_pen);
+				drawgfx_scanline<true>::transpen_ind16(&vectorized.ind16[0], src, count, flipx, 0xfff0, trans_pen);
+				drawgfx_scanline<false>::transpen_rgb32(&reference.rgb32[0], src, count, flipx, &pens[0], trans_pen);
+				drawgfx_scanline<true>::transpen_rgb32(&vectorized.rgb32[0], src, count, flipx, &pens[0], trans_pen);
+				REQUIRE(reference == vectorized);
+
+				// and both match the pixel op the basic core applies
+				u32 const color = 0x0400;
+				row_buffers kernel(initial), pixels(initial);
+				drawgfx_scanline<>::transpen_ind16(&kernel.ind16[0], src, count, flipx, color, trans_pen);
+				drawgfx_scanline<>::pixels(&pixels.ind16[0], src, count, flipx, [color, trans_pen] (u16 &destp, const u8 &srcp) { PIXEL_OP_REBASE_TRANSPEN(destp, srcp); });
+				REQUIRE(kernel == pixels);
+			}
+		}
+	}
+}
+
+
+TEST_CASE("drawgfx rows skip and fill rows by pen usage", "[emu][video]")
+{
+	int const width = 16, height = 12, modulo = 32;
+	u32 const trans_pen = 3;
+
+	// empty, solid and mixed rows
+	std::vector<u8> source(height * width);
+	std::vector<u32> rowusage(height);
+	for (int y = 0; y < height; y++)
+	{
+		for (int x = 0; x < width; x++)
+		{
+			u8 const pen = (y % 3 == 0) ? trans_pen : (y % 3 == 1) ? (4 + (random_u32() % 12)) : (random_u32() & 0x0f);
+			source[y * width + x] = pen;
+			rowusage[y] |= 1 << pen;
+		}
+	}
+
+	for (bool flipy : { false, true })
+	{
+		std::vector<u16> initial(height * modulo);
+		for (u16 &pix : initial)
+			pix = random_u32();
+		std::vector<u16> classified(initial), unclassified(initial);
+
+		u8 const *const src = flipy ? &source[(height - 1) * width] : &source[0];
+		u32 const *const usage = flipy ? &rowusage[height - 1] : &rowusage[0];
+		s32 const srcmodulo = flipy ? -width : width;
+		auto const opaque_row = [] (u16 *destp, const u8 *srcp, s32 count, bool flip) { drawgfx_scanline<>::opaque_ind16(destp, srcp, count, flip, 0x100); };
+		auto const row_op = [trans_pen] (u16 *destp, const u8 *srcp, s32 count, bool flip) { drawgfx_scanline<>::transpen_ind16(destp, srcp, count, flip, 0x100, trans_pen); };
+		drawgfx_scanline<>::rows(&classified[0], modulo, src, srcmodulo, usage, flipy ? -1 : 1, width, height, false, 1 << trans_pen, opaque_row, row_op);
+		drawgfx_scanline<>::rows(&unclassified[0], modulo, src, srcmodulo, nullptr, 0, width, height, false, 1 << trans_pen, opaque_row, row_op);
+		REQUIRE(classified == unclassified);
+	}
+}
+
+
+//-------------------------------------------------
+//  record_commands - fill a command list with
+//  overlapping draws of every kind that works on
+//  16bpp bitmaps, some partly off the edges
+//-------------------------------------------------
+
+namespace {
+
+void record_commands(gfx_command_list &list, gfx_element &gfx, u32 seed)
+{
+	srand(seed);
+	for (int index = 0; index < 300; index++)
+	{
+		u32 const code = random_u32() % gfx.elements();
+		u32 const color = random_u32() % gfx.colors();
+		int const flipx = random_u32() & 1, flipy = random_u32() & 1;
+		s32 const x = s32(random_u32() % 360) - 24, y = s32(random_u32() % 280) - 24;
+		u32 const scalex = 0x4000 + (random_u32() % 0x30000), scaley = 0x4000 + (random_u32() % 0x30000);
+		u32 const pmask = random_u32() & 0xff;
+		u32 const trans = random_u32() & 0x0f;
+		switch (random_u32() % 10)
+		{
+		case 0: list.opaque(gfx, code, color, flipx, flipy, x, y); break;
+		case 1: list.transpen(gfx, code, color, flipx, flipy, x, y, trans); break;
+		case 2: list.transmask(gfx, code, color, flipx, flipy, x, y, 1 << trans); break;
+		case 3: list.zoom_opaque(gfx, code, color, flipx, flipy, x, y, scalex, scaley); break;
+		case 4: list.zoom_transpen(gfx, code, color, flipx, flipy, x, y, scalex, scaley, trans); break;
+		case 5: list.prio_opaque(gfx, code, color, flipx, flipy, x, y, pmask); break;
+		case 6: list.prio_transpen(gfx, code, color, flipx, flipy, x, y, pmask, trans); break;
+		case 7: list.prio_transpen_raw(gfx, code, color << 4, flipx, flipy, x, y, pmask, trans); break;
+		case 8: list.prio_zoom_opaque(gfx, code, color, flipx, flipy, x, y, scalex, scaley, pmask); break;
+		case 9: list.prio_zoom_transpen(gfx, code, color, flipx, flipy, x, y, scalex, scaley, pmask, trans); break;
+		}
+	}
+}
+
+template <typename BitmapType>
+void copy_pixels(BitmapType &dest, BitmapType const &src)
+{
+	for (int y = 0; y < src.height(); y++)
+		std::copy_n(&src.pix(y), src.width(), &dest.pix(y));
+}
+
+template <typename BitmapType>
+bool same_pixels(BitmapType const &a, BitmapType const &b)
+{
+	for (int y = 0; y < a.height(); y++)
+		if (!std::equal(&a.pix(y), &a.pix(y) + a.width(), &b.pix(y)))
+			return false;
+	return true;
+}
+
+} // anonymous namespace
+
+
+TEST_CASE("gfx_command_list draws the same in any number of bands", "[emu][video]")
+{
+	// 16x16 tiles with runs of each pen, so transparency cuts through them
+	gfx_layout const layout = { 16, 16, 24, 8, { GFX_RAW }, { 0 }, { 16 * 8 }, 16 * 16 * 8 };
+	std::vector<u8> tiles(24 * 16 * 16);
+	for (size_t offs = 0; offs < tiles.size(); offs += 3)
+		std::fill_n(&tiles[offs], std::min<size_t>(3, tiles.size() - offs), random_u32() & 0x0f);
+	gfx_element gfx(nullptr, layout, &tiles[0], 0, 8, 0);
+
+	int const width = 320, height = 240;
+	bitmap_ind16 initial(width, height);
+	bitmap_ind8 initialpri(width, height);
+	for (int y = 0; y < height; y++)
+	{
+		for (int x = 0; x < width; x++)
+		{
+			initial.pix(y, x) = random_u32();
+			initialpri.pix(y, x) = 1 << (random_u32() & 7);
+		}
+	}
+
+	// the whole bitmap, and a cliprect that doesn't divide evenly
+	rectangle const cliprects[] = { initial.cliprect(), rectangle(5, 301, 3, 229) };
+	for (rectangle const &cliprect : cliprects)
+	{
+		gfx_command_list single(1);
+		record_commands(single, gfx, 1234);
+		bitmap_ind16 reference(width, height);
+		bitmap_ind8 referencepri(width, height);
+		copy_pixels(reference, initial);
+		copy_pixels(referencepri, initialpri);
+		single.execute(reference, cliprect, referencepri);
+
+		for (int bands : { 2, 7, 64 })
+		{
+			gfx_command_list banded(bands);
+			record_commands(banded, gfx, 1234);
+			REQUIRE(banded.size() == single.size());
+
+			bitmap_ind16 actual(width, height);
+			bitmap_ind8 actualpri(width, height);
+			copy_pixels(actual, initial);
+			copy_pixels(actualpri, initialpri);
+			banded.execute(actual, cliprect, actualpri);
+
+			INFO("bands " << bands << ", cliprect " << cliprect.left() << "," << cliprect.top() << " - " << cliprect.right() << "," << cliprect.bottom());
+			REQUIRE(same_pixels(reference, actual));
+			REQUIRE(same_pixels(referencepri, actualpri));
+		}
+	}
+}
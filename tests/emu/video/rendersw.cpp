@@ -0,0 +1,170 @@
+#include "catch.hpp"
+
+#include "emu.h"
+#include "rendersw.hxx"
+
+#include <vector>
+
+
+//-------------------------------------------------
+//  renderers under test - the scalar per-pixel
+//  loops are the reference for the span kernels
+//-------------------------------------------------
+
+template <bool BilinearFilter, bool Vectorize>
+using test_renderer = software_renderer<u32, 0,0,0, 16,8,0, false, BilinearFilter, Vectorize>;
+
+#undef rand
+inline u32 random_u32() { return rand() ^ (rand() << 15); }
+
+
+//-------------------------------------------------
+//  render_both - draw a list of primitives with
+//  and without the span kernels and check that
+//  the results are identical
+//-------------------------------------------------
+
+template <bool BilinearFilter>
+void render_both(std::vector<render_primitive> const &prims, u32 width, u32 height)
+{
+	u32 const pitch = width + 5;
+	std::vector<u32> background(pitch * height);
+	for (u32 &pix : background)
+		pix = random_u32() ^ (random_u32() << 16);
+
+	std::vector<u32> reference(background), vectorized(background);
+	for (render_primitive const &prim : prims)
+	{
+		test_renderer<BilinearFilter, false>::draw_primitive(prim, &reference[0], width, height, pitch);
+		test_renderer<BilinearFilter, true>::draw_primitive(prim, &vectorized[0], width, height, pitch);
+	}
+	REQUIRE(reference == vectorized);
+}
+
+
+TEST_CASE("software renderer span kernels match scalar rasterizers", "[emu][video]")
+{
+	u32 const texwidth = 37, texheight = 23;
+	std::vector<u32> argb(texwidth * texheight);
+	for (u32 &pix : argb)
+		pix = random_u32() ^ (random_u32() << 16);
+	for (u32 x = 0; x < texwidth; x += 3)
+		argb[x] &= 0x00ffffff; // make sure fully transparent texels are covered
+
+	std::vector<rgb_t> palette(256);
+	for (rgb_t &entry : palette)
+		entry = rgb_t(random_u32() ^ (random_u32() << 16));
+	std::vector<u16> indexed(texwidth * texheight);
+	for (u16 &pix : indexed)
+		pix = random_u32() & 0xff;
+
+	u32 const combos[] =
+	{
+		PRIMFLAG_TEXFORMAT(TEXFORMAT_RGB32) | PRIMFLAG_BLENDMODE(BLENDMODE_NONE),
+		PRIMFLAG_TEXFORMAT(TEXFORMAT_RGB32) | PRIMFLAG_BLENDMODE(BLENDMODE_ADD),
+		PRIMFLAG_TEXFORMAT(TEXFORMAT_ARGB32) | PRIMFLAG_BLENDMODE(BLENDMODE_ALPHA),
+		PRIMFLAG_TEXFORMAT(TEXFORMAT_ARGB32) | PRIMFLAG_BLENDMODE(BLENDMODE_ADD),
+		PRIMFLAG_TEXFORMAT(TEXFORMAT_PALETTE16) | PRIMFLAG_BLENDMODE(BLENDMODE_NONE)
+	};
+
+	// unscaled, partially off the edge, scaled up and scaled down
+	render_bounds const placements[] =
+	{
+		{ 3.0f, 2.0f, 3.0f + texwidth, 2.0f + texheight },
+		{ -5.0f, -4.0f, -5.0f + texwidth, -4.0f + texheight },
+		{ 1.0f, 1.0f, 119.0f, 61.0f },
+		{ 10.0f, 7.0f, 25.0f, 16.0f }
+	};
+
+	for (u32 flags : combos)
+	{
+		bool const palettized = PRIMFLAG_GET_TEXFORMAT(flags) == TEXFORMAT_PALETTE16;
+		std::vector<render_primitive> prims;
+		for (render_bounds const &bounds : placements)
+		{
+			for (bool wrap : { false, true })
+			{
+				render_primitive prim;
+				prim.type = render_primitive::QUAD;
+				prim.bounds = bounds;
+				prim.color = { 1.0f, 1.0f, 1.0f, 1.0f };
+				prim.flags = flags | PRIMFLAG_TEXWRAP(wrap ? 1 : 0);
+				prim.texture.base = palettized ? static_cast<void *>(&indexed[0]) : static_cast<void *>(&argb[0]);
+				prim.texture.rowpixels = texwidth;
+				prim.texture.width = texwidth;
+				prim.texture.height = texheight;
+				prim.texture.palette = palettized ? &palette[0] : nullptr;
+				prim.texcoords.tl = { 0.0f, 0.0f };
+				prim.texcoords.tr = { 1.0f, 0.0f };
+				prim.texcoords.bl = { 0.0f, 1.0f };
+				prim.texcoords.br = { 1.0f, 1.0f };
+				prims.emplace_back(prim);
+			}
+		}
+
+		render_both<false>(prims, 128, 72);
+		render_both<true>(prims, 128, 72);
+	}
+}
+
+
+//-------------------------------------------------
+//  check_kernel - run a span kernel over every
+//  length up to a few chunks of vectors, from
+//  starts that aren't vector aligned, and compare
+//  against the scalar loop
+//-------------------------------------------------
+
+using span_kernel = void (*)(u32 *, u32 const *, s32, bool);
+
+void check_kernel(span_kernel reference, span_kernel vectorized, bool avx2)
+{
+	u32 const size = 64;
+	std::vector<u32> src(size + 8), background(size + 8);
+	for (u32 &pix : src)
+		pix = random_u32() ^ (random_u32() << 16);
+	for (u32 x = 0; x < src.size(); x += 5)
+		src[x] &= 0x00ffffff; // fully transparent texels leave the destination alone
+	for (u32 x = 2; x < src.size(); x += 7)
+		src[x] |= 0xff000000; // fully opaque texels replace it
+	for (u32 &pix : background)
+		pix = random_u32() ^ (random_u32() << 16);
+
+	for (u32 srcstart = 0; srcstart < 8; srcstart++)
+	{
+		for (u32 deststart = 0; deststart < 8; deststart += 3)
+		{
+			for (s32 count = 0; count <= s32(size); count++)
+			{
+				std::vector<u32> expected(background), actual(background);
+				reference(&expected[deststart], &src[srcstart], count, false);
+				vectorized(&actual[deststart], &src[srcstart], count, avx2);
+				INFO("source start " << srcstart << ", destination start " << deststart << ", count " << count << ", AVX2 " << avx2);
+				REQUIRE(expected == actual);
+			}
+		}
+	}
+}
+
+
+TEST_CASE("software renderer span kernels match scalar loops", "[emu][video]")
+{
+	using reference = test_renderer<false, false>;
+	using vectorized = test_renderer<false, true>;
+
+	// the AVX2 kernels can only be checked on a host that supports them
+	std::vector<bool> paths{ false };
+	if (host_has_avx2())
+		paths.push_back(true);
+
+	for (bool avx2 : paths)
+	{
+		SECTION(avx2 ? "AVX2" : "SSE2 or scalar")
+		{
+			check_kernel(&reference::copy_span, &vectorized::copy_span, avx2);
+			check_kernel(&reference::alpha_span, &vectorized::alpha_span, avx2);
+			check_kernel(&reference::add_span, &vectorized::add_span, avx2);
+			check_kernel(&reference::alpha_add_span, &vectorized::alpha_add_span, avx2);
+		}
+	}
+}
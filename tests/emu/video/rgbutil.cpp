@@ -1,6 +1,9 @@
 #include "catch.hpp"
 #include "emucore.h"
 #include "video/rgbutil.h"
+#include "video/rgbspan.h"
+
+#include <vector>
 
 
 //-------------------------------------------------
@@ -1034,3 +1037,208 @@ TEST_CASE("check rgb", "[emu][video]")
 		check_expected();
 	}
 }
+
+
+TEST_CASE("check rgb batches", "[emu][video]")
+{
+	/*
+	    Each batch operation should give the same result as applying
+	    the equivalent rgbaint_t operation to every pixel, whichever
+	    implementation is selected for each.
+	*/
+
+	constexpr int count = rgbaint_batch_t::PIXELS;
+	u32 src[count], other[count], rgb00[count], rgb01[count], rgb10[count], rgb11[count];
+	u8 factors[count], u[count], v[count];
+	for (int i = 0; i < count; i++)
+	{
+		src[i] = random_u32() ^ (random_u32() << 16);
+		other[i] = random_u32() ^ (random_u32() << 16);
+		rgb00[i] = random_u32() ^ (random_u32() << 16);
+		rgb01[i] = random_u32() ^ (random_u32() << 16);
+		rgb10[i] = random_u32() ^ (random_u32() << 16);
+		rgb11[i] = random_u32() ^ (random_u32() << 16);
+		factors[i] = random_u32();
+		u[i] = random_u32();
+		v[i] = random_u32();
+	}
+	factors[0] = 0;
+	factors[1] = 0xff;
+	u[0] = v[1] = 0;
+	u[1] = v[0] = 0xff;
+
+	rgbaint_batch_t batch(src);
+	rgbaint_batch_t const otherbatch(other);
+	auto check_expected = [&] (auto &&op)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			rgbaint_t expected(src[i]);
+			op(expected, rgbaint_t(other[i]), i);
+			rgbaint_t const actual = batch.get(i);
+			REQUIRE(actual.get_a32() == expected.get_a32());
+			REQUIRE(actual.get_r32() == expected.get_r32());
+			REQUIRE(actual.get_g32() == expected.get_g32());
+			REQUIRE(actual.get_b32() == expected.get_b32());
+		}
+	};
+
+	SECTION("rgbaint_batch_t::load/get/set/store")
+	{
+		check_expected([] (rgbaint_t &, rgbaint_t const &, int) { });
+		rgbaint_t const pixel(0x12345678);
+		batch.set(3, pixel);
+		batch.set(4, pixel);
+		u32 stored[count];
+		batch.store(stored);
+		for (int i = 0; i < count; i++)
+			REQUIRE(stored[i] == ((i == 3 || i == 4) ? 0x12345678 : src[i]));
+	}
+
+	SECTION("rgbaint_batch_t::store clamps")
+	{
+		batch.shl_imm(1);
+		batch.sub(otherbatch);
+		u32 stored[count];
+		batch.store(stored);
+		for (int i = 0; i < count; i++)
+		{
+			rgbaint_t expected(src[i]);
+			expected.shl_imm(1);
+			expected.sub(rgbaint_t(other[i]));
+			REQUIRE(stored[i] == u32(expected.to_rgba_clamp()));
+		}
+	}
+
+	SECTION("rgbaint_batch_t arithmetic")
+	{
+		batch.add(otherbatch);
+		batch.mul(otherbatch);
+		batch.mul_imm(3);
+		batch.sub(otherbatch);
+		batch.sra_imm(2);
+		check_expected([] (rgbaint_t &rgb, rgbaint_t const &o, int)
+		{
+			rgb.add(o);
+			rgb.mul(o);
+			rgb.mul_imm(3);
+			rgb.sub(o);
+			rgb.sra_imm(2);
+		});
+	}
+
+	SECTION("rgbaint_batch_t::clamp_to_uint8")
+	{
+		batch.shl_imm(2);
+		batch.sub(otherbatch);
+		batch.sub(otherbatch);
+		batch.clamp_to_uint8();
+		check_expected([] (rgbaint_t &rgb, rgbaint_t const &o, int)
+		{
+			rgb.shl_imm(2);
+			rgb.sub(o);
+			rgb.sub(o);
+			rgb.clamp_to_uint8();
+		});
+	}
+
+	SECTION("rgbaint_batch_t::blend")
+	{
+		batch.blend(otherbatch, 0x60);
+		check_expected([] (rgbaint_t &rgb, rgbaint_t const &o, int) { rgb.blend(o, 0x60); });
+	}
+
+	SECTION("rgbaint_batch_t::blend per pixel")
+	{
+		batch.blend(otherbatch, factors);
+		check_expected([&factors] (rgbaint_t &rgb, rgbaint_t const &o, int i) { rgb.blend(o, factors[i]); });
+	}
+
+	SECTION("rgbaint_batch_t::scale_and_clamp")
+	{
+		batch.scale_and_clamp(otherbatch);
+		check_expected([] (rgbaint_t &rgb, rgbaint_t const &o, int) { rgb.scale_and_clamp(o); });
+	}
+
+	SECTION("rgbaint_batch_t::bilinear_filter")
+	{
+		u32 filtered[count];
+		rgbaint_batch_t::bilinear_filter(filtered, rgb00, rgb01, rgb10, rgb11, u, v);
+		for (int i = 0; i < count; i++)
+			REQUIRE(filtered[i] == rgbaint_t::bilinear_filter(rgb00[i], rgb01[i], rgb10[i], rgb11[i], u[i], v[i]));
+
+		batch.bilinear_filter_rgbaint(rgb00, rgb01, rgb10, rgb11, u, v);
+		check_expected([&] (rgbaint_t &rgb, rgbaint_t const &, int i) { rgb.bilinear_filter_rgbaint(rgb00[i], rgb01[i], rgb10[i], rgb11[i], u[i], v[i]); });
+	}
+}
+
+
+TEST_CASE("check rgb spans", "[emu][video]")
+{
+	/*
+	    Each span function should give the same result as the rgbaint_t
+	    operations applied one pixel at a time.  The AVX2 functions are
+	    checked too when the host CPU supports them.  The span length
+	    isn't a multiple of the batch size, so the tail is covered.
+	*/
+
+	constexpr int count = 8 * 5 + 3;
+	std::vector<u32> src(count), dest(count), scale(count), rgb00(count), rgb01(count), rgb10(count), rgb11(count);
+	std::vector<u8> factors(count), u(count), v(count);
+	for (int i = 0; i < count; i++)
+	{
+		src[i] = random_u32() ^ (random_u32() << 16);
+		dest[i] = random_u32() ^ (random_u32() << 16);
+		scale[i] = random_u32() ^ (random_u32() << 16);
+		rgb00[i] = random_u32() ^ (random_u32() << 16);
+		rgb01[i] = random_u32() ^ (random_u32() << 16);
+		rgb10[i] = random_u32() ^ (random_u32() << 16);
+		rgb11[i] = random_u32() ^ (random_u32() << 16);
+		factors[i] = random_u32();
+		u[i] = random_u32();
+		v[i] = random_u32();
+	}
+
+	std::vector<rgb_span_functions const *> implementations{ &rgb_span_generic, &rgb_span() };
+	if (rgb_span_avx2())
+		implementations.push_back(rgb_span_avx2());
+
+	for (rgb_span_functions const *span : implementations)
+	{
+		std::vector<u32> actual;
+		auto check_expected = [&] (auto &&op)
+		{
+			for (int i = 0; i < count; i++)
+			{
+				rgbaint_t expected(src[i]);
+				op(expected, i);
+				REQUIRE(actual[i] == expected.to_rgba_clamp());
+			}
+		};
+
+		actual = dest;
+		span->bilinear_filter(&actual[0], &rgb00[0], &rgb01[0], &rgb10[0], &rgb11[0], &u[0], &v[0], count);
+		for (int i = 0; i < count; i++)
+			REQUIRE(actual[i] == rgbaint_t::bilinear_filter(rgb00[i], rgb01[i], rgb10[i], rgb11[i], u[i], v[i]));
+
+		actual = dest;
+		span->bilinear_blend(&actual[0], &rgb00[0], &rgb01[0], &rgb10[0], &rgb11[0], &u[0], &v[0], 0x60, count);
+		check_expected([&] (rgbaint_t &rgb, int i)
+		{
+			rgb.bilinear_filter_rgbaint(rgb00[i], rgb01[i], rgb10[i], rgb11[i], u[i], v[i]);
+			rgb.blend(rgbaint_t(dest[i]), 0x60);
+		});
+
+		actual = dest;
+		span->blend(&actual[0], &src[0], 0xa0, count);
+		check_expected([&] (rgbaint_t &rgb, int i) { rgb.blend(rgbaint_t(dest[i]), 0xa0); });
+
+		actual = dest;
+		span->blend_factors(&actual[0], &src[0], &factors[0], count);
+		check_expected([&] (rgbaint_t &rgb, int i) { rgb.blend(rgbaint_t(dest[i]), factors[i]); });
+
+		actual = dest;
+		span->scale_and_clamp(&actual[0], &src[0], &scale[0], count);
+		check_expected([&] (rgbaint_t &rgb, int i) { rgb.scale_and_clamp(rgbaint_t(scale[i])); });
+	}
+}